@@ -0,0 +1,39 @@
+require './lib/sfml/rbsfml.so'
+
+ITERATIONS = 200_000
+
+class EmptyDrawable
+  include SFML::Drawable
+
+  def draw(target, states)
+  end
+end
+
+class NestedDrawable
+  include SFML::Drawable
+
+  def initialize(child)
+    @child = child
+  end
+
+  def draw(target, states)
+    target.draw(@child, states)
+  end
+end
+
+def measure(name)
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  ITERATIONS.times { yield }
+  elapsed = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+  puts "%-24s %8.1f ns/draw" % [name, elapsed / ITERATIONS * 1_000_000_000.0]
+end
+
+target = SFML::RenderTexture.new(64, 64)
+empty = EmptyDrawable.new
+nested = NestedDrawable.new(empty)
+states = SFML::RenderStates.new
+
+puts "Ruby drawable callbacks, #{ITERATIONS} draws each"
+measure("draw") { target.draw(empty) }
+measure("draw with states") { target.draw(empty, states) }
+measure("nested draw") { target.draw(nested) }
@@ -0,0 +1,28 @@
+require './lib/sfml/rbsfml.so'
+
+WIDTH = 3840
+HEIGHT = 2160
+ITERATIONS = 20
+
+def measure(name)
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  ITERATIONS.times { yield }
+  elapsed = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+  pixels = WIDTH * HEIGHT * ITERATIONS
+  puts "%-24s %10.1f MPix/s" % [name, pixels / elapsed / 1_000_000.0]
+end
+
+image = SFML::Image.new(WIDTH, HEIGHT, SFML::Color.new(200, 100, 50, 128))
+source = SFML::Image.new(WIDTH, HEIGHT, SFML::Color.new(10, 20, 30, 200))
+key = SFML::Color.new(200, 100, 50, 128)
+full = SFML::Rect.new(0, 0, WIDTH, HEIGHT)
+
+puts "SFML::Image kernels (#{SFML::Image::SIMD}), #{WIDTH}x#{HEIGHT}"
+measure("premultiply_alpha") { image.premultiply_alpha }
+measure("unpremultiply_alpha") { image.unpremultiply_alpha }
+measure("create_mask_from_color") { image.create_mask_from_color(key, 128) }
+measure("tint") { image.tint(SFML::Color.new(255, 255, 255, 255)) }
+measure("grayscale") { image.grayscale }
+measure("swizzle") { image.swizzle("bgra") }
+measure("blit") { image.blit(source, 0, 0) }
+measure("fill_rect") { image.fill_rect(full, key) }
@@ -0,0 +1,47 @@
+require './lib/sfml/rbsfml.so'
+
+SOURCE_WIDTH = 3840
+SOURCE_HEIGHT = 2160
+ITERATIONS = 10
+TARGETS = [[1920, 1080], [480, 270], [128, 72]]
+
+def measure(name)
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  ITERATIONS.times { yield }
+  elapsed = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+  pixels = SOURCE_WIDTH * SOURCE_HEIGHT * ITERATIONS
+  puts "%-28s %8.2f ms %10.1f MPix/s" % [name, elapsed * 1000.0 / ITERATIONS, pixels / elapsed / 1_000_000.0]
+end
+
+image = SFML::Image.new(SOURCE_WIDTH, SOURCE_HEIGHT, SFML::Color.new(200, 100, 50, 255))
+image.fill_rect(SFML::Rect.new(0, 0, SOURCE_WIDTH / 2, SOURCE_HEIGHT / 2), SFML::Color.new(20, 40, 60, 128))
+
+puts "SFML::Image#resize (#{SFML::Image::SIMD}), from #{SOURCE_WIDTH}x#{SOURCE_HEIGHT}"
+TARGETS.each do |width, height|
+  [:box, :bilinear, :lanczos].each do |filter|
+    measure("#{width}x#{height} #{filter}") { image.resize(width, height, filter: filter) }
+  end
+end
+
+begin
+  texture = SFML::Texture.new
+  texture.load_from_image(image)
+  texture.smooth = true
+  sprite = SFML::Sprite.new
+  sprite.texture = texture
+
+  puts ""
+  puts "RenderTexture + copy_to_image"
+  TARGETS.each do |width, height|
+    target = SFML::RenderTexture.new(width, height)
+    sprite.scale = SFML::Vector2.new(width.to_f / SOURCE_WIDTH, height.to_f / SOURCE_HEIGHT)
+    measure("#{width}x#{height} smooth texture") do
+      target.clear
+      target.draw(sprite)
+      target.display
+      target.texture.copy_to_image
+    end
+  end
+rescue StandardError => error
+  puts "RenderTexture path unavailable: #{error.message}"
+end
@@ -0,0 +1,38 @@
+require './lib/sfml/rbsfml.so'
+
+ITERATIONS = 20
+
+def measure(name, object)
+  data = Marshal.dump(object)
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  ITERATIONS.times { Marshal.dump(object) }
+  dumped = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  ITERATIONS.times { Marshal.load(data) }
+  loaded = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+  puts "%-28s %10d bytes %9.3f ms dump %9.3f ms load" % [name, data.bytesize, dumped * 1000.0 / ITERATIONS, loaded * 1000.0 / ITERATIONS]
+end
+
+image = SFML::Image.new(1024, 1024, SFML::Color.new(30, 60, 90))
+1024.times { |i| image.set_pixel(i, i, SFML::Color.new(i % 256, 255, 0)) }
+
+vertices = SFML::VertexArray.new(SFML::Quads)
+10_000.times do |i|
+  vertices.append(SFML::Vertex.new(SFML::Vector2.new((i % 100) * 16.0, (i / 100) * 16.0), SFML::Color.new(255, 255, 255), SFML::Vector2.new((i % 8) * 16.0, 0.0)))
+end
+
+vectors = Array.new(10_000) { |i| SFML::Vector2.new(i, i * 0.5) }
+colors = Array.new(10_000) { |i| SFML::Color.new(i % 256, 0, 0) }
+transforms = Array.new(1_000) { |i| SFML::Transform.new.rotate(i.to_f) }
+
+puts "Marshal, #{ITERATIONS} iterations"
+[true, false].each do |compression|
+  SFML.marshal_compression = compression
+  suffix = compression ? "" : " (raw)"
+  measure("Image 1024x1024#{suffix}", image)
+  measure("VertexArray 10000#{suffix}", vertices)
+end
+SFML.marshal_compression = true
+measure("Vector2 x 10000", vectors)
+measure("Color x 10000", colors)
+measure("Transform x 1000", transforms)
@@ -0,0 +1,31 @@
+require './lib/sfml/rbsfml.so'
+
+ITERATIONS = 5_000_000
+
+def measure
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  index = 0
+  while index < ITERATIONS
+    yield
+    index += 1
+  end
+  Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+end
+
+def report(name, baseline, &block)
+  elapsed = measure(&block) - baseline
+  puts "%-24s %8.1f ns/call" % [name, elapsed / ITERATIONS * 1_000_000_000.0]
+end
+
+time = SFML.microseconds(16_000)
+step = SFML.microseconds(1)
+sprite = SFML::Sprite.new
+rect = SFML::Rect.new(0, 0, 100, 100)
+baseline = measure { }
+
+puts "Method dispatch overhead, #{ITERATIONS} calls each"
+report("const method", baseline) { time.as_microseconds }
+report("method with argument", baseline) { time.add!(step) }
+report("module method", baseline) { sprite.rotation }
+report("module setter", baseline) { sprite.rotation = 45.0 }
+report("variadic method", baseline) { rect.contains?(10, 10) }
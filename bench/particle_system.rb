@@ -0,0 +1,39 @@
+require './lib/sfml/rbsfml.so'
+
+COUNT = 50_000
+FRAMES = 60
+DELTA = 1.0 / 60.0
+
+def measure(name)
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  FRAMES.times { yield }
+  elapsed = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+  puts "%-24s %8.2f ms/frame" % [name, elapsed / FRAMES * 1000.0]
+end
+
+Particle = Struct.new(:x, :y, :vx, :vy)
+particles = Array.new(COUNT) { Particle.new(0.0, 0.0, rand * 100.0, rand * 100.0) }
+vertices = SFML::VertexArray.new(SFML::Points, COUNT)
+color = SFML::Color.new(255, 255, 255, 255)
+
+puts "#{COUNT} particles, #{FRAMES} frames"
+measure("ruby + VertexArray#[]=") do
+  particles.each_with_index do |particle, index|
+    particle.vy += 9.8 * DELTA
+    particle.x += particle.vx * DELTA
+    particle.y += particle.vy * DELTA
+    vertices[index] = SFML::Vertex.new(SFML::Vector2.new(particle.x, particle.y), color)
+  end
+end
+
+system = SFML::ParticleSystem.new(COUNT)
+system.primitive_type = SFML::Points
+system.gravity = SFML::Vector2.new(0.0, 9.8)
+system.emit(COUNT, velocity: SFML::Vector2.new(50.0, 50.0), angle_variance: 180.0, lifetime: 1000.0)
+measure("ParticleSystem (points)") { system.update(DELTA) }
+
+system.primitive_type = SFML::Quads
+measure("ParticleSystem (quads)") { system.update(DELTA) }
+
+system.parallel_threshold = COUNT + 1
+measure("ParticleSystem (1 thread)") { system.update(DELTA) }
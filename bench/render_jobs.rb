@@ -0,0 +1,31 @@
+require './lib/sfml/rbsfml.so'
+
+FRAMES = 100
+TARGETS = 4
+SHAPES = 2_000
+
+def measure(name)
+  start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  FRAMES.times { yield }
+  elapsed = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+  puts "%-24s %8.2f ms/frame" % [name, elapsed / FRAMES * 1000.0]
+end
+
+targets = Array.new(TARGETS) { SFML::RenderTexture.new(256, 256) }
+shapes = Array.new(SHAPES) do |i|
+  shape = SFML::CircleShape.new(4.0)
+  shape.position = SFML::Vector2.new((i * 7) % 256, (i * 13) % 256)
+  shape
+end
+
+puts "#{TARGETS} render textures with #{SHAPES} shapes each, #{SFML::RenderTexture.render_threads} render threads"
+measure("main thread") do
+  targets.each do |target|
+    target.clear
+    shapes.each { |shape| target.draw(shape) }
+    target.display
+  end
+end
+measure("render_async") do
+  targets.map { |target| target.render_async(shapes) }.each(&:wait)
+end
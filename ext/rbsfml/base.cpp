@@ -19,11 +19,17 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 #include "base.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace
 {
 	constexpr char symMore[] = ">";
 	constexpr char symLess[] = "<";
+
+	// Longest stretch spent asleep before checking for interrupts again.
+	const long long SleepSlice = 10000;
 }
 
 namespace rb
@@ -73,4 +79,23 @@ Value eval(const std::string& script)
     return rb::Value::create(rb_eval_string(script.c_str()));
 }
 
+void sleepWithoutGVL(long long microseconds)
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(microseconds);
+	for(;;)
+	{
+		long long remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now()).count();
+		if(remaining <= 0)
+			return;
+
+		std::chrono::microseconds slice(std::min(remaining, SleepSlice));
+		rb_thread_call_without_gvl([](void* data) -> void*
+		{
+			std::this_thread::sleep_for(*static_cast<std::chrono::microseconds*>(data));
+			return nullptr;
+		}, &slice, RUBY_UBF_IO, nullptr);
+		rb_thread_check_ints();
+	}
+}
+
 }
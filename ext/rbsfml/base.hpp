@@ -23,6 +23,8 @@
 #define RBSFML_BASE_HEADER_
 
 #include <ruby.h>
+#include <condition_variable>
+#include <mutex>
 #include "value.hpp"
 
 namespace rb
@@ -40,6 +42,35 @@ namespace rb
 	Value callSuper(const std::vector<Value>& args);
 
 	Value eval(const std::string& script);
+
+	// Runs function without the GVL. Only for work that finishes on its own;
+	// blocking waits use one of the interruptible variants below.
+	template<typename Function>
+	void callWithoutGVL(Function function);
+
+	// As above, but pending interrupts are left for the next check instead of
+	// being raised on return, so callers holding state that must be undone
+	// don't longjmp past it. Runs function with the GVL held when an interrupt
+	// is already pending.
+	template<typename Function>
+	void callWithoutGVLDeferringInterrupts(Function function);
+
+	// As callWithoutGVL, but unblock is called from another thread when Ruby interrupts
+	// this one (signals, Thread#kill, Thread#raise) and must make function
+	// return early. It must not touch the Ruby API.
+	template<typename Function, typename Unblock>
+	void callWithoutGVL(Function function, Unblock unblock);
+
+	// Sleeps without the GVL in short slices and handles pending interrupts
+	// between them, so long sleeps can be interrupted.
+	void sleepWithoutGVL(long long microseconds);
+
+	// Waits on condition without the GVL until predicate, evaluated under
+	// mutex, holds. Pending interrupts are raised while waiting.
+	template<typename Predicate>
+	void waitWithoutGVL(std::mutex& mutex, std::condition_variable& condition, Predicate predicate);
 }
 
+#include "base.inc"
+
 #endif // RBSFML_BASE_HEADER_
\ No newline at end of file
@@ -0,0 +1,212 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "binary.hpp"
+#include <cstring>
+
+namespace binary
+{
+
+Writer::Writer(std::string& buffer)
+: myBuffer(buffer)
+{
+}
+
+void Writer::writeUint8(sf::Uint8 value)
+{
+	myBuffer.push_back(static_cast<char>(value));
+}
+
+void Writer::writeUint16(sf::Uint16 value)
+{
+	writeUint8(static_cast<sf::Uint8>(value));
+	writeUint8(static_cast<sf::Uint8>(value >> 8));
+}
+
+void Writer::writeUint32(sf::Uint32 value)
+{
+	writeUint16(static_cast<sf::Uint16>(value));
+	writeUint16(static_cast<sf::Uint16>(value >> 16));
+}
+
+void Writer::writeInt32(sf::Int32 value)
+{
+	writeUint32(static_cast<sf::Uint32>(value));
+}
+
+void Writer::writeUint64(sf::Uint64 value)
+{
+	writeUint32(static_cast<sf::Uint32>(value));
+	writeUint32(static_cast<sf::Uint32>(value >> 32));
+}
+
+void Writer::writeInt64(sf::Int64 value)
+{
+	writeUint64(static_cast<sf::Uint64>(value));
+}
+
+void Writer::writeFloat(float value)
+{
+	sf::Uint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	writeUint32(bits);
+}
+
+void Writer::writeDouble(double value)
+{
+	sf::Uint64 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	writeUint64(bits);
+}
+
+void Writer::writeVarUint(sf::Uint64 value)
+{
+	while(value >= 0x80)
+	{
+		writeUint8(static_cast<sf::Uint8>(value | 0x80));
+		value >>= 7;
+	}
+	writeUint8(static_cast<sf::Uint8>(value));
+}
+
+// Zigzag encoded so small negative values stay short.
+void Writer::writeVarInt(sf::Int64 value)
+{
+	writeVarUint((static_cast<sf::Uint64>(value) << 1) ^ static_cast<sf::Uint64>(value >> 63));
+}
+
+void Writer::writeBytes(const void* data, std::size_t size)
+{
+	myBuffer.append(static_cast<const char*>(data), size);
+}
+
+Reader::Reader(const void* data, std::size_t size)
+: myPosition(static_cast<const unsigned char*>(data))
+, myEnd(static_cast<const unsigned char*>(data) + size)
+, myIsFailed(false)
+{
+}
+
+sf::Uint8 Reader::readUint8()
+{
+	if(myPosition == myEnd)
+	{
+		myIsFailed = true;
+		return 0;
+	}
+	return *myPosition++;
+}
+
+sf::Uint16 Reader::readUint16()
+{
+	sf::Uint16 low = readUint8();
+	sf::Uint16 high = readUint8();
+	return static_cast<sf::Uint16>(low | (high << 8));
+}
+
+sf::Uint32 Reader::readUint32()
+{
+	sf::Uint32 low = readUint16();
+	sf::Uint32 high = readUint16();
+	return low | (high << 16);
+}
+
+sf::Int32 Reader::readInt32()
+{
+	return static_cast<sf::Int32>(readUint32());
+}
+
+sf::Uint64 Reader::readUint64()
+{
+	sf::Uint64 low = readUint32();
+	sf::Uint64 high = readUint32();
+	return low | (high << 32);
+}
+
+sf::Int64 Reader::readInt64()
+{
+	return static_cast<sf::Int64>(readUint64());
+}
+
+float Reader::readFloat()
+{
+	sf::Uint32 bits = readUint32();
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+double Reader::readDouble()
+{
+	sf::Uint64 bits = readUint64();
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+sf::Uint64 Reader::readVarUint()
+{
+	sf::Uint64 value = 0;
+	for(unsigned int shift = 0; shift < 64; shift += 7)
+	{
+		sf::Uint8 byte = readUint8();
+		value |= static_cast<sf::Uint64>(byte & 0x7f) << shift;
+		if((byte & 0x80) == 0 || myIsFailed)
+			return value;
+	}
+	myIsFailed = true;
+	return 0;
+}
+
+sf::Int64 Reader::readVarInt()
+{
+	sf::Uint64 value = readVarUint();
+	return static_cast<sf::Int64>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+bool Reader::readBytes(void* data, std::size_t size)
+{
+	if(getRemaining() < size)
+	{
+		myIsFailed = true;
+		return false;
+	}
+	std::memcpy(data, myPosition, size);
+	myPosition += size;
+	return true;
+}
+
+bool Reader::isFailed() const
+{
+	return myIsFailed;
+}
+
+bool Reader::isAtEnd() const
+{
+	return myPosition == myEnd;
+}
+
+std::size_t Reader::getRemaining() const
+{
+	return static_cast<std::size_t>(myEnd - myPosition);
+}
+
+}
@@ -0,0 +1,83 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_BINARY_HEADER_
+#define RBSFML_BINARY_HEADER_
+
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <string>
+
+namespace binary
+{
+	// Appends values in little endian byte order, independent of the host.
+	class Writer
+	{
+	public:
+		explicit Writer(std::string& buffer);
+
+		void writeUint8(sf::Uint8 value);
+		void writeUint16(sf::Uint16 value);
+		void writeUint32(sf::Uint32 value);
+		void writeInt32(sf::Int32 value);
+		void writeUint64(sf::Uint64 value);
+		void writeInt64(sf::Int64 value);
+		void writeFloat(float value);
+		void writeDouble(double value);
+		void writeVarUint(sf::Uint64 value);
+		void writeVarInt(sf::Int64 value);
+		void writeBytes(const void* data, std::size_t size);
+
+	private:
+		std::string& myBuffer;
+	};
+
+	// Counterpart of Writer. Reads past the end fail and leave the reader in
+	// a failed state instead of throwing, so callers can check once at the end.
+	class Reader
+	{
+	public:
+		Reader(const void* data, std::size_t size);
+
+		sf::Uint8 readUint8();
+		sf::Uint16 readUint16();
+		sf::Uint32 readUint32();
+		sf::Int32 readInt32();
+		sf::Uint64 readUint64();
+		sf::Int64 readInt64();
+		float readFloat();
+		double readDouble();
+		sf::Uint64 readVarUint();
+		sf::Int64 readVarInt();
+		bool readBytes(void* data, std::size_t size);
+
+		bool isFailed() const;
+		bool isAtEnd() const;
+		std::size_t getRemaining() const;
+
+	private:
+		const unsigned char* myPosition;
+		const unsigned char* myEnd;
+		bool myIsFailed;
+	};
+}
+
+#endif // RBSFML_BINARY_HEADER_
@@ -25,22 +25,25 @@
 #include <ruby.h>
 #include <string>
 #include <array>
+#include <type_traits>
 
 #include "module.hpp"
 #include "object.hpp"
+#include "datatype.hpp"
 
 namespace rb
 {
     template<typename Allocator>
     void defineAllocator(const rb::Value& klass);
 
-	template<typename Base>
+	// Interface is the type the object is wrapped as, for classes that
+	// allocate a private subclass of what their methods work on.
+	template<typename Base, typename Interface = Base>
 	class DefaultAllocator
 	{
 	public:
 		static Base* allocate();
 		static VALUE allocate(VALUE klass);
-		static void free(void* memory);
 	};
 
 	class RubyObjAllocator
@@ -55,12 +58,12 @@ namespace rb
 	    static VALUE allocate(VALUE klass);
 	};
 
-	template<typename Base, int MaxFunctions = 32>
-	class Class : public Module<Base, MaxFunctions>
+	template<typename Base>
+	class Class : public Module<Base>
 	{
 	public:
-		static Module<Base, MaxFunctions> defineModule(const std::string& name) = delete;
-		static Module<Base, MaxFunctions> defineModuleUnder(const std::string& name, const Value& otherModule) = delete;
+		static Module<Base> defineModule(const std::string& name) = delete;
+		static Module<Base> defineModuleUnder(const std::string& name, const Value& otherModule) = delete;
 
 		template<typename Allocator = DefaultAllocator<Base>>
 		static Class defineClass(const std::string& name, const Value& parent = Value(rb_cObject));
@@ -72,10 +75,15 @@ namespace rb
 		template<typename ...Args>
 		Value newObject(Args... args) const;
 
-        template<typename Allocator = DefaultAllocator<Base>>
-        Value newObjectWithObject(rb::Object* object) const;
+		Value allocateObject() const;
+
+        Value newObjectWithObject(Base* object) const;
 
 	protected:
+		static void defineDataType(const Value& parent);
+		static void defineDataType(const Value& parent, std::true_type);
+		static void defineDataType(const Value& parent, std::false_type);
+
 		static Value myParent;
 	};
 }
@@ -0,0 +1,55 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "datatype.hpp"
+#include <unordered_map>
+
+namespace
+{
+	std::unordered_map<VALUE, const rb_data_type_t*>& getRegistry()
+	{
+		static std::unordered_map<VALUE, const rb_data_type_t*> registry;
+		return registry;
+	}
+
+	rb_data_type_t createObjectDataType()
+	{
+		rb_data_type_t type = rb_data_type_t();
+		type.wrap_struct_name = "rb::Object";
+		return type;
+	}
+}
+
+namespace rb
+{
+	const rb_data_type_t ObjectDataType = createObjectDataType();
+
+	void registerDataType(const Value& klass, const rb_data_type_t* type)
+	{
+		getRegistry()[klass.to<VALUE>()] = type;
+	}
+
+	const rb_data_type_t* findDataType(const Value& klass)
+	{
+		auto found = getRegistry().find(klass.to<VALUE>());
+		return found != getRegistry().end() ? found->second : nullptr;
+	}
+}
@@ -0,0 +1,79 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_DATATYPE_HEADER_
+#define RBSFML_DATATYPE_HEADER_
+
+#include <ruby.h>
+#include <string>
+
+#include "value.hpp"
+#include "object.hpp"
+
+namespace rb
+{
+	// Root of every data type defined here, used to tell our objects apart
+	// from typed data created by other extensions.
+	extern const rb_data_type_t ObjectDataType;
+
+	struct DataTypeHooks
+	{
+		rb::Object* (*toObject)(void* data);
+	};
+
+	void registerDataType(const Value& klass, const rb_data_type_t* type);
+	const rb_data_type_t* findDataType(const Value& klass);
+
+	// Each wrapped C++ type carries its own rb_data_type_t, so checking what
+	// an object holds is a pointer compare. Instances of subclasses are found
+	// through the parent links. Base types without a Ruby class of their own
+	// (modules like Drawable) fall back to a dynamic_cast through rb::Object.
+	template<typename Type>
+	class DataType
+	{
+	public:
+		static const rb_data_type_t* get();
+
+		static void setName(const std::string& name);
+		static void setParent(const rb_data_type_t* parent);
+
+		static VALUE wrap(VALUE klass, Type* object);
+
+		static bool isInstance(VALUE value);
+		static bool isInstance(const Value& value);
+
+		static Type* fetch(VALUE value);
+
+	private:
+		static rb_data_type_t create();
+		static rb::Object* toObject(void* data);
+		static Type* convert(VALUE value);
+		static void free(void* data);
+
+		static const DataTypeHooks ourHooks;
+		static rb_data_type_t ourType;
+		static bool ourIsClass;
+	};
+}
+
+#include "datatype.inc"
+
+#endif // RBSFML_DATATYPE_HEADER_
@@ -0,0 +1,88 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "gl.hpp"
+#include <SFML/Window/GlResource.hpp>
+
+namespace
+{
+	struct ContextAccess : public sf::GlResource
+	{
+		using sf::GlResource::ensureGlContext;
+	};
+
+	bool ourIsInitialized = false;
+	bool ourIsAvailable = false;
+}
+
+namespace gl
+{
+
+bool initialize()
+{
+	if(!ourIsInitialized)
+	{
+		ourIsInitialized = true;
+		ourIsAvailable = glewInit() == GLEW_OK;
+	}
+	return ourIsAvailable;
+}
+
+void ensureContext()
+{
+	ContextAccess::ensureGlContext();
+}
+
+bool hasPixelBuffers()
+{
+	return initialize() && (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object);
+}
+
+bool hasSync()
+{
+	return initialize() && (GLEW_VERSION_3_2 || GLEW_ARB_sync);
+}
+
+bool hasProgramBinaries()
+{
+	if(!initialize() || !(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+		return false;
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	return formats > 0;
+}
+
+ProgramBinding::ProgramBinding(GLuint program)
+: myPrevious(0)
+, myProgram(program)
+{
+	glGetIntegerv(GL_CURRENT_PROGRAM, &myPrevious);
+	if(static_cast<GLuint>(myPrevious) != myProgram)
+		glUseProgram(myProgram);
+}
+
+ProgramBinding::~ProgramBinding()
+{
+	if(static_cast<GLuint>(myPrevious) != myProgram)
+		glUseProgram(myPrevious);
+}
+
+}
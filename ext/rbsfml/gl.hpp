@@ -0,0 +1,58 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_GL_HEADER_
+#define RBSFML_GL_HEADER_
+
+#include <GL/glew.h>
+
+namespace gl
+{
+	// Loads the extension entry points. Needs an active context the first
+	// time it is called and returns false if loading failed.
+	bool initialize();
+
+	// Makes sure some context is active on this thread, the same way SFML
+	// does before touching its own GL objects.
+	void ensureContext();
+
+	bool hasPixelBuffers();
+	bool hasSync();
+	bool hasProgramBinaries();
+
+	// Makes a shader program current for the lifetime of the object, binding
+	// it only when needed and restoring the previous program afterwards.
+	class ProgramBinding
+	{
+	public:
+		explicit ProgramBinding(GLuint program);
+		~ProgramBinding();
+
+	private:
+		ProgramBinding(const ProgramBinding&) = delete;
+		ProgramBinding& operator=(const ProgramBinding&) = delete;
+
+		GLint myPrevious;
+		GLuint myProgram;
+	};
+}
+
+#endif // RBSFML_GL_HEADER_
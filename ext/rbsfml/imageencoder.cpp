@@ -0,0 +1,241 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "imageencoder.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <zlib.h>
+
+namespace
+{
+	void writeUint16LE(std::vector<sf::Uint8>& output, unsigned int value)
+	{
+		output.push_back(value & 0xFF);
+		output.push_back((value >> 8) & 0xFF);
+	}
+
+	void writeUint32LE(std::vector<sf::Uint8>& output, sf::Uint32 value)
+	{
+		writeUint16LE(output, value & 0xFFFF);
+		writeUint16LE(output, value >> 16);
+	}
+
+	void writeUint32BE(std::vector<sf::Uint8>& output, sf::Uint32 value)
+	{
+		output.push_back((value >> 24) & 0xFF);
+		output.push_back((value >> 16) & 0xFF);
+		output.push_back((value >> 8) & 0xFF);
+		output.push_back(value & 0xFF);
+	}
+
+	void writePngChunk(std::vector<sf::Uint8>& output, const char* type, const sf::Uint8* data, std::size_t size)
+	{
+		writeUint32BE(output, size);
+		std::size_t start = output.size();
+		output.insert(output.end(), type, type + 4);
+		output.insert(output.end(), data, data + size);
+		writeUint32BE(output, crc32(0, &output[start], size + 4));
+	}
+
+	int paeth(int a, int b, int c)
+	{
+		int p = a + b - c;
+		int pa = std::abs(p - a);
+		int pb = std::abs(p - b);
+		int pc = std::abs(p - c);
+		if(pa <= pb && pa <= pc)
+			return a;
+		return pb <= pc ? b : c;
+	}
+
+	// Every row is tried with all five PNG filters and the one with the
+	// smallest sum of absolute residuals is kept, as libpng does.
+	void filterRow(const sf::Uint8* row, const sf::Uint8* previous, std::size_t size, sf::Uint8* output, sf::Uint8* scratch)
+	{
+		unsigned long bestSum = ~0ul;
+		for(int filter = 0; filter < 5; filter++)
+		{
+			unsigned long sum = 0;
+			for(std::size_t index = 0; index < size; index++)
+			{
+				int left = index >= 4 ? row[index - 4] : 0;
+				int up = previous != nullptr ? previous[index] : 0;
+				int upLeft = (previous != nullptr && index >= 4) ? previous[index - 4] : 0;
+				int predictor = 0;
+				switch(filter)
+				{
+					case 1: predictor = left; break;
+					case 2: predictor = up; break;
+					case 3: predictor = (left + up) / 2; break;
+					case 4: predictor = paeth(left, up, upLeft); break;
+				}
+				sf::Uint8 value = static_cast<sf::Uint8>(row[index] - predictor);
+				scratch[index] = value;
+				sum += value < 128 ? value : 256 - value;
+			}
+			if(sum < bestSum)
+			{
+				bestSum = sum;
+				output[0] = static_cast<sf::Uint8>(filter);
+				std::copy(scratch, scratch + size, output + 1);
+			}
+		}
+	}
+
+	bool encodePng(const sf::Uint8* pixels, unsigned int width, unsigned int height, std::vector<sf::Uint8>& output)
+	{
+		static const sf::Uint8 signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		output.insert(output.end(), signature, signature + sizeof(signature));
+
+		std::vector<sf::Uint8> header;
+		writeUint32BE(header, width);
+		writeUint32BE(header, height);
+		header.push_back(8);
+		header.push_back(6);
+		header.push_back(0);
+		header.push_back(0);
+		header.push_back(0);
+		writePngChunk(output, "IHDR", header.data(), header.size());
+
+		std::size_t rowSize = width * 4;
+		std::vector<sf::Uint8> filtered(height * (rowSize + 1));
+		std::vector<sf::Uint8> scratch(rowSize);
+		for(unsigned int y = 0; y < height; y++)
+		{
+			const sf::Uint8* previous = y > 0 ? pixels + (y - 1) * rowSize : nullptr;
+			filterRow(pixels + y * rowSize, previous, rowSize, &filtered[y * (rowSize + 1)], scratch.data());
+		}
+
+		uLongf compressedSize = compressBound(filtered.size());
+		std::vector<sf::Uint8> compressed(compressedSize);
+		if(compress2(compressed.data(), &compressedSize, filtered.data(), filtered.size(), Z_DEFAULT_COMPRESSION) != Z_OK)
+			return false;
+		writePngChunk(output, "IDAT", compressed.data(), compressedSize);
+		writePngChunk(output, "IEND", nullptr, 0);
+		return true;
+	}
+
+	bool encodeBmp(const sf::Uint8* pixels, unsigned int width, unsigned int height, std::vector<sf::Uint8>& output)
+	{
+		std::size_t rowSize = (static_cast<std::size_t>(width) * 3 + 3) & ~static_cast<std::size_t>(3);
+		std::size_t dataSize = rowSize * height;
+		// Sizes are stored as 32 bit fields and the dimensions as signed ones.
+		if(width > 0x7fffffffu || height > 0x7fffffffu || dataSize > 0xffffffffu - 54)
+			return false;
+
+		output.push_back('B');
+		output.push_back('M');
+		writeUint32LE(output, 54 + dataSize);
+		writeUint32LE(output, 0);
+		writeUint32LE(output, 54);
+		writeUint32LE(output, 40);
+		writeUint32LE(output, width);
+		writeUint32LE(output, height);
+		writeUint16LE(output, 1);
+		writeUint16LE(output, 24);
+		writeUint32LE(output, 0);
+		writeUint32LE(output, dataSize);
+		writeUint32LE(output, 2835);
+		writeUint32LE(output, 2835);
+		writeUint32LE(output, 0);
+		writeUint32LE(output, 0);
+
+		std::size_t start = output.size();
+		output.resize(start + dataSize, 0);
+		for(unsigned int y = 0; y < height; y++)
+		{
+			const sf::Uint8* source = pixels + (height - 1 - y) * width * 4;
+			sf::Uint8* destination = &output[start + y * rowSize];
+			for(unsigned int x = 0; x < width; x++)
+			{
+				destination[x * 3 + 0] = source[x * 4 + 2];
+				destination[x * 3 + 1] = source[x * 4 + 1];
+				destination[x * 3 + 2] = source[x * 4 + 0];
+			}
+		}
+		return true;
+	}
+
+	bool encodeTga(const sf::Uint8* pixels, unsigned int width, unsigned int height, std::vector<sf::Uint8>& output)
+	{
+		if(width > 0xffff || height > 0xffff)
+			return false;
+
+		static const sf::Uint8 header[] = { 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+		output.insert(output.end(), header, header + sizeof(header));
+		writeUint16LE(output, width);
+		writeUint16LE(output, height);
+		output.push_back(32);
+		output.push_back(0x28);
+
+		std::size_t start = output.size();
+		std::size_t count = static_cast<std::size_t>(width) * height;
+		output.resize(start + count * 4);
+		for(std::size_t index = 0; index < count; index++)
+		{
+			output[start + index * 4 + 0] = pixels[index * 4 + 2];
+			output[start + index * 4 + 1] = pixels[index * 4 + 1];
+			output[start + index * 4 + 2] = pixels[index * 4 + 0];
+			output[start + index * 4 + 3] = pixels[index * 4 + 3];
+		}
+		return true;
+	}
+}
+
+namespace encoder
+{
+
+bool getFormat(const std::string& name, Format& format)
+{
+	std::string lower(name);
+	std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+	if(lower == "png")
+		format = Format::Png;
+	else if(lower == "bmp")
+		format = Format::Bmp;
+	else if(lower == "tga")
+		format = Format::Tga;
+	else
+		return false;
+	return true;
+}
+
+bool getFormatFromFilename(const std::string& filename, Format& format)
+{
+	std::size_t dot = filename.rfind('.');
+	if(dot == std::string::npos)
+		return false;
+	return getFormat(filename.substr(dot + 1), format);
+}
+
+bool encode(const sf::Uint8* pixels, unsigned int width, unsigned int height, Format format, std::vector<sf::Uint8>& output)
+{
+	switch(format)
+	{
+		case Format::Png: return encodePng(pixels, width, height, output);
+		case Format::Bmp: return encodeBmp(pixels, width, height, output);
+		case Format::Tga: return encodeTga(pixels, width, height, output);
+	}
+	return false;
+}
+
+}
@@ -0,0 +1,46 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_IMAGEENCODER_HEADER_
+#define RBSFML_IMAGEENCODER_HEADER_
+
+#include <SFML/Config.hpp>
+#include <string>
+#include <vector>
+
+namespace encoder
+{
+	enum class Format
+	{
+		Png,
+		Bmp,
+		Tga
+	};
+
+	bool getFormat(const std::string& name, Format& format);
+	bool getFormatFromFilename(const std::string& filename, Format& format);
+
+	// Returns false when the image can't be represented in format (TGA is
+	// limited to 65535x65535, BMP to 4 GB) or compression fails.
+	bool encode(const sf::Uint8* pixels, unsigned int width, unsigned int height, Format format, std::vector<sf::Uint8>& output);
+}
+
+#endif // RBSFML_IMAGEENCODER_HEADER_
@@ -0,0 +1,476 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "imagekernels.hpp"
+#include "simd.hpp"
+#include "threadpool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	const int ChannelShifts[4] = { simd::RedShift, simd::GreenShift, simd::BlueShift, simd::AlphaShift };
+
+	sf::Uint32 toPixel(const sf::Color& color)
+	{
+		return (static_cast<sf::Uint32>(color.r) << simd::RedShift) | (static_cast<sf::Uint32>(color.g) << simd::GreenShift) |
+		       (static_cast<sf::Uint32>(color.b) << simd::BlueShift) | (static_cast<sf::Uint32>(color.a) << simd::AlphaShift);
+	}
+
+	template<typename Ops, typename Kernel>
+	std::size_t run(sf::Uint32* pixels, std::size_t count, const Kernel& kernel)
+	{
+		std::size_t index = 0;
+		for(; index + Ops::Width <= count; index += Ops::Width)
+			Ops::store(pixels + index, kernel.template apply<Ops>(Ops::load(pixels + index)));
+		return index;
+	}
+
+	template<typename Kernel>
+	void apply(sf::Uint8* data, std::size_t count, const Kernel& kernel)
+	{
+		sf::Uint32* pixels = reinterpret_cast<sf::Uint32*>(data);
+		std::size_t done = run<simd::Native>(pixels, count, kernel);
+		run<simd::Scalar>(pixels + done, count - done, kernel);
+	}
+
+	struct Premultiply
+	{
+		template<typename Ops>
+		typename Ops::Vector apply(typename Ops::Vector pixels) const
+		{
+			typename Ops::Vector a = simd::channel<Ops>(pixels, simd::AlphaShift);
+			typename Ops::Vector r = simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(pixels, simd::RedShift), a));
+			typename Ops::Vector g = simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(pixels, simd::GreenShift), a));
+			typename Ops::Vector b = simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(pixels, simd::BlueShift), a));
+			return simd::pack<Ops>(r, g, b, a);
+		}
+	};
+
+	struct Unpremultiply
+	{
+		template<typename Ops>
+		typename Ops::Vector restore(typename Ops::Vector value, typename Ops::FloatVector scale) const
+		{
+			typename Ops::FloatVector result = Ops::multiply(Ops::toFloat(value), scale);
+			return Ops::toInteger(Ops::minimum(result, Ops::setFloat(255.0f)));
+		}
+
+		template<typename Ops>
+		typename Ops::Vector apply(typename Ops::Vector pixels) const
+		{
+			typename Ops::Vector a = simd::channel<Ops>(pixels, simd::AlphaShift);
+			typename Ops::FloatVector scale = Ops::divide(Ops::setFloat(255.0f), Ops::toFloat(a));
+			scale = Ops::selectFloat(Ops::equal(a, Ops::set(0)), Ops::setFloat(0.0f), scale);
+			typename Ops::Vector r = restore<Ops>(simd::channel<Ops>(pixels, simd::RedShift), scale);
+			typename Ops::Vector g = restore<Ops>(simd::channel<Ops>(pixels, simd::GreenShift), scale);
+			typename Ops::Vector b = restore<Ops>(simd::channel<Ops>(pixels, simd::BlueShift), scale);
+			return simd::pack<Ops>(r, g, b, a);
+		}
+	};
+
+	struct MaskColor
+	{
+		sf::Uint32 key;
+		sf::Uint32 alpha;
+
+		template<typename Ops>
+		typename Ops::Vector apply(typename Ops::Vector pixels) const
+		{
+			typename Ops::Vector alphaMask = Ops::set(0xFFu << simd::AlphaShift);
+			typename Ops::Vector masked = Ops::bitOr(Ops::select(alphaMask, Ops::set(0), pixels), Ops::set(alpha));
+			return Ops::select(Ops::equal(pixels, Ops::set(key)), masked, pixels);
+		}
+	};
+
+	struct Tint
+	{
+		sf::Color color;
+
+		template<typename Ops>
+		typename Ops::Vector apply(typename Ops::Vector pixels) const
+		{
+			typename Ops::Vector r = simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(pixels, simd::RedShift), Ops::set(color.r)));
+			typename Ops::Vector g = simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(pixels, simd::GreenShift), Ops::set(color.g)));
+			typename Ops::Vector b = simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(pixels, simd::BlueShift), Ops::set(color.b)));
+			typename Ops::Vector a = simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(pixels, simd::AlphaShift), Ops::set(color.a)));
+			return simd::pack<Ops>(r, g, b, a);
+		}
+	};
+
+	struct Grayscale
+	{
+		template<typename Ops>
+		typename Ops::Vector apply(typename Ops::Vector pixels) const
+		{
+			typename Ops::Vector r = Ops::multiply16(simd::channel<Ops>(pixels, simd::RedShift), Ops::set(77));
+			typename Ops::Vector g = Ops::multiply16(simd::channel<Ops>(pixels, simd::GreenShift), Ops::set(150));
+			typename Ops::Vector b = Ops::multiply16(simd::channel<Ops>(pixels, simd::BlueShift), Ops::set(29));
+			typename Ops::Vector luma = Ops::template shiftRight<8>(Ops::add(Ops::add(r, g), Ops::add(b, Ops::set(128))));
+			return simd::pack<Ops>(luma, luma, luma, simd::channel<Ops>(pixels, simd::AlphaShift));
+		}
+	};
+
+	struct Swizzle
+	{
+		int shifts[4];
+
+		template<typename Ops>
+		typename Ops::Vector apply(typename Ops::Vector pixels) const
+		{
+			return simd::pack<Ops>(simd::channel<Ops>(pixels, shifts[0]), simd::channel<Ops>(pixels, shifts[1]),
+			                       simd::channel<Ops>(pixels, shifts[2]), simd::channel<Ops>(pixels, shifts[3]));
+		}
+	};
+
+	struct Fill
+	{
+		sf::Uint32 pixel;
+
+		template<typename Ops>
+		typename Ops::Vector apply(typename Ops::Vector) const
+		{
+			return Ops::set(pixel);
+		}
+	};
+
+	template<typename Ops>
+	typename Ops::Vector blendPixels(typename Ops::Vector destination, typename Ops::Vector source)
+	{
+		typename Ops::Vector alpha = simd::channel<Ops>(source, simd::AlphaShift);
+		typename Ops::Vector inverse = Ops::subtract(Ops::set(255), alpha);
+		typename Ops::Vector channels[3];
+		for(int index = 0; index < 3; index++)
+		{
+			typename Ops::Vector top = Ops::multiply16(simd::channel<Ops>(source, ChannelShifts[index]), alpha);
+			typename Ops::Vector bottom = Ops::multiply16(simd::channel<Ops>(destination, ChannelShifts[index]), inverse);
+			channels[index] = simd::divide255<Ops>(Ops::add(top, bottom));
+		}
+		typename Ops::Vector resultAlpha = Ops::add(alpha, simd::divide255<Ops>(Ops::multiply16(simd::channel<Ops>(destination, simd::AlphaShift), inverse)));
+		return simd::pack<Ops>(channels[0], channels[1], channels[2], resultAlpha);
+	}
+
+	struct Contributions
+	{
+		std::vector<int> first;
+		std::vector<int> length;
+		std::vector<float> weights;
+		int stride;
+	};
+
+	float boxFilter(float x)
+	{
+		return (x > -0.5f && x <= 0.5f) ? 1.0f : 0.0f;
+	}
+
+	float bilinearFilter(float x)
+	{
+		x = std::fabs(x);
+		return x < 1.0f ? 1.0f - x : 0.0f;
+	}
+
+	float sinc(float x)
+	{
+		if(x == 0.0f)
+			return 1.0f;
+		x *= 3.14159265358979f;
+		return std::sin(x) / x;
+	}
+
+	float lanczosFilter(float x)
+	{
+		return (x > -3.0f && x < 3.0f) ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+	}
+
+	Contributions computeContributions(unsigned int sourceSize, unsigned int size, kernel::Filter filter)
+	{
+		float (*function)(float) = &bilinearFilter;
+		double support = 1.0;
+		switch(filter)
+		{
+			case kernel::Filter::Box:      function = &boxFilter;     support = 0.5; break;
+			case kernel::Filter::Bilinear: function = &bilinearFilter; support = 1.0; break;
+			case kernel::Filter::Lanczos:  function = &lanczosFilter; support = 3.0; break;
+		}
+
+		double scale = static_cast<double>(sourceSize) / size;
+		double filterScale = std::max(scale, 1.0);
+		support *= filterScale;
+
+		Contributions contributions;
+		contributions.stride = static_cast<int>(std::ceil(support)) * 2 + 1;
+		contributions.first.resize(size);
+		contributions.length.resize(size);
+		contributions.weights.assign(size * contributions.stride, 0.0f);
+		for(unsigned int index = 0; index < size; index++)
+		{
+			double center = (index + 0.5) * scale;
+			int first = std::max(static_cast<int>(center - support + 0.5), 0);
+			int last = std::min(static_cast<int>(center + support + 0.5), static_cast<int>(sourceSize));
+			last = std::min(last, first + contributions.stride);
+			float* weights = &contributions.weights[index * contributions.stride];
+			float total = 0.0f;
+			for(int x = first; x < last; x++)
+			{
+				weights[x - first] = function(static_cast<float>((x - center + 0.5) / filterScale));
+				total += weights[x - first];
+			}
+			if(total != 0.0f)
+			{
+				for(int x = first; x < last; x++)
+					weights[x - first] /= total;
+			}
+			contributions.first[index] = first;
+			contributions.length[index] = last - first;
+		}
+		return contributions;
+	}
+
+	// Rows are resampled with premultiplied alpha so that transparent
+	// pixels don't bleed their color into their neighbours.
+	void loadPremultipliedRow(const sf::Uint8* source, unsigned int width, float* row)
+	{
+		for(unsigned int x = 0; x < width; x++)
+		{
+			float alpha = source[x * 4 + 3] * (1.0f / 255.0f);
+			row[x * 4 + 0] = source[x * 4 + 0] * alpha;
+			row[x * 4 + 1] = source[x * 4 + 1] * alpha;
+			row[x * 4 + 2] = source[x * 4 + 2] * alpha;
+			row[x * 4 + 3] = source[x * 4 + 3];
+		}
+	}
+
+	sf::Uint8 toChannel(float value)
+	{
+		return static_cast<sf::Uint8>(std::min(std::max(value, 0.0f), 255.0f) + 0.5f);
+	}
+
+	void storeUnpremultipliedRow(const float* row, unsigned int width, sf::Uint8* destination)
+	{
+		for(unsigned int x = 0; x < width; x++)
+		{
+			sf::Uint8 alpha = toChannel(row[x * 4 + 3]);
+			float scale = alpha > 0 ? 255.0f / row[x * 4 + 3] : 0.0f;
+			destination[x * 4 + 0] = toChannel(row[x * 4 + 0] * scale);
+			destination[x * 4 + 1] = toChannel(row[x * 4 + 1] * scale);
+			destination[x * 4 + 2] = toChannel(row[x * 4 + 2] * scale);
+			destination[x * 4 + 3] = alpha;
+		}
+	}
+
+	void resampleRow(const float* source, const Contributions& contributions, unsigned int width, float* destination)
+	{
+		typedef simd::Quad Ops;
+		for(unsigned int x = 0; x < width; x++)
+		{
+			const float* weights = &contributions.weights[x * contributions.stride];
+			const float* pixels = source + contributions.first[x] * 4;
+			for(unsigned int channel = 0; channel < 4; channel += Ops::Width)
+			{
+				Ops::FloatVector sum = Ops::setFloat(0.0f);
+				for(int index = 0; index < contributions.length[x]; index++)
+					sum = Ops::addFloat(sum, Ops::multiply(Ops::setFloat(weights[index]), Ops::loadFloat(pixels + index * 4 + channel)));
+				Ops::storeFloat(destination + x * 4 + channel, sum);
+			}
+		}
+	}
+
+	template<typename Ops>
+	std::size_t resampleColumns(const float* source, std::size_t stride, const float* weights, int length,
+	                            std::size_t begin, std::size_t end, float* destination)
+	{
+		std::size_t index = begin;
+		for(; index + Ops::Width <= end; index += Ops::Width)
+		{
+			typename Ops::FloatVector sum = Ops::setFloat(0.0f);
+			for(int row = 0; row < length; row++)
+				sum = Ops::addFloat(sum, Ops::multiply(Ops::setFloat(weights[row]), Ops::loadFloat(source + row * stride + index)));
+			Ops::storeFloat(destination + index, sum);
+		}
+		return index;
+	}
+
+	// Full range BT.601 as used by JPEG, in 8 bit fixed point. The chroma
+	// offset is folded into the rounding term so the sums never go negative.
+	template<typename Ops>
+	std::size_t convertRowToYUV(const sf::Uint32* pixels, std::size_t count, sf::Uint8* luma, sf::Uint8* blue, sf::Uint8* red)
+	{
+		std::size_t index = 0;
+		for(; index + Ops::Width <= count; index += Ops::Width)
+		{
+			typename Ops::Vector value = Ops::load(pixels + index);
+			typename Ops::Vector r = simd::channel<Ops>(value, simd::RedShift);
+			typename Ops::Vector g = simd::channel<Ops>(value, simd::GreenShift);
+			typename Ops::Vector b = simd::channel<Ops>(value, simd::BlueShift);
+
+			typename Ops::Vector y = Ops::add(Ops::add(Ops::multiply16(r, Ops::set(77)), Ops::multiply16(g, Ops::set(150))),
+			                                  Ops::add(Ops::multiply16(b, Ops::set(29)), Ops::set(128)));
+			typename Ops::Vector cb = Ops::subtract(Ops::add(Ops::multiply16(b, Ops::set(128)), Ops::set(32895)),
+			                                        Ops::add(Ops::multiply16(r, Ops::set(43)), Ops::multiply16(g, Ops::set(85))));
+			typename Ops::Vector cr = Ops::subtract(Ops::add(Ops::multiply16(r, Ops::set(128)), Ops::set(32895)),
+			                                        Ops::add(Ops::multiply16(g, Ops::set(107)), Ops::multiply16(b, Ops::set(21))));
+
+			Ops::storeBytes(luma + index, Ops::template shiftRight<8>(y));
+			Ops::storeBytes(blue + index, Ops::template shiftRight<8>(cb));
+			Ops::storeBytes(red + index, Ops::template shiftRight<8>(cr));
+		}
+		return index;
+	}
+
+	void convertRowToYUV(const sf::Uint8* pixels, std::size_t count, sf::Uint8* luma, sf::Uint8* blue, sf::Uint8* red)
+	{
+		const sf::Uint32* source = reinterpret_cast<const sf::Uint32*>(pixels);
+		std::size_t done = convertRowToYUV<simd::Native>(source, count, luma, blue, red);
+		convertRowToYUV<simd::Scalar>(source + done, count - done, luma + done, blue + done, red + done);
+	}
+
+	void subsampleChroma(const sf::Uint8* top, const sf::Uint8* bottom, unsigned int width, sf::Uint8* destination)
+	{
+		for(unsigned int x = 0; x < (width + 1) / 2; x++)
+		{
+			unsigned int left = x * 2;
+			unsigned int right = std::min(left + 1, width - 1);
+			destination[x] = static_cast<sf::Uint8>((top[left] + top[right] + bottom[left] + bottom[right] + 2) / 4);
+		}
+	}
+
+	template<typename Ops>
+	std::size_t runBlend(sf::Uint32* destination, const sf::Uint32* source, std::size_t count)
+	{
+		std::size_t index = 0;
+		for(; index + Ops::Width <= count; index += Ops::Width)
+			Ops::store(destination + index, blendPixels<Ops>(Ops::load(destination + index), Ops::load(source + index)));
+		return index;
+	}
+}
+
+namespace kernel
+{
+
+void premultiplyAlpha(sf::Uint8* pixels, std::size_t count)
+{
+	apply(pixels, count, Premultiply());
+}
+
+void unpremultiplyAlpha(sf::Uint8* pixels, std::size_t count)
+{
+	apply(pixels, count, Unpremultiply());
+}
+
+void maskColor(sf::Uint8* pixels, std::size_t count, const sf::Color& key, sf::Uint8 alpha)
+{
+	MaskColor kernel;
+	kernel.key = toPixel(key);
+	kernel.alpha = static_cast<sf::Uint32>(alpha) << simd::AlphaShift;
+	apply(pixels, count, kernel);
+}
+
+void tint(sf::Uint8* pixels, std::size_t count, const sf::Color& color)
+{
+	Tint kernel;
+	kernel.color = color;
+	apply(pixels, count, kernel);
+}
+
+void grayscale(sf::Uint8* pixels, std::size_t count)
+{
+	apply(pixels, count, Grayscale());
+}
+
+void swizzle(sf::Uint8* pixels, std::size_t count, const int order[4])
+{
+	Swizzle kernel;
+	for(int index = 0; index < 4; index++)
+		kernel.shifts[index] = ChannelShifts[order[index]];
+	apply(pixels, count, kernel);
+}
+
+void blend(sf::Uint8* destination, const sf::Uint8* source, std::size_t count)
+{
+	sf::Uint32* destinationPixels = reinterpret_cast<sf::Uint32*>(destination);
+	const sf::Uint32* sourcePixels = reinterpret_cast<const sf::Uint32*>(source);
+	std::size_t done = runBlend<simd::Native>(destinationPixels, sourcePixels, count);
+	runBlend<simd::Scalar>(destinationPixels + done, sourcePixels + done, count - done);
+}
+
+void fill(sf::Uint8* pixels, std::size_t count, const sf::Color& color)
+{
+	Fill kernel;
+	kernel.pixel = toPixel(color);
+	apply(pixels, count, kernel);
+}
+
+void convertToYUV420(const sf::Uint8* pixels, unsigned int width, unsigned int height,
+                     sf::Uint8* luma, sf::Uint8* blue, sf::Uint8* red)
+{
+	std::vector<sf::Uint8> chroma(width * 4);
+	sf::Uint8* blueRows[2] = { &chroma[0], &chroma[width] };
+	sf::Uint8* redRows[2] = { &chroma[width * 2], &chroma[width * 3] };
+	unsigned int chromaWidth = (width + 1) / 2;
+	for(unsigned int y = 0; y < height; y += 2)
+	{
+		unsigned int rows = std::min(height - y, 2u);
+		for(unsigned int row = 0; row < rows; row++)
+			convertRowToYUV(pixels + (y + row) * width * 4, width, luma + (y + row) * width, blueRows[row], redRows[row]);
+
+		unsigned int bottom = rows - 1;
+		subsampleChroma(blueRows[0], blueRows[bottom], width, blue + (y / 2) * chromaWidth);
+		subsampleChroma(redRows[0], redRows[bottom], width, red + (y / 2) * chromaWidth);
+	}
+}
+
+void resize(const sf::Uint8* source, unsigned int sourceWidth, unsigned int sourceHeight,
+            sf::Uint8* destination, unsigned int width, unsigned int height, Filter filter, ThreadPool& pool)
+{
+	if(sourceWidth == 0 || sourceHeight == 0 || width == 0 || height == 0)
+		return;
+
+	Contributions horizontal = computeContributions(sourceWidth, width, filter);
+	Contributions vertical = computeContributions(sourceHeight, height, filter);
+	std::size_t stride = width * 4;
+	std::vector<float> intermediate(stride * sourceHeight);
+
+	pool.parallelFor(sourceHeight, [&](std::size_t begin, std::size_t end)
+	{
+		std::vector<float> row(sourceWidth * 4);
+		for(std::size_t y = begin; y < end; y++)
+		{
+			loadPremultipliedRow(source + y * sourceWidth * 4, sourceWidth, row.data());
+			resampleRow(row.data(), horizontal, width, &intermediate[y * stride]);
+		}
+	});
+
+	pool.parallelFor(height, [&](std::size_t begin, std::size_t end)
+	{
+		std::vector<float> row(stride);
+		for(std::size_t y = begin; y < end; y++)
+		{
+			const float* rows = &intermediate[vertical.first[y] * stride];
+			const float* weights = &vertical.weights[y * vertical.stride];
+			std::size_t done = resampleColumns<simd::Native>(rows, stride, weights, vertical.length[y], 0, stride, row.data());
+			resampleColumns<simd::Scalar>(rows, stride, weights, vertical.length[y], done, stride, row.data());
+			storeUnpremultipliedRow(row.data(), width, destination + y * stride);
+		}
+	});
+}
+
+}
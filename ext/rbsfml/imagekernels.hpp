@@ -0,0 +1,55 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_IMAGEKERNELS_HEADER_
+#define RBSFML_IMAGEKERNELS_HEADER_
+
+#include <SFML/Graphics/Color.hpp>
+#include <cstddef>
+
+class ThreadPool;
+
+namespace kernel
+{
+	enum class Filter
+	{
+		Box,
+		Bilinear,
+		Lanczos
+	};
+
+	void premultiplyAlpha(sf::Uint8* pixels, std::size_t count);
+	void unpremultiplyAlpha(sf::Uint8* pixels, std::size_t count);
+	void maskColor(sf::Uint8* pixels, std::size_t count, const sf::Color& key, sf::Uint8 alpha);
+	void tint(sf::Uint8* pixels, std::size_t count, const sf::Color& color);
+	void grayscale(sf::Uint8* pixels, std::size_t count);
+	void swizzle(sf::Uint8* pixels, std::size_t count, const int order[4]);
+	void blend(sf::Uint8* destination, const sf::Uint8* source, std::size_t count);
+	void fill(sf::Uint8* pixels, std::size_t count, const sf::Color& color);
+
+	void convertToYUV420(const sf::Uint8* pixels, unsigned int width, unsigned int height,
+	                     sf::Uint8* luma, sf::Uint8* blue, sf::Uint8* red);
+
+	void resize(const sf::Uint8* source, unsigned int sourceWidth, unsigned int sourceHeight,
+	            sf::Uint8* destination, unsigned int width, unsigned int height, Filter filter, ThreadPool& pool);
+}
+
+#endif // RBSFML_IMAGEKERNELS_HEADER_
@@ -20,6 +20,21 @@
  */
 
 #include "macros.hpp"
+#include "error.hpp"
+
+namespace macro
+{
+
+std::string toName(const rb::Value& value)
+{
+	if(value.getType() == rb::ValueType::Symbol)
+		return rb::Value(rb_sym2str(value.to<VALUE>())).to<std::string>();
+	else if(value.getType() != rb::ValueType::String)
+		rb::expectedTypes("Symbol", "String");
+	return value.to<std::string>();
+}
+
+}
 
 namespace rb
 {
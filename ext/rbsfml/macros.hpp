@@ -30,6 +30,8 @@ namespace macro
 {
 	template<typename Type>
 	std::string toString(const Type& value);
+
+	std::string toName(const rb::Value& value);
 }
 
 namespace rb
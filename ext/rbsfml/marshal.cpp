@@ -0,0 +1,158 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "marshal.hpp"
+#include "base.hpp"
+#include "error.hpp"
+#include <zlib.h>
+
+namespace
+{
+	constexpr sf::Uint8 FormatVersion = 1;
+	constexpr sf::Uint8 CompressedFlag = 0x80;
+
+	// Below this deflating costs more than the bytes it saves.
+	const std::size_t CompressThreshold = 256;
+	// Large images are (de)compressed without holding the GVL.
+	const std::size_t UnlockThreshold = 1024 * 1024;
+	// Upper bound of the deflate compression ratio, used to reject bogus sizes.
+	const std::size_t MaxInflateRatio = 1032;
+
+	bool ourCompressionEnabled = true;
+
+	template<typename Function>
+	void runCodec(std::size_t size, Function function)
+	{
+		if(size >= UnlockThreshold)
+			rb::callWithoutGVL(function);
+		else
+			function();
+	}
+}
+
+namespace marshal
+{
+
+bool isCompressionEnabled()
+{
+	return ourCompressionEnabled;
+}
+
+void setCompressionEnabled(bool enabled)
+{
+	ourCompressionEnabled = enabled;
+}
+
+rb::Value pack(const std::string& payload, bool compressible)
+{
+	std::string data;
+	binary::Writer writer(data);
+	if(compressible && ourCompressionEnabled && payload.size() >= CompressThreshold)
+	{
+		uLongf compressedSize = compressBound(payload.size());
+		std::string compressed(compressedSize, '\0');
+		int result = Z_OK;
+		runCodec(payload.size(), [&]() {
+			result = compress2(reinterpret_cast<Bytef*>(&compressed[0]), &compressedSize,
+			                   reinterpret_cast<const Bytef*>(payload.data()), payload.size(), Z_BEST_SPEED);
+		});
+
+		if(result == Z_OK && compressedSize < payload.size())
+		{
+			writer.writeUint8(FormatVersion | CompressedFlag);
+			writer.writeVarUint(payload.size());
+			writer.writeBytes(compressed.data(), compressedSize);
+			return rb::Value(rb_str_new(data.data(), data.size()));
+		}
+	}
+
+	writer.writeUint8(FormatVersion);
+	writer.writeBytes(payload.data(), payload.size());
+	return rb::Value(rb_str_new(data.data(), data.size()));
+}
+
+std::string unpack(const rb::Value& data, const std::string& className)
+{
+	const std::string& bytes = data.to<const std::string&>();
+	binary::Reader reader(bytes.data(), bytes.size());
+	sf::Uint8 header = reader.readUint8();
+	if(reader.isFailed() || (header & ~CompressedFlag) != FormatVersion)
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", className.c_str());
+
+	std::size_t offset = bytes.size() - reader.getRemaining();
+	if((header & CompressedFlag) == 0)
+		return bytes.substr(offset);
+
+	std::size_t size = reader.readVarUint();
+	offset = bytes.size() - reader.getRemaining();
+	std::size_t compressedSize = bytes.size() - offset;
+	if(reader.isFailed() || size / MaxInflateRatio > compressedSize)
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", className.c_str());
+
+	std::string payload(size, '\0');
+	uLongf payloadSize = size;
+	int result = Z_OK;
+	runCodec(size, [&]() {
+		result = uncompress(reinterpret_cast<Bytef*>(&payload[0]), &payloadSize,
+		                    reinterpret_cast<const Bytef*>(bytes.data() + offset), compressedSize);
+	});
+
+	if(result != Z_OK || payloadSize != size)
+		rb::raise(rb::ArgumentError, "corrupt marshal data for %s", className.c_str());
+	return payload;
+}
+
+void writeNumerics(binary::Writer& writer, const rb::Value* values, std::size_t count)
+{
+	sf::Uint8 floats = 0;
+	for(std::size_t index = 0; index < count; index++)
+	{
+		rb::ValueType type = values[index].getType();
+		if(type == rb::ValueType::Float)
+			floats |= 1 << index;
+		else if(type != rb::ValueType::Fixnum)
+			rb::raise(rb::TypeError, "can't dump %s component", values[index].getClassName().c_str());
+	}
+
+	writer.writeUint8(floats);
+	for(std::size_t index = 0; index < count; index++)
+	{
+		if(floats & (1 << index))
+			writer.writeDouble(values[index].to<double>());
+		else
+			writer.writeVarInt(values[index].to<long long int>());
+	}
+}
+
+bool readNumerics(binary::Reader& reader, rb::Value* values, std::size_t count)
+{
+	sf::Uint8 floats = reader.readUint8();
+	for(std::size_t index = 0; index < count; index++)
+	{
+		if(floats & (1 << index))
+			values[index] = rb::Value(reader.readDouble());
+		else
+			values[index] = rb::Value(static_cast<long long int>(reader.readVarInt()));
+	}
+	return !reader.isFailed();
+}
+
+}
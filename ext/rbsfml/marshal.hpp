@@ -0,0 +1,52 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_MARSHAL_HEADER_
+#define RBSFML_MARSHAL_HEADER_
+
+#include <cstddef>
+#include <string>
+#include "value.hpp"
+#include "binary.hpp"
+
+namespace marshal
+{
+	// Toggled through SFML.marshal_compression, enabled by default.
+	bool isCompressionEnabled();
+	void setCompressionEnabled(bool enabled);
+
+	// Wraps a payload in the envelope shared by all _dump implementations: a
+	// single byte holding the format version and whether the rest is zlib
+	// compressed. Compressible payloads are only deflated when they are large
+	// enough and actually shrink.
+	rb::Value pack(const std::string& payload, bool compressible);
+
+	// Validates the envelope and returns the raw payload. Raises ArgumentError
+	// mentioning className when the data is malformed.
+	std::string unpack(const rb::Value& data, const std::string& className);
+
+	// Integer and Float components keep their class across a round trip; a
+	// leading bit mask records which of the (at most 8) values are floats.
+	void writeNumerics(binary::Writer& writer, const rb::Value* values, std::size_t count);
+	bool readNumerics(binary::Reader& reader, rb::Value* values, std::size_t count);
+}
+
+#endif // RBSFML_MARSHAL_HEADER_
@@ -24,19 +24,21 @@
 
 #include <ruby.h>
 #include <string>
-#include <array>
 #include <vector>
 
 #include "value.hpp"
 #include "error.hpp"
+#include "datatype.hpp"
+
+// Expands to the type and value template arguments expected by
+// defineFunction and defineMethod, e.g. defineMethod<RBSFML_FN(&rbFoo::bar)>("bar").
+#define RBSFML_FN(function) decltype(function), function
 
 namespace rb
 {
 	typedef VALUE(*RubyCallback)(...);
 
-	struct CallerBase {};
-
-	template<typename Base, int MaxFunctions = 32>
+	template<typename Base>
 	class Module
 	{
 	public:
@@ -49,18 +51,16 @@ namespace rb
 
 		bool isDefined() const;
 
-		template<int ID, typename ReturnType, typename ...Args>
-		void defineFunction(const std::string& name, ReturnType(*function)(Args...));
+		template<typename Signature, Signature Function>
+		void defineFunction(const std::string& name);
 
-		template<int ID, typename ReturnType, typename ...Args>
-		void defineMethod(const std::string& name, ReturnType(Base::*function)(Args...));
-		template<int ID, typename ReturnType, typename ...Args>
-		void defineMethod(const std::string& name, ReturnType(Base::*function)(Args...)const);
-		template<int ID, typename ReturnType, typename ...Args>
-		void defineMethod(const std::string& name, ReturnType(*function)(Args...));
+		template<typename Signature, Signature Function>
+		void defineMethod(const std::string& name);
 
-		template<int ID>
-		void defineMethod(const std::string& name, Value(*function)(Value, const std::vector<Value>&));
+		// Singleton method bound like defineMethod, the function gets the
+		// receiving module or class as its first argument.
+		template<typename Signature, Signature Function>
+		void defineSingletonMethod(const std::string& name);
 
 		void includeModule(const rb::Value& value);
 
@@ -73,191 +73,20 @@ namespace rb
 	protected:
 		friend class Value;
 
-		template<typename ReturnType, typename ...Args>
-		struct FunctionCaller : public CallerBase
-		{
-			FunctionCaller(ReturnType(*f)(Args... args)) : function(f) {}
-
-			VALUE operator()(Value self, Args... args) 
-			{ 
-				Value returnValue = Value::create(function(args...));
-				return returnValue.to<VALUE>();
-			}
-
-			ReturnType(*function)(Args... args);
-		};
-
-		template<typename ...Args>
-		struct FunctionCaller<void, Args...> : public CallerBase
-		{
-			FunctionCaller(void(*f)(Args... args)) : function(f) {}
-
-			VALUE operator()(Value self, Args... args)
-			{
-				function(args...);
-				return Qnil;
-			}
-
-			VALUE self;
-			void(*function)(Args... args);
-		};
-
-		template<typename ReturnType, typename ...Args>
-		struct MethodCaller : public CallerBase
-		{
-			MethodCaller(ReturnType(Base::*f)(Args... args)) : function(f) {}
-
-			VALUE operator()(Value self, Args... args) 
-			{ 
-				if(self.isFrozen())
-					rb::modifiedFrozen(self);
-				Base* object = nullptr;
-				Data_Get_Struct(self.to<VALUE>(), Base, object);
-				Value returnValue = Value::create((object->*function)(args...));
-				return returnValue.to<VALUE>();
-			}
-
-			ReturnType(Base::*function)(Args... args);
-		};
-
-		template<typename ...Args>
-		struct MethodCaller<void, Args...> : public CallerBase
-		{
-			MethodCaller(void(Base::*f)(Args... args)) : function(f) {}
-
-			VALUE operator()(Value self, Args... args)
-			{
-				if(self.isFrozen())
-					rb::modifiedFrozen(self);
-
-				Base* object = nullptr;
-				Data_Get_Struct(self.to<VALUE>(), Base, object);
-				(object->*function)(args...);
-				return Qnil;
-			}
-
-			void(Base::*function)(Args... args);
-		};
-
-		template<typename ReturnType, typename ...Args>
-		struct ConstMethodCaller : public CallerBase
-		{
-			ConstMethodCaller(ReturnType(Base::*f)(Args... args)const) : function(f) {}
-
-			VALUE operator()(Value self, Args... args) 
-			{ 
-				Base* object = nullptr;
-				Data_Get_Struct(self.to<VALUE>(), Base, object);
-				Value returnValue = Value::create((object->*function)(args...));
-				return returnValue.to<VALUE>();
-			}
-
-			ReturnType(Base::*function)(Args... args)const;
-		};
-
-		template<typename ...Args>
-		struct ConstMethodCaller<void, Args...> : public CallerBase
-		{
-			ConstMethodCaller(void(Base::*f)(Args... args)const) : function(f) {}
-
-			VALUE operator()(Value self, Args... args)
-			{
-				Base* object = nullptr;
-				Data_Get_Struct(self.to<VALUE>(), Base, object);
-				(object->*function)(args...);
-				return Qnil;
-			}
-
-			void(Base::*function)(Args... args)const;
-		};
-
-		template<typename ReturnType, typename ...Args>
-		struct StaticMethodCaller : public CallerBase
-		{
-			StaticMethodCaller(ReturnType(*f)(Args... args)) : function(f) {}
-
-			VALUE operator()(Args... args) 
-			{ 
-				Value returnValue = Value::create(function(args...));
-				return returnValue.to<VALUE>();
-			}
-
-			ReturnType(*function)(Args... args);
-		};
-
-		template<typename ...Args>
-		struct StaticMethodCaller<void, Args...> : public CallerBase
-		{
-			StaticMethodCaller(void(*f)(Args... args)) : function(f) {}
-
-			VALUE operator()(Args... args)
-			{
-				function(args...);
-				return Qnil;
-			}
-
-			void(*function)(Args... args);
-		};
-
-		struct VariadicMethodCaller : public CallerBase
-		{
-			VariadicMethodCaller(Value(*f)(Value, const std::vector<Value>&)) : function(f) {}
-
-			VALUE operator()(Value self, const std::vector<Value>& args) 
-			{ 
-				Value returnValue = Value::create(function(Value(self), args));
-				return returnValue.to<VALUE>();
-			}
-
-			Value(*function)(Value, const std::vector<Value>&);
-		};
-
-		template<int ID, typename FunctionSignature, typename CallerSignature>
-		static void createCaller(FunctionSignature function);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature>
-		static CallerSignature& getCaller();
-
-		template<int ID>
-		static VALUE variadicWrapperFunction(int argc, VALUE* argv, VALUE self);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self>
-		static VALUE wrapperFunction(VALUE self);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1>
-		static VALUE wrapperFunction(VALUE self, VALUE arg1);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2>
-		static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2, typename Arg3>
-		static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2, VALUE arg3);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2, typename Arg3, typename Arg4>
-		static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2, VALUE arg3, VALUE arg4);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5>
-		static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2, VALUE arg3, VALUE arg4, VALUE arg5);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6>
-		static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2, VALUE arg3, VALUE arg4, VALUE arg5, VALUE arg6);
-
-		template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7>
-        static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2, VALUE arg3, VALUE arg4, VALUE arg5, VALUE arg6, VALUE arg7);
-
-        template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7, typename Arg8>
-        static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2, VALUE arg3, VALUE arg4, VALUE arg5, VALUE arg6, VALUE arg7, VALUE arg8);
-
-        template<int ID, typename FunctionSignature, typename CallerSignature, typename Self, typename Arg1, typename Arg2, typename Arg3, typename Arg4, typename Arg5, typename Arg6, typename Arg7, typename Arg8, typename Arg9>
-        static VALUE wrapperFunction(VALUE self, VALUE arg1, VALUE arg2, VALUE arg3, VALUE arg4, VALUE arg5, VALUE arg6, VALUE arg7, VALUE arg8, VALUE arg9);
-
-		static std::array<CallerBase*, MaxFunctions> ourFunctions;
 		static VALUE myDefinition;
 		static std::string myName;
 		static Value myNamespace;
 	};
+
+	// The bound function is a template argument, so every Ruby method gets its
+	// own wrapper that converts the arguments and calls straight into it.
+	template<typename Base, typename Signature, Signature Function>
+	struct FunctionBinding;
+
+	template<typename Base, typename Signature, Signature Function>
+	struct MethodBinding;
 }
 
 #include "module.inc"
 
-#endif // RBSFML_MODULE_HPP_
\ No newline at end of file
+#endif // RBSFML_MODULE_HPP_
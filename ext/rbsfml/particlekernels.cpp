@@ -0,0 +1,236 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "particlekernels.hpp"
+#include "simd.hpp"
+#include <algorithm>
+
+namespace
+{
+	template<typename Ops>
+	std::size_t integrateLanes(particle::Storage& particles, std::size_t begin, std::size_t end,
+	                           float delta, float damping, sf::Vector2f acceleration)
+	{
+		typedef typename Ops::FloatVector FloatVector;
+		const FloatVector step = Ops::setFloat(delta);
+		const FloatVector drag = Ops::setFloat(damping);
+		const FloatVector accelerationX = Ops::setFloat(acceleration.x);
+		const FloatVector accelerationY = Ops::setFloat(acceleration.y);
+
+		float* positionX = particles.positionX.data();
+		float* positionY = particles.positionY.data();
+		float* velocityX = particles.velocityX.data();
+		float* velocityY = particles.velocityY.data();
+		float* age = particles.age.data();
+
+		std::size_t index = begin;
+		for(; index + Ops::Width <= end; index += Ops::Width)
+		{
+			FloatVector x = Ops::addFloat(Ops::multiply(Ops::loadFloat(velocityX + index), drag), accelerationX);
+			FloatVector y = Ops::addFloat(Ops::multiply(Ops::loadFloat(velocityY + index), drag), accelerationY);
+			Ops::storeFloat(velocityX + index, x);
+			Ops::storeFloat(velocityY + index, y);
+			Ops::storeFloat(positionX + index, Ops::addFloat(Ops::loadFloat(positionX + index), Ops::multiply(x, step)));
+			Ops::storeFloat(positionY + index, Ops::addFloat(Ops::loadFloat(positionY + index), Ops::multiply(y, step)));
+			Ops::storeFloat(age + index, Ops::addFloat(Ops::loadFloat(age + index), step));
+		}
+		return index;
+	}
+
+	float getProgress(const particle::Storage& particles, std::size_t index)
+	{
+		float lifetime = particles.lifetime[index];
+		if(lifetime <= 0)
+			return 1;
+		return std::min(particles.age[index] / lifetime, 1.0f);
+	}
+
+	sf::Uint8 mix(sf::Uint8 from, sf::Uint8 to, float progress)
+	{
+		return static_cast<sf::Uint8>(from + (to - from) * progress + 0.5f);
+	}
+
+	sf::Color getColor(const particle::Storage& particles, std::size_t index, const particle::Affectors& affectors)
+	{
+		const sf::Color& color = particles.color[index];
+		if(!affectors.colorOverLife)
+			return color;
+
+		float progress = getProgress(particles, index);
+		sf::Color life(mix(affectors.startColor.r, affectors.endColor.r, progress),
+		               mix(affectors.startColor.g, affectors.endColor.g, progress),
+		               mix(affectors.startColor.b, affectors.endColor.b, progress),
+		               mix(affectors.startColor.a, affectors.endColor.a, progress));
+		return color * life;
+	}
+
+	float getSize(const particle::Storage& particles, std::size_t index, const particle::Affectors& affectors)
+	{
+		float size = particles.size[index];
+		if(!affectors.sizeOverLife)
+			return size;
+
+		float progress = getProgress(particles, index);
+		return size * (affectors.startSize + (affectors.endSize - affectors.startSize) * progress);
+	}
+}
+
+namespace particle
+{
+
+Storage::Storage()
+: positionX()
+, positionY()
+, velocityX()
+, velocityY()
+, age()
+, lifetime()
+, size()
+, color()
+, count(0)
+{
+}
+
+std::size_t Storage::getCapacity() const
+{
+	return age.size();
+}
+
+void Storage::setCapacity(std::size_t capacity)
+{
+	positionX.resize(capacity);
+	positionY.resize(capacity);
+	velocityX.resize(capacity);
+	velocityY.resize(capacity);
+	age.resize(capacity);
+	lifetime.resize(capacity);
+	size.resize(capacity);
+	color.resize(capacity);
+	count = std::min(count, capacity);
+}
+
+bool Storage::add(sf::Vector2f position, sf::Vector2f velocity, float lifetime, float size, const sf::Color& color)
+{
+	if(count >= getCapacity())
+		return false;
+
+	positionX[count] = position.x;
+	positionY[count] = position.y;
+	velocityX[count] = velocity.x;
+	velocityY[count] = velocity.y;
+	age[count] = 0;
+	this->lifetime[count] = lifetime;
+	this->size[count] = size;
+	this->color[count] = color;
+	count++;
+	return true;
+}
+
+void Storage::remove(std::size_t index)
+{
+	std::size_t last = --count;
+	positionX[index] = positionX[last];
+	positionY[index] = positionY[last];
+	velocityX[index] = velocityX[last];
+	velocityY[index] = velocityY[last];
+	age[index] = age[last];
+	lifetime[index] = lifetime[last];
+	size[index] = size[last];
+	color[index] = color[last];
+}
+
+void Storage::clear()
+{
+	count = 0;
+}
+
+Affectors::Affectors()
+: gravity()
+, drag(0)
+, colorOverLife(false)
+, startColor(sf::Color::White)
+, endColor(sf::Color::White)
+, sizeOverLife(false)
+, startSize(1)
+, endSize(1)
+{
+}
+
+void integrate(Storage& particles, std::size_t begin, std::size_t end, float delta, const Affectors& affectors)
+{
+	float damping = std::max(1.0f - affectors.drag * delta, 0.0f);
+	sf::Vector2f acceleration = affectors.gravity * delta;
+	std::size_t done = integrateLanes<simd::Native>(particles, begin, end, delta, damping, acceleration);
+	integrateLanes<simd::Scalar>(particles, done, end, delta, damping, acceleration);
+}
+
+std::size_t removeExpired(Storage& particles)
+{
+	std::size_t removed = 0;
+	for(std::size_t index = 0; index < particles.count;)
+	{
+		if(particles.age[index] >= particles.lifetime[index])
+		{
+			particles.remove(index);
+			removed++;
+		}
+		else
+		{
+			index++;
+		}
+	}
+	return removed;
+}
+
+void writeQuads(const Storage& particles, std::size_t begin, std::size_t end, const Affectors& affectors,
+                const sf::FloatRect& textureRect, sf::Vertex* vertices)
+{
+	float left = textureRect.left;
+	float top = textureRect.top;
+	float right = textureRect.left + textureRect.width;
+	float bottom = textureRect.top + textureRect.height;
+
+	for(std::size_t index = begin; index < end; index++)
+	{
+		float x = particles.positionX[index];
+		float y = particles.positionY[index];
+		float half = getSize(particles, index, affectors) * 0.5f;
+		sf::Color color = getColor(particles, index, affectors);
+
+		sf::Vertex* quad = vertices + index * 4;
+		quad[0] = sf::Vertex(sf::Vector2f(x - half, y - half), color, sf::Vector2f(left, top));
+		quad[1] = sf::Vertex(sf::Vector2f(x + half, y - half), color, sf::Vector2f(right, top));
+		quad[2] = sf::Vertex(sf::Vector2f(x + half, y + half), color, sf::Vector2f(right, bottom));
+		quad[3] = sf::Vertex(sf::Vector2f(x - half, y + half), color, sf::Vector2f(left, bottom));
+	}
+}
+
+void writePoints(const Storage& particles, std::size_t begin, std::size_t end, const Affectors& affectors,
+                 sf::Vertex* vertices)
+{
+	for(std::size_t index = begin; index < end; index++)
+	{
+		vertices[index] = sf::Vertex(sf::Vector2f(particles.positionX[index], particles.positionY[index]),
+		                             getColor(particles, index, affectors));
+	}
+}
+
+}
@@ -0,0 +1,82 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_PARTICLEKERNELS_HEADER_
+#define RBSFML_PARTICLEKERNELS_HEADER_
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace particle
+{
+	// Particles are kept as one array per attribute so the integration step
+	// can stream through them a SIMD register at a time.
+	struct Storage
+	{
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> age;
+		std::vector<float> lifetime;
+		std::vector<float> size;
+		std::vector<sf::Color> color;
+		std::size_t count;
+
+		Storage();
+
+		std::size_t getCapacity() const;
+		void setCapacity(std::size_t capacity);
+
+		bool add(sf::Vector2f position, sf::Vector2f velocity, float lifetime, float size, const sf::Color& color);
+		void remove(std::size_t index);
+		void clear();
+	};
+
+	struct Affectors
+	{
+		sf::Vector2f gravity;
+		float drag;
+
+		bool colorOverLife;
+		sf::Color startColor;
+		sf::Color endColor;
+
+		bool sizeOverLife;
+		float startSize;
+		float endSize;
+
+		Affectors();
+	};
+
+	void integrate(Storage& particles, std::size_t begin, std::size_t end, float delta, const Affectors& affectors);
+	std::size_t removeExpired(Storage& particles);
+
+	void writeQuads(const Storage& particles, std::size_t begin, std::size_t end, const Affectors& affectors,
+	                const sf::FloatRect& textureRect, sf::Vertex* vertices);
+	void writePoints(const Storage& particles, std::size_t begin, std::size_t end, const Affectors& affectors,
+	                 sf::Vertex* vertices);
+}
+
+#endif // RBSFML_PARTICLEKERNELS_HEADER_
@@ -0,0 +1,284 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "gl.hpp"
+#include "rbasynccapture.hpp"
+#include "rbrenderbasetype.hpp"
+#include "rbnoncopyable.hpp"
+#include "rbimage.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <cstring>
+
+namespace
+{
+	constexpr char symVarTarget[] = "@__internal__target";
+
+	struct ContextGuard : public sf::GlResource
+	{
+		ContextGuard() { ensureGlContext(); }
+	};
+}
+
+rbAsyncCaptureClass rbAsyncCapture::ourDefinition;
+
+void rbAsyncCapture::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbAsyncCaptureClass::defineClassUnder("AsyncCapture", sfml);
+	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::capture)>("capture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::poll)>("poll");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::pollString)>("poll_string");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::wait)>("wait");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::getPendingCount)>("pending");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::getBufferCount)>("buffer_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::getDroppedCount)>("dropped");
+	ourDefinition.defineMethod<RBSFML_FN(&rbAsyncCapture::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbAsyncCaptureClass& rbAsyncCapture::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbAsyncCapture::rbAsyncCapture()
+: rb::Object()
+, myTarget(nullptr)
+, myBuffers()
+, myFences()
+, myHead(0)
+, myCount(0)
+, myDropped(0)
+, mySize(0, 0)
+{
+}
+
+rbAsyncCapture::~rbAsyncCapture()
+{
+	release();
+}
+
+rb::Value rbAsyncCapture::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	rbAsyncCapture* object = self.to<rbAsyncCapture*>();
+	unsigned int bufferCount = 3;
+	switch(args.size())
+	{
+		case 2:
+			bufferCount = args[1].to<unsigned int>();
+			if(bufferCount < 2)
+				rb::raise(rb::ArgumentError, "at least 2 buffers are needed, got %u", bufferCount);
+		case 1:
+			object->myTarget = args[0].to<rbRenderBaseType*>();
+			if(static_cast<const rbRenderBaseType*>(object->myTarget)->getRenderTarget() == nullptr)
+				rb::expectedTypes("SFML::RenderWindow", "SFML::RenderTexture");
+			self.setVar<symVarTarget>(args[0]);
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 1, 2);
+			break;
+	}
+
+	object->release();
+	object->myBuffers.assign(bufferCount, 0);
+	object->myFences.assign(bufferCount, nullptr);
+	return self;
+}
+
+void rbAsyncCapture::capture()
+{
+	activate();
+	sf::Vector2u size = myTarget->getRenderTarget()->getSize();
+	if(size != mySize)
+		resize(size);
+	if(myCount == myBuffers.size())
+	{
+		discardOldest();
+		myDropped++;
+	}
+
+	unsigned int slot = (myHead + myCount) % myBuffers.size();
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, myBuffers[slot]);
+	glReadPixels(0, 0, mySize.x, mySize.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	if(gl::hasSync())
+		myFences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	myCount++;
+}
+
+rb::Value rbAsyncCapture::poll()
+{
+	if(myCount == 0 || !isOldestReady())
+		return rb::Nil;
+	return wait();
+}
+
+rb::Value rbAsyncCapture::pollString()
+{
+	if(myCount == 0 || !isOldestReady())
+		return rb::Nil;
+
+	rb::Value string(rb_str_new(nullptr, mySize.x * mySize.y * 4));
+	readOldest(reinterpret_cast<sf::Uint8*>(RSTRING_PTR(string.to<VALUE>())));
+	return string;
+}
+
+rb::Value rbAsyncCapture::wait()
+{
+	if(myCount == 0)
+		return rb::Nil;
+
+	rb::Value image = rbImage::getDefinition().newObject();
+	sf::Image& pixels = image.to<sf::Image&>();
+	pixels.create(mySize.x, mySize.y);
+	readOldest(const_cast<sf::Uint8*>(pixels.getPixelsPtr()));
+	return image;
+}
+
+unsigned int rbAsyncCapture::getPendingCount() const
+{
+	return myCount;
+}
+
+unsigned int rbAsyncCapture::getBufferCount() const
+{
+	return myBuffers.size();
+}
+
+unsigned int rbAsyncCapture::getDroppedCount() const
+{
+	return myDropped;
+}
+
+std::string rbAsyncCapture::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myCount) + "/" + macro::toString(myBuffers.size()) + ")";
+}
+
+bool rbAsyncCapture::readFrame(std::vector<sf::Uint8>& pixels, sf::Vector2u& size, bool block)
+{
+	if(myCount == 0 || (!block && !isOldestReady()))
+		return false;
+
+	size = mySize;
+	pixels.resize(mySize.x * mySize.y * 4);
+	readOldest(pixels.data());
+	return true;
+}
+
+void rbAsyncCapture::activate()
+{
+	if(myTarget == nullptr)
+		rb::raise(rb::RuntimeError, "%s is not initialized", ourDefinition.getName().c_str());
+	if(!myTarget->activate(true))
+		rb::raise(rb::RuntimeError, "failed to activate the capture target");
+	if(!gl::hasPixelBuffers())
+		rb::raise(rb::RuntimeError, "pixel buffer objects are not supported by this context");
+}
+
+void rbAsyncCapture::resize(const sf::Vector2u& size)
+{
+	while(myCount > 0)
+		discardOldest();
+	if(myBuffers[0] == 0)
+		glGenBuffers(myBuffers.size(), myBuffers.data());
+
+	for(unsigned int buffer : myBuffers)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+		glBufferData(GL_PIXEL_PACK_BUFFER, size.x * size.y * 4, nullptr, GL_STREAM_READ);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	mySize = size;
+}
+
+void rbAsyncCapture::discardOldest()
+{
+	if(myFences[myHead] != nullptr)
+		glDeleteSync(static_cast<GLsync>(myFences[myHead]));
+	myFences[myHead] = nullptr;
+	myHead = (myHead + 1) % myBuffers.size();
+	myCount--;
+}
+
+// Without sync objects a readback is considered ready once a newer one has
+// been queued behind it, which gives the GPU at least a frame to finish.
+bool rbAsyncCapture::isOldestReady()
+{
+	activate();
+	if(myFences[myHead] == nullptr)
+		return myCount > 1;
+
+	GLenum status = glClientWaitSync(static_cast<GLsync>(myFences[myHead]), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+// glReadPixels rows start at the bottom, images start at the top.
+void rbAsyncCapture::readOldest(sf::Uint8* destination)
+{
+	activate();
+	std::size_t rowSize = mySize.x * 4;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, myBuffers[myHead]);
+	const sf::Uint8* source = static_cast<const sf::Uint8*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+	if(source != nullptr)
+	{
+		for(unsigned int y = 0; y < mySize.y; y++)
+			std::memcpy(destination + y * rowSize, source + (mySize.y - 1 - y) * rowSize, rowSize);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	discardOldest();
+}
+
+void rbAsyncCapture::release()
+{
+	if(myBuffers.empty() || myBuffers[0] == 0)
+		return;
+
+	ContextGuard guard;
+	while(myCount > 0)
+		discardOldest();
+	glDeleteBuffers(myBuffers.size(), myBuffers.data());
+	myBuffers.assign(myBuffers.size(), 0);
+	mySize = sf::Vector2u(0, 0);
+}
+
+namespace rb
+{
+
+template<>
+rbAsyncCapture* Value::to() const
+{
+	return DataType<rbAsyncCapture>::fetch(myValue);
+}
+
+template<>
+const rbAsyncCapture* Value::to() const
+{
+	return DataType<rbAsyncCapture>::fetch(myValue);
+}
+
+}
@@ -0,0 +1,87 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBASYNCCAPTURE_HPP_
+#define RBSFML_RBASYNCCAPTURE_HPP_
+
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbAsyncCapture;
+class rbRenderBaseType;
+
+typedef rb::Class<rbAsyncCapture> rbAsyncCaptureClass;
+
+class rbAsyncCapture : public rb::Object
+{
+public:
+	static void defineClass(const rb::Value& sfml);
+	static rbAsyncCaptureClass& getDefinition();
+
+	rbAsyncCapture();
+	~rbAsyncCapture();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+
+	void capture();
+	rb::Value poll();
+	rb::Value pollString();
+	rb::Value wait();
+
+	unsigned int getPendingCount() const;
+	unsigned int getBufferCount() const;
+	unsigned int getDroppedCount() const;
+
+	std::string inspect() const;
+
+	bool readFrame(std::vector<sf::Uint8>& pixels, sf::Vector2u& size, bool block);
+
+private:
+	void activate();
+	void resize(const sf::Vector2u& size);
+	void discardOldest();
+	bool isOldestReady();
+	void readOldest(sf::Uint8* destination);
+	void release();
+
+	static rbAsyncCaptureClass ourDefinition;
+
+	rbRenderBaseType* myTarget;
+	std::vector<unsigned int> myBuffers;
+	std::vector<void*> myFences;
+	unsigned int myHead;
+	unsigned int myCount;
+	unsigned int myDropped;
+	sf::Vector2u mySize;
+};
+
+namespace rb
+{
+	template<>
+	rbAsyncCapture* Value::to() const;
+	template<>
+	const rbAsyncCapture* Value::to() const;
+}
+
+#endif // RBSFML_RBASYNCCAPTURE_HPP_
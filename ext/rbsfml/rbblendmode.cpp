@@ -37,9 +37,9 @@ rbBlendModeClass rbBlendMode::ourDefinition;
 void rbBlendMode::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbBlendModeClass::defineClassUnder<rb::RubyObjAllocator>("BlendMode", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbBlendMode::initialize);
-	ourDefinition.defineMethod<1>("==", &rbBlendMode::equal);
-	ourDefinition.defineMethod<2>("inspect", &rbBlendMode::inspect);
+	ourDefinition.defineMethod<RBSFML_FN(&rbBlendMode::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbBlendMode::equal)>("==");
+	ourDefinition.defineMethod<RBSFML_FN(&rbBlendMode::inspect)>("inspect");
 
 	ourDefinition.defineAttribute("color_src_factor", true, true);
 	ourDefinition.defineAttribute("color_dst_factor", true, true);
@@ -105,6 +105,16 @@ rb::Value rbBlendMode::initialize(rb::Value self, const std::vector<rb::Value>&
 	return self;
 }
 
+void rbBlendMode::assign(rb::Value self, const sf::BlendMode& mode)
+{
+	self.setVar<symVarColorSrcFactor>(mode.colorSrcFactor);
+	self.setVar<symVarColorDstFactor>(mode.colorDstFactor);
+	self.setVar<symVarColorEquation>(mode.colorEquation);
+	self.setVar<symVarAlphaSrcFactor>(mode.alphaSrcFactor);
+	self.setVar<symVarAlphaDstFactor>(mode.alphaDstFactor);
+	self.setVar<symVarAlphaEquation>(mode.alphaEquation);
+}
+
 bool rbBlendMode::equal(const rb::Value& self, const rb::Value& other)
 {
 	if(!other.isKindOf(rb::Value(ourDefinition)))
@@ -38,6 +38,7 @@ public:
 	static const rbBlendModeClass& getDefinition();
 
 	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+	static void assign(rb::Value self, const sf::BlendMode& mode);
 
 	static bool equal(const rb::Value& self, const rb::Value& other);
 	static std::string inspect(const rb::Value& self);
@@ -29,11 +29,14 @@ rbClockClass rbClock::ourDefinition;
 void rbClock::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbClockClass::defineClassUnder("Clock", sfml);
-	ourDefinition.defineMethod<0>("initialize_copy", &rbClock::initializeCopy);
-	ourDefinition.defineMethod<1>("elapsed_time", &rbClock::getElapsedTime);
-	ourDefinition.defineMethod<2>("restart", &rbClock::restart);
-	ourDefinition.defineMethod<3>("marshal_dump", &rbClock::marshalDump);
-	ourDefinition.defineMethod<4>("inspect", &rbClock::inspect);
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::getElapsedTime)>("elapsed_time");
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::restart)>("restart");
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::getElapsedMicroseconds)>("elapsed_microseconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::getElapsedSeconds)>("elapsed_seconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbClock::restartMicroseconds)>("restart_microseconds");
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 }
@@ -57,7 +60,7 @@ rbClock* rbClock::initializeCopy(const rbClock* value)
 rbTime* rbClock::getElapsedTime() const
 {
 	sf::Time time = myObject.getElapsedTime();
-	rbTime* timeObject = rbTime::ourDefinition.newObject().to<rbTime*>();
+	rbTime* timeObject = rbTime::ourDefinition.allocateObject().to<rbTime*>();
 	timeObject->myObject = time;
 	return timeObject;
 }
@@ -65,11 +68,26 @@ rbTime* rbClock::getElapsedTime() const
 rbTime* rbClock::restart()
 {
 	sf::Time time = myObject.restart();
-	rbTime* timeObject = rbTime::ourDefinition.newObject().to<rbTime*>();
+	rbTime* timeObject = rbTime::ourDefinition.allocateObject().to<rbTime*>();
 	timeObject->myObject = time;
 	return timeObject;
 }
 
+sf::Int64 rbClock::getElapsedMicroseconds() const
+{
+	return myObject.getElapsedTime().asMicroseconds();
+}
+
+float rbClock::getElapsedSeconds() const
+{
+	return myObject.getElapsedTime().asSeconds();
+}
+
+sf::Int64 rbClock::restartMicroseconds()
+{
+	return myObject.restart().asMicroseconds();
+}
+
 rb::Value rbClock::marshalDump() const
 {
 	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str() );
@@ -88,21 +106,13 @@ namespace rb
 template<>
 rbClock* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbClock* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbClock, object);
-	return object;
+	return DataType<rbClock>::fetch(myValue);
 }
 
 template<>
 const rbClock* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbClock* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbClock, object);
-	return object;
+	return DataType<rbClock>::fetch(myValue);
 }
 
 }
\ No newline at end of file
@@ -45,6 +45,10 @@ public:
 	rbTime* getElapsedTime() const;
 	rbTime* restart();
 
+	sf::Int64 getElapsedMicroseconds() const;
+	float getElapsedSeconds() const;
+	sf::Int64 restartMicroseconds();
+
 	rb::Value marshalDump() const;
 	std::string inspect() const;
 
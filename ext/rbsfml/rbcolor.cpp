@@ -21,6 +21,7 @@
 
 #include "rbcolor.hpp"
 #include "error.hpp"
+#include "marshal.hpp"
 #include "macros.hpp"
 #include "base.hpp"
 
@@ -100,17 +101,17 @@ rbColorClass rbColor::ourDefinition;
 void rbColor::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbColorClass::defineClassUnder<rb::RubyObjAllocator>("Color", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbColor::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbColor::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbColor::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbColor::marshalLoad);
-	ourDefinition.defineMethod<4>("to_i", &rbColor::toInteger);
-	ourDefinition.defineMethod<5>("+", &rbColor::add);
-	ourDefinition.defineMethod<6>("-", &rbColor::subtract);
-	ourDefinition.defineMethod<7>("*", &rbColor::multiply);
-	ourDefinition.defineMethod<8>("==", &rbColor::equal);
-	ourDefinition.defineMethod<9>("eql?", &rbColor::strictEqual);
-	ourDefinition.defineMethod<10>("inspect", &rbColor::inspect);
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::binaryDump)>("_dump");
+	ourDefinition.defineSingletonMethod<RBSFML_FN(&rbColor::binaryLoad)>("_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::toInteger)>("to_i");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::add)>("+");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::subtract)>("-");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::multiply)>("*");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::equal)>("==");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::strictEqual)>("eql?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbColor::inspect)>("inspect");
 
 	ourDefinition.defineAttribute("r", true, true);
 	ourDefinition.defineAttribute("g", true, true);
@@ -213,24 +214,55 @@ rb::Value rbColor::initializeCopy(rb::Value self, const rb::Value& value)
 	return self;
 }
 
-std::vector<rb::Value> rbColor::marshalDump(const rb::Value& self)
+// Channels in 0..255 are stored as four bytes. Anything else assigned through
+// the attribute writers falls back to tagged numerics, which are never that short.
+rb::Value rbColor::binaryDump(const rb::Value& self, int)
 {
-	std::vector<rb::Value> array;
-	array.push_back(self.getVar<symVarR, rb::Value>());
-    array.push_back(self.getVar<symVarG, rb::Value>());
-    array.push_back(self.getVar<symVarB, rb::Value>());
-    array.push_back(self.getVar<symVarA, rb::Value>());
-    return array;
+	const rb::Value channels[] = {
+		self.getVar<symVarR, rb::Value>(), self.getVar<symVarG, rb::Value>(),
+		self.getVar<symVarB, rb::Value>(), self.getVar<symVarA, rb::Value>()
+	};
+
+	std::string payload;
+	binary::Writer writer(payload);
+	bool compact = true;
+	for(const rb::Value& channel : channels)
+		compact = compact && channel.getType() == rb::ValueType::Fixnum &&
+		          channel.to<int>() >= 0 && channel.to<int>() <= 255;
+
+	if(compact)
+	{
+		for(const rb::Value& channel : channels)
+			writer.writeUint8(channel.to<sf::Uint8>());
+	}
+	else
+	{
+		marshal::writeNumerics(writer, channels, 4);
+	}
+	return marshal::pack(payload, false);
 }
 
-rb::Value rbColor::marshalLoad(rb::Value self, const rb::Value& data)
+rb::Value rbColor::binaryLoad(rb::Value klass, const rb::Value& data)
 {
-	std::vector<rb::Value> array = data.to<std::vector<rb::Value>>();
-	self.setVar<symVarR>(array[0]);
-    self.setVar<symVarG>(array[1]);
-    self.setVar<symVarB>(array[2]);
-    self.setVar<symVarA>(array[3]);
-	return rb::Nil;
+	std::string payload = marshal::unpack(data, ourDefinition.getName());
+	binary::Reader reader(payload.data(), payload.size());
+	rb::Value channels[4];
+	if(payload.size() == 4)
+	{
+		for(rb::Value& channel : channels)
+			channel = rb::Value::create(reader.readUint8());
+	}
+	else if(!marshal::readNumerics(reader, channels, 4) || !reader.isAtEnd())
+	{
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", ourDefinition.getName().c_str());
+	}
+
+	rb::Value self(rb_obj_alloc(klass.to<VALUE>()));
+	self.setVar<symVarR>(channels[0]);
+	self.setVar<symVarG>(channels[1]);
+	self.setVar<symVarB>(channels[2]);
+	self.setVar<symVarA>(channels[3]);
+	return self;
 }
 
 unsigned int rbColor::toInteger(rb::Value self)
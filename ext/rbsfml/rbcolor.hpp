@@ -37,8 +37,8 @@ public:
 
 	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
 	static rb::Value initializeCopy(rb::Value self, const rb::Value& value);
-	static std::vector<rb::Value> marshalDump(const rb::Value& self);
-	static rb::Value marshalLoad(rb::Value self, const rb::Value& data);
+	static rb::Value binaryDump(const rb::Value& self, int level);
+	static rb::Value binaryLoad(rb::Value klass, const rb::Value& data);
 
 	static unsigned int toInteger(rb::Value self);
 
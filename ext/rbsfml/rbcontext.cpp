@@ -31,8 +31,8 @@ void rbContext::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbContextClass::defineClassUnder("Context", sfml);
 	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
-	ourDefinition.defineMethod<0>("initialize", &rbContext::initialize);
-	ourDefinition.defineMethod<1>("set_active", &rbContext::setActive);
+	ourDefinition.defineMethod<RBSFML_FN(&rbContext::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContext::setActive)>("set_active");
 }
 
 rbContext::rbContext()
@@ -62,21 +62,13 @@ namespace rb
 template<>
 rbContext* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbContext* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbContext, object);
-	return object;
+	return DataType<rbContext>::fetch(myValue);
 }
 
 template<>
 const rbContext* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbContext* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbContext, object);
-	return object;
+	return DataType<rbContext>::fetch(myValue);
 }
 
 }
\ No newline at end of file
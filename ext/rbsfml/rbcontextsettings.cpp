@@ -28,22 +28,22 @@ rbContextSettingsClass rbContextSettings::ourDefinition;
 void rbContextSettings::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbContextSettingsClass::defineClassUnder("ContextSettings", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbContextSettings::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbContextSettings::initializeCopy);
-	ourDefinition.defineMethod<2>("depth_bits=", &rbContextSettings::setDepthBits);
-	ourDefinition.defineMethod<3>("depth_bits", &rbContextSettings::getDepthBits);
-	ourDefinition.defineMethod<4>("stencil_bits=", &rbContextSettings::setStencilBits);
-	ourDefinition.defineMethod<5>("stencil_bits", &rbContextSettings::getStencilBits);
-	ourDefinition.defineMethod<6>("antialiasing_level=", &rbContextSettings::setAntialiasingLevel);
-	ourDefinition.defineMethod<7>("antialiasing_level", &rbContextSettings::getAntialiasingLevel);
-	ourDefinition.defineMethod<8>("major_version=", &rbContextSettings::setMajorVersion);
-	ourDefinition.defineMethod<9>("major_version", &rbContextSettings::getMajorVersion);
-	ourDefinition.defineMethod<10>("minor_version=", &rbContextSettings::setMinorVersion);
-	ourDefinition.defineMethod<11>("minor_version", &rbContextSettings::getMinorVersion);
-	ourDefinition.defineMethod<12>("attribute_flags=", &rbContextSettings::setAttributeFlags);
-	ourDefinition.defineMethod<13>("attribute_flags", &rbContextSettings::getAttributeFlags);
-	ourDefinition.defineMethod<14>("marshal_dump", &rbContextSettings::marshalDump);
-	ourDefinition.defineMethod<15>("inspect", &rbContextSettings::inspect);
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::setDepthBits)>("depth_bits=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::getDepthBits)>("depth_bits");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::setStencilBits)>("stencil_bits=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::getStencilBits)>("stencil_bits");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::setAntialiasingLevel)>("antialiasing_level=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::getAntialiasingLevel)>("antialiasing_level");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::setMajorVersion)>("major_version=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::getMajorVersion)>("major_version");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::setMinorVersion)>("minor_version=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::getMinorVersion)>("minor_version");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::setAttributeFlags)>("attribute_flags=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::getAttributeFlags)>("attribute_flags");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbContextSettings::inspect)>("inspect");
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 
@@ -52,6 +52,23 @@ void rbContextSettings::defineClass(const rb::Value& sfml)
 	ourDefinition.defineConstant("Debug", rb::Value(sf::ContextSettings::Debug));
 }
 
+bool rbContextSettings::refreshFrozen(rb::Value& cache, const sf::ContextSettings& value)
+{
+	if(!cache.isNil())
+	{
+		const sf::ContextSettings& cached = cache.to<const rbContextSettings*>()->myObject;
+		if(cached.depthBits == value.depthBits && cached.stencilBits == value.stencilBits &&
+		   cached.antialiasingLevel == value.antialiasingLevel && cached.majorVersion == value.majorVersion &&
+		   cached.minorVersion == value.minorVersion && cached.attributeFlags == value.attributeFlags)
+			return false;
+	}
+
+	cache = ourDefinition.newObject();
+	cache.to<rbContextSettings*>()->myObject = value;
+	cache.freeze();
+	return true;
+}
+
 rbContextSettings::rbContextSettings()
 : rb::Object()
 , myObject()
@@ -201,21 +218,13 @@ namespace rb
 template<>
 rbContextSettings* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbContextSettings* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbContextSettings, object);
-	return object;
+	return DataType<rbContextSettings>::fetch(myValue);
 }
 
 template<>
 const rbContextSettings* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbContextSettings* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbContextSettings, object);
-	return object;
+	return DataType<rbContextSettings>::fetch(myValue);
 }
 
 }
\ No newline at end of file
@@ -35,6 +35,7 @@ class rbContextSettings : public rb::Object
 {
 public:
 	static void defineClass(const rb::Value& sfml);
+	static bool refreshFrozen(rb::Value& cache, const sf::ContextSettings& value);
 
 	rbContextSettings();
 	~rbContextSettings();
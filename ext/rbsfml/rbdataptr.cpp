@@ -30,8 +30,8 @@ void rbDataPtr::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbDataPtrClass::defineClassUnder("DataPtr", sfml);
 	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
-	ourDefinition.defineMethod<0>("inspect", &rbDataPtr::inspect);
-    ourDefinition.defineMethod<1>("ptr", &rbDataPtr::getPtr);
+	ourDefinition.defineMethod<RBSFML_FN(&rbDataPtr::inspect)>("inspect");
+    ourDefinition.defineMethod<RBSFML_FN(&rbDataPtr::getPtr)>("ptr");
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 }
@@ -72,21 +72,13 @@ namespace rb
 template<>
 rbDataPtr* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbDataPtr* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbDataPtr, object);
-	return object;
+	return DataType<rbDataPtr>::fetch(myValue);
 }
 
 template<>
 const rbDataPtr* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbDataPtr* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbDataPtr, object);
-	return object;
+	return DataType<rbDataPtr>::fetch(myValue);
 }
 
 }
\ No newline at end of file
@@ -30,10 +30,6 @@
 namespace
 {
     constexpr char symVarInternalDrawStack[] = "@@__internal_draw_stack";
-
-    constexpr char symDraw[] = "draw";
-    constexpr char symLast[] = "last";
-    constexpr char symDup[] = "dup";
 }
 
 class rbDrawableBridge;
@@ -81,11 +77,22 @@ rbDrawableBridge::rbDrawableBridge()
 
 void rbDrawableBridge::onDraw(sf::RenderTarget& target, sf::RenderStates states) const
 {
+    static ID symDraw = rb_intern("draw");
+
     rb::Value drawStack = rb::Value(rbRenderTarget::getDefinition()).getVar<symVarInternalDrawStack>();
-    rb::Value self(myValue);
-    rb::Value targetRef = rbRenderTarget::getRefDefinition().newObject();
-    targetRef.to<rbRenderTargetRef*>()->setRef(&target);
-    self.call<symDraw>(targetRef, drawStack.call<symLast>().call<symDup>());
+    rb::Value copy = rb::Nil;
+    if(drawStack.isNil() || drawStack.getArrayLength() == 0)
+    {
+        copy = rbRenderStates::getDefinition().newObject();
+    }
+    else
+    {
+        unsigned int depth = drawStack.getArrayLength() - 1;
+        copy = rbRenderStates::copyForDepth(rb::Value(rb_ary_entry(drawStack.to<VALUE>(), depth)), depth);
+    }
+
+    VALUE args[] = { rbRenderTarget::getRef(target).to<VALUE>(), copy.to<VALUE>() };
+    rb_funcallv(myValue.to<VALUE>(), symDraw, 2, args);
 }
 
 sf::Drawable* rbDrawableBridge::getDrawable()
@@ -107,7 +114,7 @@ void rbDrawable::defineModule(const rb::Value& sfml)
 
 void rbDrawable::defineIncludeFunction()
 {
-    ourDefinition.defineFunction<0>("included", &rbDrawable::included);
+    ourDefinition.defineFunction<RBSFML_FN(&rbDrawable::included)>("included");
 }
 
 rbDrawableModule& rbDrawable::getDefinition()
@@ -119,6 +126,6 @@ void rbDrawable::included(const rb::Value& base)
 {
     if(base.getType() == rb::ValueType::Class)
     {
-        rb::defineAllocator<rb::DefaultAllocator<rbDrawableBridge>>(base);
+        rb::defineAllocator<rb::DefaultAllocator<rbDrawableBridge, rbDrawable>>(base);
     }
 }
@@ -32,6 +32,10 @@ rbDrawableBaseType::rbDrawableBaseType()
 {
 }
 
+bool rbDrawableBaseType::getCullingBounds(sf::FloatRect&) const { return false; }
+std::unique_ptr<sf::Drawable> rbDrawableBaseType::cloneDrawable() const { return nullptr; }
+rb::Value rbDrawableBaseType::getTexture() const { return rb::Nil; }
+
 sf::Drawable* rbDrawableBaseType::getDrawable() { return nullptr; }
 const sf::Drawable* rbDrawableBaseType::getDrawable() const { return nullptr; }
 
@@ -44,21 +48,13 @@ namespace rb
 template<>
 rbDrawableBaseType* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbDrawableBaseType* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbDrawableBaseType, object);
-	return object;
+	return DataType<rbDrawableBaseType>::fetch(myValue);
 }
 
 template<>
 const rbDrawableBaseType* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbDrawableBaseType* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbDrawableBaseType, object);
-	return object;
+	return DataType<rbDrawableBaseType>::fetch(myValue);
 }
 
 template<>
@@ -25,6 +25,9 @@
 #include "class.hpp"
 #include "object.hpp"
 
+#include <SFML/Graphics/Rect.hpp>
+#include <memory>
+
 namespace sf
 {
     class Drawable;
@@ -36,6 +39,19 @@ class rbDrawableBaseType : public rb::Object
 public:
     virtual ~rbDrawableBaseType();
 
+    // Bounds in the space the drawable is drawn in, used by RenderTarget
+    // culling. Returns false when they can't be computed cheaply.
+    virtual bool getCullingBounds(sf::FloatRect& bounds) const;
+
+    // Copy of the native drawable that can be drawn on another thread
+    // without touching Ruby, used by render jobs. Returns null when the
+    // drawable can't be copied.
+    virtual std::unique_ptr<sf::Drawable> cloneDrawable() const;
+
+    // Texture the clone is drawn with, or nil. Render jobs pin it so it
+    // isn't changed under the render thread.
+    virtual rb::Value getTexture() const;
+
 protected:
     friend class rb::Value;
 
@@ -44,8 +44,9 @@ rbTouchEventClass rbTouchEvent::ourTouchDefinition;
 void rbEvent::defineClass(const rb::Value& sfml)
 {
 	ourEventDefinition = rbEventClass::defineClassUnder("Event", sfml);
-	ourEventDefinition.defineMethod<0>("initialize", &rbEvent::initialize);
-	ourEventDefinition.defineMethod<1>("type", &rbEvent::getType);
+	ourEventDefinition.defineMethod<RBSFML_FN(&rbEvent::initialize)>("initialize");
+	ourEventDefinition.defineMethod<RBSFML_FN(&rbEvent::getType)>("type");
+	ourEventDefinition.defineMethod<RBSFML_FN(&rbEvent::setType)>("type=");
 
   	ourEventDefinition.defineConstant("Closed", rb::Value(sf::Event::Closed));
   	ourEventDefinition.defineConstant("Resized", rb::Value(sf::Event::Resized));
@@ -161,13 +162,20 @@ int rbEvent::getType() const
 	return myObject.type;
 }
 
+void rbEvent::setType(int type)
+{
+	if(type < 0 || type >= sf::Event::Count)
+		rb::raise(rb::ArgumentError, "unknown event type %d", type);
+	myObject.type = static_cast<sf::Event::EventType>(type);
+}
+
 void rbJoystickButtonEvent::defineClass(const rb::Value& sfml)
 {
 	ourJoystickButtonDefinition = rbJoystickButtonEventClass::defineClassUnder("JoystickButtonEvent", sfml, rb::Value(ourEventDefinition));
-	ourJoystickButtonDefinition.defineMethod<0>("joystickId", &rbJoystickButtonEvent::getJoystickId);
-	ourJoystickButtonDefinition.defineMethod<1>("joystickId=", &rbJoystickButtonEvent::setJoystickId);
-	ourJoystickButtonDefinition.defineMethod<2>("button", &rbJoystickButtonEvent::getButton);
-	ourJoystickButtonDefinition.defineMethod<3>("button=", &rbJoystickButtonEvent::setButton);
+	ourJoystickButtonDefinition.defineMethod<RBSFML_FN(&rbJoystickButtonEvent::getJoystickId)>("joystickId");
+	ourJoystickButtonDefinition.defineMethod<RBSFML_FN(&rbJoystickButtonEvent::setJoystickId)>("joystickId=");
+	ourJoystickButtonDefinition.defineMethod<RBSFML_FN(&rbJoystickButtonEvent::getButton)>("button");
+	ourJoystickButtonDefinition.defineMethod<RBSFML_FN(&rbJoystickButtonEvent::setButton)>("button=");
 }
 
 unsigned int rbJoystickButtonEvent::getJoystickId() const
@@ -193,8 +201,8 @@ void rbJoystickButtonEvent::setButton(unsigned int value)
 void rbJoystickConnectEvent::defineClass(const rb::Value& sfml)
 {
 	ourJoystickConnectDefinition = rbJoystickConnectEventClass::defineClassUnder("JoystickConnectEvent", sfml, rb::Value(ourEventDefinition));
-	ourJoystickConnectDefinition.defineMethod<0>("joystickId", &rbJoystickConnectEvent::getJoystickId);
-	ourJoystickConnectDefinition.defineMethod<1>("joystickId=", &rbJoystickConnectEvent::setJoystickId);
+	ourJoystickConnectDefinition.defineMethod<RBSFML_FN(&rbJoystickConnectEvent::getJoystickId)>("joystickId");
+	ourJoystickConnectDefinition.defineMethod<RBSFML_FN(&rbJoystickConnectEvent::setJoystickId)>("joystickId=");
 }
 
 unsigned int rbJoystickConnectEvent::getJoystickId() const
@@ -210,12 +218,12 @@ void rbJoystickConnectEvent::setJoystickId(unsigned int value)
 void rbJoystickMoveEvent::defineClass(const rb::Value& sfml)
 {
 	ourJoystickMoveDefinition = rbJoystickMoveEventClass::defineClassUnder("JoystickMoveEvent", sfml, rb::Value(ourEventDefinition));
-	ourJoystickMoveDefinition.defineMethod<0>("joystickId", &rbJoystickMoveEvent::getJoystickId);
-	ourJoystickMoveDefinition.defineMethod<1>("joystickId=", &rbJoystickMoveEvent::setJoystickId);
-	ourJoystickMoveDefinition.defineMethod<2>("axis", &rbJoystickMoveEvent::getAxis);
-	ourJoystickMoveDefinition.defineMethod<3>("axis=", &rbJoystickMoveEvent::setAxis);
-	ourJoystickMoveDefinition.defineMethod<4>("position", &rbJoystickMoveEvent::getPosition);
-	ourJoystickMoveDefinition.defineMethod<5>("position=", &rbJoystickMoveEvent::setPosition);
+	ourJoystickMoveDefinition.defineMethod<RBSFML_FN(&rbJoystickMoveEvent::getJoystickId)>("joystickId");
+	ourJoystickMoveDefinition.defineMethod<RBSFML_FN(&rbJoystickMoveEvent::setJoystickId)>("joystickId=");
+	ourJoystickMoveDefinition.defineMethod<RBSFML_FN(&rbJoystickMoveEvent::getAxis)>("axis");
+	ourJoystickMoveDefinition.defineMethod<RBSFML_FN(&rbJoystickMoveEvent::setAxis)>("axis=");
+	ourJoystickMoveDefinition.defineMethod<RBSFML_FN(&rbJoystickMoveEvent::getPosition)>("position");
+	ourJoystickMoveDefinition.defineMethod<RBSFML_FN(&rbJoystickMoveEvent::setPosition)>("position=");
 }
 
 unsigned int rbJoystickMoveEvent::getJoystickId() const
@@ -251,16 +259,16 @@ void rbJoystickMoveEvent::setPosition(float value)
 void rbKeyEvent::defineClass(const rb::Value& sfml)
 {
 	ourKeyDefinition = rbKeyEventClass::defineClassUnder("KeyEvent", sfml, rb::Value(ourEventDefinition));
-	ourKeyDefinition.defineMethod<0>("code", &rbKeyEvent::getCode );
-	ourKeyDefinition.defineMethod<1>("code=", &rbKeyEvent::setCode );
-	ourKeyDefinition.defineMethod<2>("alt", &rbKeyEvent::getAlt );
-	ourKeyDefinition.defineMethod<3>("alt=", &rbKeyEvent::setAlt );
-	ourKeyDefinition.defineMethod<4>("control", &rbKeyEvent::getControl );
-	ourKeyDefinition.defineMethod<5>("control=", &rbKeyEvent::setControl );
-	ourKeyDefinition.defineMethod<6>("shift", &rbKeyEvent::getShift );
-	ourKeyDefinition.defineMethod<7>("shift=", &rbKeyEvent::setShift );
-	ourKeyDefinition.defineMethod<8>("system", &rbKeyEvent::getSystem );
-	ourKeyDefinition.defineMethod<9>("system=", &rbKeyEvent::setSystem );
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::getCode)>("code");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::setCode)>("code=");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::getAlt)>("alt");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::setAlt)>("alt=");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::getControl)>("control");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::setControl)>("control=");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::getShift)>("shift");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::setShift)>("shift=");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::getSystem)>("system");
+	ourKeyDefinition.defineMethod<RBSFML_FN(&rbKeyEvent::setSystem)>("system=");
 }
 
 unsigned int rbKeyEvent::getCode() const
@@ -281,12 +289,12 @@ ACCESSOR_IMPL(System, bool, rbKeyEvent, myObject.key.system);
 void rbMouseButtonEvent::defineClass(const rb::Value& sfml)
 {
 	ourMouseButtonDefinition = rbMouseButtonEventClass::defineClassUnder("MouseButtonEvent", sfml, rb::Value(ourEventDefinition));
-	ourMouseButtonDefinition.defineMethod<0>("button", &rbMouseButtonEvent::getButton );
-	ourMouseButtonDefinition.defineMethod<1>("button=", &rbMouseButtonEvent::setButton );
-	ourMouseButtonDefinition.defineMethod<2>("x", &rbMouseButtonEvent::getX );
-	ourMouseButtonDefinition.defineMethod<3>("x=", &rbMouseButtonEvent::setX );
-	ourMouseButtonDefinition.defineMethod<4>("y", &rbMouseButtonEvent::getY );
-	ourMouseButtonDefinition.defineMethod<5>("y=", &rbMouseButtonEvent::setY );
+	ourMouseButtonDefinition.defineMethod<RBSFML_FN(&rbMouseButtonEvent::getButton)>("button");
+	ourMouseButtonDefinition.defineMethod<RBSFML_FN(&rbMouseButtonEvent::setButton)>("button=");
+	ourMouseButtonDefinition.defineMethod<RBSFML_FN(&rbMouseButtonEvent::getX)>("x");
+	ourMouseButtonDefinition.defineMethod<RBSFML_FN(&rbMouseButtonEvent::setX)>("x=");
+	ourMouseButtonDefinition.defineMethod<RBSFML_FN(&rbMouseButtonEvent::getY)>("y");
+	ourMouseButtonDefinition.defineMethod<RBSFML_FN(&rbMouseButtonEvent::setY)>("y=");
 }
 
 unsigned int rbMouseButtonEvent::getButton() const
@@ -305,10 +313,10 @@ ACCESSOR_IMPL(Y, int, rbMouseButtonEvent, myObject.mouseButton.y);
 void rbMouseMoveEvent::defineClass(const rb::Value& sfml)
 {
 	ourMouseMoveDefinition = rbMouseMoveEventClass::defineClassUnder("MouseMoveEvent", sfml, rb::Value(ourEventDefinition));
-	ourMouseMoveDefinition.defineMethod<0>("x", &rbMouseMoveEvent::getX );
-	ourMouseMoveDefinition.defineMethod<1>("x=", &rbMouseMoveEvent::setX );
-	ourMouseMoveDefinition.defineMethod<2>("y", &rbMouseMoveEvent::getY );
-	ourMouseMoveDefinition.defineMethod<3>("y=", &rbMouseMoveEvent::setY );
+	ourMouseMoveDefinition.defineMethod<RBSFML_FN(&rbMouseMoveEvent::getX)>("x");
+	ourMouseMoveDefinition.defineMethod<RBSFML_FN(&rbMouseMoveEvent::setX)>("x=");
+	ourMouseMoveDefinition.defineMethod<RBSFML_FN(&rbMouseMoveEvent::getY)>("y");
+	ourMouseMoveDefinition.defineMethod<RBSFML_FN(&rbMouseMoveEvent::setY)>("y=");
 }
 
 ACCESSOR_IMPL(X, int, rbMouseMoveEvent, myObject.mouseMove.x);
@@ -317,12 +325,12 @@ ACCESSOR_IMPL(Y, int, rbMouseMoveEvent, myObject.mouseMove.y);
 void rbMouseWheelEvent::defineClass(const rb::Value& sfml)
 {
 	ourMouseWheelDefinition = rbMouseWheelEventClass::defineClassUnder("MouseWheelEvent", sfml, rb::Value(ourEventDefinition));
-	ourMouseWheelDefinition.defineMethod<0>("delta", &rbMouseWheelEvent::getDelta );
-	ourMouseWheelDefinition.defineMethod<1>("delta=", &rbMouseWheelEvent::setDelta );
-	ourMouseWheelDefinition.defineMethod<2>("x", &rbMouseWheelEvent::getX );
-	ourMouseWheelDefinition.defineMethod<3>("x=", &rbMouseWheelEvent::setX );
-	ourMouseWheelDefinition.defineMethod<4>("y", &rbMouseWheelEvent::getY );
-	ourMouseWheelDefinition.defineMethod<5>("y=", &rbMouseWheelEvent::setY );
+	ourMouseWheelDefinition.defineMethod<RBSFML_FN(&rbMouseWheelEvent::getDelta)>("delta");
+	ourMouseWheelDefinition.defineMethod<RBSFML_FN(&rbMouseWheelEvent::setDelta)>("delta=");
+	ourMouseWheelDefinition.defineMethod<RBSFML_FN(&rbMouseWheelEvent::getX)>("x");
+	ourMouseWheelDefinition.defineMethod<RBSFML_FN(&rbMouseWheelEvent::setX)>("x=");
+	ourMouseWheelDefinition.defineMethod<RBSFML_FN(&rbMouseWheelEvent::getY)>("y");
+	ourMouseWheelDefinition.defineMethod<RBSFML_FN(&rbMouseWheelEvent::setY)>("y=");
 }
 
 ACCESSOR_IMPL(Delta, int, rbMouseWheelEvent, myObject.mouseWheel.delta);
@@ -332,14 +340,14 @@ ACCESSOR_IMPL(Y, int, rbMouseWheelEvent, myObject.mouseWheel.y);
 void rbMouseWheelScrollEvent::defineClass(const rb::Value& sfml)
 {
 	ourMouseWheelScrollDefinition = rbMouseWheelScrollEventClass::defineClassUnder("MouseWheelScrollEvent", sfml, rb::Value(ourEventDefinition));
-	ourMouseWheelScrollDefinition.defineMethod<0>("wheel", &rbMouseWheelScrollEvent::getWheel );
-	ourMouseWheelScrollDefinition.defineMethod<1>("wheel=", &rbMouseWheelScrollEvent::setWheel );
-	ourMouseWheelScrollDefinition.defineMethod<2>("delta", &rbMouseWheelScrollEvent::getDelta );
-	ourMouseWheelScrollDefinition.defineMethod<3>("delta=", &rbMouseWheelScrollEvent::setDelta );
-	ourMouseWheelScrollDefinition.defineMethod<4>("x", &rbMouseWheelScrollEvent::getX );
-	ourMouseWheelScrollDefinition.defineMethod<5>("x=", &rbMouseWheelScrollEvent::setX );
-	ourMouseWheelScrollDefinition.defineMethod<6>("y", &rbMouseWheelScrollEvent::getY );
-	ourMouseWheelScrollDefinition.defineMethod<7>("y=", &rbMouseWheelScrollEvent::setY );
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::getWheel)>("wheel");
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::setWheel)>("wheel=");
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::getDelta)>("delta");
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::setDelta)>("delta=");
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::getX)>("x");
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::setX)>("x=");
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::getY)>("y");
+	ourMouseWheelScrollDefinition.defineMethod<RBSFML_FN(&rbMouseWheelScrollEvent::setY)>("y=");
 }
 
 unsigned int rbMouseWheelScrollEvent::getWheel() const
@@ -359,14 +367,14 @@ ACCESSOR_IMPL(Y, int, rbMouseWheelScrollEvent, myObject.mouseWheelScroll.y);
 void rbSensorEvent::defineClass(const rb::Value& sfml)
 {
 	ourSensorDefinition = rbSensorEventClass::defineClassUnder("SensorEvent", sfml, rb::Value(ourEventDefinition));
-	ourSensorDefinition.defineMethod<0>("sensor_type", &rbSensorEvent::getSensorType );
-	ourSensorDefinition.defineMethod<1>("sensor_type=", &rbSensorEvent::setSensorType );
-	ourSensorDefinition.defineMethod<2>("x", &rbSensorEvent::getX );
-	ourSensorDefinition.defineMethod<3>("x=", &rbSensorEvent::setX );
-	ourSensorDefinition.defineMethod<4>("y", &rbSensorEvent::getY );
-	ourSensorDefinition.defineMethod<5>("y=", &rbSensorEvent::setY );
-	ourSensorDefinition.defineMethod<6>("z", &rbSensorEvent::getZ );
-	ourSensorDefinition.defineMethod<7>("z=", &rbSensorEvent::setZ );
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::getSensorType)>("sensor_type");
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::setSensorType)>("sensor_type=");
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::getX)>("x");
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::setX)>("x=");
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::getY)>("y");
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::setY)>("y=");
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::getZ)>("z");
+	ourSensorDefinition.defineMethod<RBSFML_FN(&rbSensorEvent::setZ)>("z=");
 }
 
 unsigned int rbSensorEvent::getSensorType() const
@@ -386,10 +394,10 @@ ACCESSOR_IMPL(Z, int, rbSensorEvent, myObject.sensor.z);
 void rbSizeEvent::defineClass(const rb::Value& sfml)
 {
 	ourSizeDefinition = rbSizeEventClass::defineClassUnder("SizeEvent", sfml, rb::Value(ourEventDefinition));
-	ourSizeDefinition.defineMethod<0>("width", &rbSizeEvent::getWidth);
-	ourSizeDefinition.defineMethod<1>("width=", &rbSizeEvent::setWidth);
-	ourSizeDefinition.defineMethod<2>("height", &rbSizeEvent::getHeight);
-	ourSizeDefinition.defineMethod<3>("height=", &rbSizeEvent::setHeight);
+	ourSizeDefinition.defineMethod<RBSFML_FN(&rbSizeEvent::getWidth)>("width");
+	ourSizeDefinition.defineMethod<RBSFML_FN(&rbSizeEvent::setWidth)>("width=");
+	ourSizeDefinition.defineMethod<RBSFML_FN(&rbSizeEvent::getHeight)>("height");
+	ourSizeDefinition.defineMethod<RBSFML_FN(&rbSizeEvent::setHeight)>("height=");
 }
 
 int rbSizeEvent::getWidth() const
@@ -415,8 +423,8 @@ void rbSizeEvent::setHeight(int value)
 void rbTextEvent::defineClass(const rb::Value& sfml)
 {
 	ourTextDefinition = rbTextEventClass::defineClassUnder("TextEvent", sfml, rb::Value(ourEventDefinition));
-	ourTextDefinition.defineMethod<0>("unicode", &rbTextEvent::getUnicode);
-	ourTextDefinition.defineMethod<1>("unicode=", &rbTextEvent::setUnicode);
+	ourTextDefinition.defineMethod<RBSFML_FN(&rbTextEvent::getUnicode)>("unicode");
+	ourTextDefinition.defineMethod<RBSFML_FN(&rbTextEvent::setUnicode)>("unicode=");
 }
 
 ACCESSOR_IMPL(Unicode, sf::Uint32, rbTextEvent, myObject.text.unicode);
@@ -424,12 +432,12 @@ ACCESSOR_IMPL(Unicode, sf::Uint32, rbTextEvent, myObject.text.unicode);
 void rbTouchEvent::defineClass(const rb::Value& sfml)
 {
 	ourTouchDefinition = rbTouchEventClass::defineClassUnder("TouchEvent", sfml, rb::Value(ourEventDefinition));
-	ourTouchDefinition.defineMethod<0>("finger", &rbTouchEvent::getFinger);
-	ourTouchDefinition.defineMethod<1>("finger=", &rbTouchEvent::setFinger);
-	ourTouchDefinition.defineMethod<2>("x", &rbTouchEvent::getX);
-	ourTouchDefinition.defineMethod<3>("x=", &rbTouchEvent::setX);
-	ourTouchDefinition.defineMethod<4>("y", &rbTouchEvent::getY);
-	ourTouchDefinition.defineMethod<5>("y=", &rbTouchEvent::setY);
+	ourTouchDefinition.defineMethod<RBSFML_FN(&rbTouchEvent::getFinger)>("finger");
+	ourTouchDefinition.defineMethod<RBSFML_FN(&rbTouchEvent::setFinger)>("finger=");
+	ourTouchDefinition.defineMethod<RBSFML_FN(&rbTouchEvent::getX)>("x");
+	ourTouchDefinition.defineMethod<RBSFML_FN(&rbTouchEvent::setX)>("x=");
+	ourTouchDefinition.defineMethod<RBSFML_FN(&rbTouchEvent::getY)>("y");
+	ourTouchDefinition.defineMethod<RBSFML_FN(&rbTouchEvent::setY)>("y=");
 }
 
 ACCESSOR_IMPL(Finger, unsigned int, rbTouchEvent, myObject.touch.finger);
@@ -442,21 +450,13 @@ namespace rb
 template<>
 rbEvent* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbEvent* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbEvent, object);
-	return object;
+	return DataType<rbEvent>::fetch(myValue);
 }
 
 template<>
 const rbEvent* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbEvent* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbEvent, object);
-	return object;
+	return DataType<rbEvent>::fetch(myValue);
 }
 
 }
\ No newline at end of file
@@ -66,8 +66,11 @@ public:
 	void initialize();
 
 	int getType() const;
+	void setType(int type);
 
 protected:
+	friend class rbEventLog;
+
 	static rbEventClass ourEventDefinition;
 
 	sf::Event myObject;
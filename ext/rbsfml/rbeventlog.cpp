@@ -0,0 +1,398 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbeventlog.hpp"
+#include "rbevent.hpp"
+#include "binary.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+	// Magic and version, followed by one record per event: the time since the
+	// previous event as a varint, the event type and a type specific payload.
+	constexpr char LogMagic[] = "RBEV";
+	constexpr sf::Uint8 LogVersion = 1;
+
+	void writeEvent(binary::Writer& writer, const sf::Event& event)
+	{
+		writer.writeUint8(static_cast<sf::Uint8>(event.type));
+		switch(event.type)
+		{
+			case sf::Event::Resized:
+				writer.writeUint32(event.size.width);
+				writer.writeUint32(event.size.height);
+				break;
+			case sf::Event::TextEntered:
+				writer.writeUint32(event.text.unicode);
+				break;
+			case sf::Event::KeyPressed:
+			case sf::Event::KeyReleased:
+				writer.writeInt32(event.key.code);
+				writer.writeUint8((event.key.alt ? 1 : 0) | (event.key.control ? 2 : 0) |
+				                  (event.key.shift ? 4 : 0) | (event.key.system ? 8 : 0));
+				break;
+			case sf::Event::MouseWheelMoved:
+				writer.writeInt32(event.mouseWheel.delta);
+				writer.writeInt32(event.mouseWheel.x);
+				writer.writeInt32(event.mouseWheel.y);
+				break;
+			case sf::Event::MouseWheelScrolled:
+				writer.writeUint8(static_cast<sf::Uint8>(event.mouseWheelScroll.wheel));
+				writer.writeFloat(event.mouseWheelScroll.delta);
+				writer.writeInt32(event.mouseWheelScroll.x);
+				writer.writeInt32(event.mouseWheelScroll.y);
+				break;
+			case sf::Event::MouseButtonPressed:
+			case sf::Event::MouseButtonReleased:
+				writer.writeUint8(static_cast<sf::Uint8>(event.mouseButton.button));
+				writer.writeInt32(event.mouseButton.x);
+				writer.writeInt32(event.mouseButton.y);
+				break;
+			case sf::Event::MouseMoved:
+				writer.writeInt32(event.mouseMove.x);
+				writer.writeInt32(event.mouseMove.y);
+				break;
+			case sf::Event::JoystickButtonPressed:
+			case sf::Event::JoystickButtonReleased:
+				writer.writeUint32(event.joystickButton.joystickId);
+				writer.writeUint32(event.joystickButton.button);
+				break;
+			case sf::Event::JoystickMoved:
+				writer.writeUint32(event.joystickMove.joystickId);
+				writer.writeUint8(static_cast<sf::Uint8>(event.joystickMove.axis));
+				writer.writeFloat(event.joystickMove.position);
+				break;
+			case sf::Event::JoystickConnected:
+			case sf::Event::JoystickDisconnected:
+				writer.writeUint32(event.joystickConnect.joystickId);
+				break;
+			case sf::Event::TouchBegan:
+			case sf::Event::TouchMoved:
+			case sf::Event::TouchEnded:
+				writer.writeUint32(event.touch.finger);
+				writer.writeInt32(event.touch.x);
+				writer.writeInt32(event.touch.y);
+				break;
+			case sf::Event::SensorChanged:
+				writer.writeUint8(static_cast<sf::Uint8>(event.sensor.type));
+				writer.writeFloat(event.sensor.x);
+				writer.writeFloat(event.sensor.y);
+				writer.writeFloat(event.sensor.z);
+				break;
+			default:
+				break;
+		}
+	}
+
+	bool readEvent(binary::Reader& reader, sf::Event& event)
+	{
+		sf::Uint8 type = reader.readUint8();
+		if(type >= sf::Event::Count)
+			return false;
+
+		event = sf::Event();
+		event.type = static_cast<sf::Event::EventType>(type);
+		switch(event.type)
+		{
+			case sf::Event::Resized:
+				event.size.width = reader.readUint32();
+				event.size.height = reader.readUint32();
+				break;
+			case sf::Event::TextEntered:
+				event.text.unicode = reader.readUint32();
+				break;
+			case sf::Event::KeyPressed:
+			case sf::Event::KeyReleased:
+			{
+				event.key.code = static_cast<sf::Keyboard::Key>(reader.readInt32());
+				sf::Uint8 modifiers = reader.readUint8();
+				event.key.alt = (modifiers & 1) != 0;
+				event.key.control = (modifiers & 2) != 0;
+				event.key.shift = (modifiers & 4) != 0;
+				event.key.system = (modifiers & 8) != 0;
+				break;
+			}
+			case sf::Event::MouseWheelMoved:
+				event.mouseWheel.delta = reader.readInt32();
+				event.mouseWheel.x = reader.readInt32();
+				event.mouseWheel.y = reader.readInt32();
+				break;
+			case sf::Event::MouseWheelScrolled:
+				event.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>(reader.readUint8());
+				event.mouseWheelScroll.delta = reader.readFloat();
+				event.mouseWheelScroll.x = reader.readInt32();
+				event.mouseWheelScroll.y = reader.readInt32();
+				break;
+			case sf::Event::MouseButtonPressed:
+			case sf::Event::MouseButtonReleased:
+				event.mouseButton.button = static_cast<sf::Mouse::Button>(reader.readUint8());
+				event.mouseButton.x = reader.readInt32();
+				event.mouseButton.y = reader.readInt32();
+				break;
+			case sf::Event::MouseMoved:
+				event.mouseMove.x = reader.readInt32();
+				event.mouseMove.y = reader.readInt32();
+				break;
+			case sf::Event::JoystickButtonPressed:
+			case sf::Event::JoystickButtonReleased:
+				event.joystickButton.joystickId = reader.readUint32();
+				event.joystickButton.button = reader.readUint32();
+				break;
+			case sf::Event::JoystickMoved:
+				event.joystickMove.joystickId = reader.readUint32();
+				event.joystickMove.axis = static_cast<sf::Joystick::Axis>(reader.readUint8());
+				event.joystickMove.position = reader.readFloat();
+				break;
+			case sf::Event::JoystickConnected:
+			case sf::Event::JoystickDisconnected:
+				event.joystickConnect.joystickId = reader.readUint32();
+				break;
+			case sf::Event::TouchBegan:
+			case sf::Event::TouchMoved:
+			case sf::Event::TouchEnded:
+				event.touch.finger = reader.readUint32();
+				event.touch.x = reader.readInt32();
+				event.touch.y = reader.readInt32();
+				break;
+			case sf::Event::SensorChanged:
+				event.sensor.type = static_cast<sf::Sensor::Type>(reader.readUint8());
+				event.sensor.x = reader.readFloat();
+				event.sensor.y = reader.readFloat();
+				event.sensor.z = reader.readFloat();
+				break;
+			default:
+				break;
+		}
+		return !reader.isFailed();
+	}
+}
+
+rbEventLogClass rbEventLog::ourDefinition;
+
+void rbEventLog::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbEventLogClass::defineClassUnder("EventLog", sfml);
+	ourDefinition.defineFunction<RBSFML_FN(&rbEventLog::load)>("load");
+	ourDefinition.defineFunction<RBSFML_FN(&rbEventLog::parse)>("parse");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::add)>("add");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::clear)>("clear");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::save)>("save");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::dump)>("dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::getSize)>("size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::getDuration)>("duration");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::marshalLoad)>("marshal_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbEventLog::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+	ourDefinition.aliasMethod("size", "length");
+}
+
+rbEventLogClass& rbEventLog::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbEventLog::rbEventLog()
+: rb::Object()
+, myEntries()
+, myClock()
+, myOffset(0)
+{
+}
+
+rbEventLog::~rbEventLog()
+{
+}
+
+rb::Value rbEventLog::load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if(!file)
+		rb::raise(rb::RuntimeError, "failed to open '%s' for reading", path.c_str());
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	rb::Value object = ourDefinition.newObject();
+	if(!object.to<rbEventLog*>()->decode(data))
+		rb::raise(rb::ArgumentError, "'%s' is not a valid event log", path.c_str());
+	return object;
+}
+
+rb::Value rbEventLog::parse(const rb::Value& data)
+{
+	rb::Value object = ourDefinition.newObject();
+	object.to<rbEventLog*>()->marshalLoad(data);
+	return object;
+}
+
+rbEventLog* rbEventLog::initializeCopy(const rbEventLog* value)
+{
+	myEntries = value->myEntries;
+	myOffset = value->myOffset;
+	return this;
+}
+
+rbEventLog* rbEventLog::add(const rb::Value& event, sf::Int64 time)
+{
+	if(time < getDuration())
+		rb::raise(rb::ArgumentError, "events must be added in order, %lld is before %lld",
+		          static_cast<long long>(time), static_cast<long long>(getDuration()));
+
+	Entry entry;
+	entry.time = time;
+	entry.event = event.to<const rbEvent*>()->myObject;
+	myEntries.push_back(entry);
+	return this;
+}
+
+void rbEventLog::clear()
+{
+	myEntries.clear();
+	myOffset = 0;
+}
+
+void rbEventLog::save(const std::string& path) const
+{
+	std::string data = encode();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if(!file.write(data.data(), data.size()))
+		rb::raise(rb::RuntimeError, "failed to write event log to '%s'", path.c_str());
+}
+
+rb::Value rbEventLog::dump() const
+{
+	std::string data = encode();
+	return rb::Value(rb_str_new(data.data(), data.size()));
+}
+
+unsigned int rbEventLog::getSize() const
+{
+	return myEntries.size();
+}
+
+sf::Int64 rbEventLog::getDuration() const
+{
+	return myEntries.empty() ? 0 : myEntries.back().time;
+}
+
+rb::Value rbEventLog::marshalDump() const
+{
+	return dump();
+}
+
+void rbEventLog::marshalLoad(const rb::Value& data)
+{
+	if(!decode(data.to<const std::string&>()))
+		rb::raise(rb::ArgumentError, "not a valid event log");
+}
+
+std::string rbEventLog::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myEntries.size()) + ", " + macro::toString(getDuration()) + "us)";
+}
+
+// Recording continues the timeline after whatever the log already holds.
+void rbEventLog::beginRecording()
+{
+	myOffset = getDuration();
+	myClock.restart();
+}
+
+void rbEventLog::record(const sf::Event& event)
+{
+	Entry entry;
+	entry.time = myOffset + myClock.getElapsedTime().asMicroseconds();
+	entry.event = event;
+	myEntries.push_back(entry);
+}
+
+std::size_t rbEventLog::getEntryCount() const
+{
+	return myEntries.size();
+}
+
+const rbEventLog::Entry& rbEventLog::getEntry(std::size_t index) const
+{
+	return myEntries[index];
+}
+
+std::string rbEventLog::encode() const
+{
+	std::string data;
+	binary::Writer writer(data);
+	writer.writeBytes(LogMagic, 4);
+	writer.writeUint8(LogVersion);
+
+	sf::Int64 previous = 0;
+	for(const Entry& entry : myEntries)
+	{
+		writer.writeVarUint(static_cast<sf::Uint64>(entry.time - previous));
+		writeEvent(writer, entry.event);
+		previous = entry.time;
+	}
+	return data;
+}
+
+bool rbEventLog::decode(const std::string& data)
+{
+	binary::Reader reader(data.data(), data.size());
+	char magic[4];
+	if(!reader.readBytes(magic, 4) || std::string(magic, 4) != LogMagic || reader.readUint8() != LogVersion)
+		return false;
+
+	std::vector<Entry> entries;
+	sf::Int64 time = 0;
+	while(!reader.isAtEnd())
+	{
+		Entry entry;
+		time += static_cast<sf::Int64>(reader.readVarUint());
+		entry.time = time;
+		if(!readEvent(reader, entry.event))
+			return false;
+		entries.push_back(entry);
+	}
+
+	myEntries.swap(entries);
+	myOffset = 0;
+	return true;
+}
+
+namespace rb
+{
+
+template<>
+rbEventLog* Value::to() const
+{
+	return DataType<rbEventLog>::fetch(myValue);
+}
+
+template<>
+const rbEventLog* Value::to() const
+{
+	return DataType<rbEventLog>::fetch(myValue);
+}
+
+}
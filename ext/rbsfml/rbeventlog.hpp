@@ -0,0 +1,93 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBEVENTLOG_HPP_
+#define RBSFML_RBEVENTLOG_HPP_
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/Window/Event.hpp>
+#include <string>
+#include <vector>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbEventLog;
+
+typedef rb::Class<rbEventLog> rbEventLogClass;
+
+// Timestamped sf::Event stream, recorded from and replayed into a Window.
+class rbEventLog : public rb::Object
+{
+public:
+	struct Entry
+	{
+		sf::Int64 time;
+		sf::Event event;
+	};
+
+	static void defineClass(const rb::Value& sfml);
+	static rbEventLogClass& getDefinition();
+
+	rbEventLog();
+	~rbEventLog();
+
+	static rb::Value load(const std::string& path);
+	static rb::Value parse(const rb::Value& data);
+	rbEventLog* initializeCopy(const rbEventLog* value);
+
+	rbEventLog* add(const rb::Value& event, sf::Int64 time);
+	void clear();
+	void save(const std::string& path) const;
+	rb::Value dump() const;
+
+	unsigned int getSize() const;
+	sf::Int64 getDuration() const;
+
+	rb::Value marshalDump() const;
+	void marshalLoad(const rb::Value& data);
+	std::string inspect() const;
+
+	void beginRecording();
+	void record(const sf::Event& event);
+
+	std::size_t getEntryCount() const;
+	const Entry& getEntry(std::size_t index) const;
+
+private:
+	std::string encode() const;
+	bool decode(const std::string& data);
+
+	static rbEventLogClass ourDefinition;
+
+	std::vector<Entry> myEntries;
+	sf::Clock myClock;
+	sf::Int64 myOffset;
+};
+
+namespace rb
+{
+	template<>
+	rbEventLog* Value::to() const;
+	template<>
+	const rbEventLog* Value::to() const;
+}
+
+#endif // RBSFML_RBEVENTLOG_HPP_
@@ -0,0 +1,219 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbfixedstep.hpp"
+#include "rbtime.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+
+namespace
+{
+	sf::Int64 toMicroseconds(const rb::Value& value)
+	{
+		switch(value.getType())
+		{
+			case rb::ValueType::Fixnum:
+				return value.to<sf::Int64>();
+			case rb::ValueType::Float:
+				return static_cast<sf::Int64>(value.to<double>() * 1000000.0);
+			case rb::ValueType::Data:
+				return value.to<const rbTime*>()->asMicroseconds();
+			default:
+				rb::expectedTypes("Fixnum", "Float", "Time");
+				return 0;
+		}
+	}
+}
+
+rbFixedStepClass rbFixedStep::ourDefinition;
+
+void rbFixedStep::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbFixedStepClass::defineClassUnder("FixedStep", sfml);
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::advance)>("advance");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::update)>("update");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::reset)>("reset");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::getAlpha)>("alpha");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::getStep)>("step");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::getStepMicroseconds)>("step_microseconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::getAccumulatedMicroseconds)>("accumulated_microseconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::setMaxSteps)>("max_steps=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::getMaxSteps)>("max_steps");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::getDroppedMicroseconds)>("dropped_microseconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFixedStep::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbFixedStepClass& rbFixedStep::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbFixedStep::rbFixedStep()
+: rb::Object()
+, myClock()
+, myStep(1000000 / 60)
+, myAccumulator(0)
+, myDropped(0)
+, myMaxSteps(8)
+{
+}
+
+rbFixedStep::~rbFixedStep()
+{
+}
+
+rb::Value rbFixedStep::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	rbFixedStep* object = self.to<rbFixedStep*>();
+	switch( args.size() )
+	{
+		case 2:
+			object->setMaxSteps(args[1].to<unsigned int>());
+		case 1:
+			object->myStep = toMicroseconds(args[0]);
+			if(object->myStep <= 0)
+				rb::raise(rb::ArgumentError, "step must be positive");
+		case 0:
+			break;
+		default:
+			rb::expectedNumArgs( args.size(), 0, 2 );
+			break;
+	}
+
+	return self;
+}
+
+rbFixedStep* rbFixedStep::initializeCopy(const rbFixedStep* value)
+{
+	myClock = value->myClock;
+	myStep = value->myStep;
+	myAccumulator = value->myAccumulator;
+	myDropped = value->myDropped;
+	myMaxSteps = value->myMaxSteps;
+	return this;
+}
+
+unsigned int rbFixedStep::advance(const rb::Value& elapsed)
+{
+	return advanceMicroseconds(toMicroseconds(elapsed));
+}
+
+unsigned int rbFixedStep::update()
+{
+	return advanceMicroseconds(myClock.restart().asMicroseconds());
+}
+
+void rbFixedStep::reset()
+{
+	myClock.restart();
+	myAccumulator = 0;
+	myDropped = 0;
+}
+
+float rbFixedStep::getAlpha() const
+{
+	return static_cast<float>(static_cast<double>(myAccumulator) / myStep);
+}
+
+rbTime* rbFixedStep::getStep() const
+{
+	return rbTime::microseconds(myStep);
+}
+
+sf::Int64 rbFixedStep::getStepMicroseconds() const
+{
+	return myStep;
+}
+
+sf::Int64 rbFixedStep::getAccumulatedMicroseconds() const
+{
+	return myAccumulator;
+}
+
+void rbFixedStep::setMaxSteps(unsigned int steps)
+{
+	if(steps == 0)
+		rb::raise(rb::ArgumentError, "max steps must be at least 1");
+	myMaxSteps = steps;
+}
+
+unsigned int rbFixedStep::getMaxSteps() const
+{
+	return myMaxSteps;
+}
+
+sf::Int64 rbFixedStep::getDroppedMicroseconds() const
+{
+	return myDropped;
+}
+
+rb::Value rbFixedStep::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbFixedStep::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(getStepSeconds()) + ", " + macro::toString(getAlpha()) + ")";
+}
+
+unsigned int rbFixedStep::advanceMicroseconds(sf::Int64 elapsed)
+{
+	if(elapsed > 0)
+		myAccumulator += elapsed;
+
+	sf::Int64 steps = myAccumulator / myStep;
+	myAccumulator -= steps * myStep;
+	if(steps > myMaxSteps)
+	{
+		myDropped += (steps - myMaxSteps) * myStep;
+		steps = myMaxSteps;
+	}
+	return static_cast<unsigned int>(steps);
+}
+
+float rbFixedStep::getStepSeconds() const
+{
+	return static_cast<float>(myStep / 1000000.0);
+}
+
+namespace rb
+{
+
+template<>
+rbFixedStep* Value::to() const
+{
+	return DataType<rbFixedStep>::fetch(myValue);
+}
+
+template<>
+const rbFixedStep* Value::to() const
+{
+	return DataType<rbFixedStep>::fetch(myValue);
+}
+
+}
@@ -0,0 +1,84 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBFIXEDSTEP_HPP_
+#define RBSFML_RBFIXEDSTEP_HPP_
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbFixedStep;
+class rbTime;
+
+typedef rb::Class<rbFixedStep> rbFixedStepClass;
+
+class rbFixedStep : public rb::Object
+{
+public:
+	static void defineClass(const rb::Value& sfml);
+	static rbFixedStepClass& getDefinition();
+
+	rbFixedStep();
+	~rbFixedStep();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+	rbFixedStep* initializeCopy(const rbFixedStep* value);
+
+	unsigned int advance(const rb::Value& elapsed);
+	unsigned int update();
+	void reset();
+
+	float getAlpha() const;
+	rbTime* getStep() const;
+	sf::Int64 getStepMicroseconds() const;
+	sf::Int64 getAccumulatedMicroseconds() const;
+	void setMaxSteps(unsigned int steps);
+	unsigned int getMaxSteps() const;
+	sf::Int64 getDroppedMicroseconds() const;
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+	unsigned int advanceMicroseconds(sf::Int64 elapsed);
+	float getStepSeconds() const;
+
+private:
+	static rbFixedStepClass ourDefinition;
+
+	sf::Clock myClock;
+	sf::Int64 myStep;
+	sf::Int64 myAccumulator;
+	sf::Int64 myDropped;
+	unsigned int myMaxSteps;
+};
+
+namespace rb
+{
+	template<>
+	rbFixedStep* Value::to() const;
+	template<>
+	const rbFixedStep* Value::to() const;
+}
+
+#endif // RBSFML_RBFIXEDSTEP_HPP_
@@ -75,25 +75,25 @@ namespace
 void rbFont::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbFontClass::defineClassUnder("Font", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbFont::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbFont::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbFont::marshalDump);
-    ourDefinition.defineMethod<3>("load_from_file", &rbFont::loadFromFile);
-    ourDefinition.defineMethod<4>("load_from_memory", &rbFont::loadFromMemory);
-    ourDefinition.defineMethod<5>("info", &rbFont::getInfo);
-    ourDefinition.defineMethod<6>("get_glyph", &rbFont::getGlyph);
-    ourDefinition.defineMethod<7>("get_kerning", &rbFont::getKerning);
-    ourDefinition.defineMethod<8>("get_line_spacing", &rbFont::getLineSpacing);
-    ourDefinition.defineMethod<9>("get_underline_position", &rbFont::getUnderlinePosition);
-    ourDefinition.defineMethod<10>("get_underline_thickness", &rbFont::getUnderlineThickness);
-    ourDefinition.defineMethod<11>("get_texture", &rbFont::getTexture);
+	ourDefinition.defineMethod<RBSFML_FN(&rbFont::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFont::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFont::marshalDump)>("marshal_dump");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::loadFromFile)>("load_from_file");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::loadFromMemory)>("load_from_memory");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::getInfo)>("info");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::getGlyph)>("get_glyph");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::getKerning)>("get_kerning");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::getLineSpacing)>("get_line_spacing");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::getUnderlinePosition)>("get_underline_position");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::getUnderlineThickness)>("get_underline_thickness");
+    ourDefinition.defineMethod<RBSFML_FN(&rbFont::getTexture)>("get_texture");
 
     ourInfoDefinition = rbFontInfoClass::defineClassUnder<rb::RubyObjAllocator>("Info", rb::Value(ourDefinition));
-    ourInfoDefinition.defineMethod<0>("initialize", rbFontInfo_initialize);
+    ourInfoDefinition.defineMethod<RBSFML_FN(&rbFontInfo_initialize)>("initialize");
     ourInfoDefinition.defineAttribute("family", true, true);
 
     ourGlyphDefinition = rbGlyphClass::defineClassUnder<rb::RubyObjAllocator>("Glyph", sfml);
-    ourGlyphDefinition.defineMethod<0>("initialize", rbGlyph_initialize);
+    ourGlyphDefinition.defineMethod<RBSFML_FN(&rbGlyph_initialize)>("initialize");
     ourGlyphDefinition.defineAttribute("advance", true, true);
     ourGlyphDefinition.defineAttribute("bounds", true, true);
     ourGlyphDefinition.defineAttribute("texture_rect", true, true);
@@ -219,21 +219,13 @@ namespace rb
 template<>
 rbFont* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbFont* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbFont, object);
-	return object;
+	return DataType<rbFont>::fetch(myValue);
 }
 
 template<>
 const rbFont* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbFont* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbFont, object);
-	return object;
+	return DataType<rbFont>::fetch(myValue);
 }
 
 template<>
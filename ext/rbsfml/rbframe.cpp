@@ -0,0 +1,161 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbframe.hpp"
+#include "rbfixedstep.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+
+namespace
+{
+	constexpr char symVarFixedStep[] = "@__internal__fixed_step";
+}
+
+rbFrameClass rbFrame::ourDefinition;
+
+void rbFrame::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbFrameClass::defineClassUnder("Frame", sfml);
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::getIndex)>("index");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::getDelta)>("dt");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::getDeltaMicroseconds)>("dt_microseconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::getElapsed)>("elapsed");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::getFixedSteps)>("fixed_steps");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::getAlpha)>("alpha");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::getFixedStep)>("fixed_step");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::stop)>("stop");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::isStopped)>("stopped?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrame::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbFrameClass& rbFrame::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbFrame::rbFrame()
+: rb::Object()
+, myIndex(0)
+, myDelta(0)
+, myElapsed(0)
+, myFixedSteps(0)
+, myFixedStep(nullptr)
+, myIsStopped(false)
+{
+}
+
+rbFrame::~rbFrame()
+{
+}
+
+sf::Int64 rbFrame::getIndex() const
+{
+	return myIndex;
+}
+
+float rbFrame::getDelta() const
+{
+	return static_cast<float>(myDelta / 1000000.0);
+}
+
+sf::Int64 rbFrame::getDeltaMicroseconds() const
+{
+	return myDelta;
+}
+
+float rbFrame::getElapsed() const
+{
+	return static_cast<float>(myElapsed / 1000000.0);
+}
+
+unsigned int rbFrame::getFixedSteps() const
+{
+	return myFixedSteps;
+}
+
+float rbFrame::getAlpha() const
+{
+	return myFixedStep != nullptr ? myFixedStep->getAlpha() : 0.0f;
+}
+
+rb::Value rbFrame::getFixedStep() const
+{
+	return myValue.getVar<symVarFixedStep>();
+}
+
+void rbFrame::stop()
+{
+	myIsStopped = true;
+}
+
+bool rbFrame::isStopped() const
+{
+	return myIsStopped;
+}
+
+rb::Value rbFrame::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbFrame::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myIndex) + ", " + macro::toString(getDelta()) + ")";
+}
+
+void rbFrame::setFixedStep(const rb::Value& fixedStep)
+{
+	myValue.setVar<symVarFixedStep>(fixedStep);
+	myFixedStep = fixedStep.isNil() ? nullptr : fixedStep.to<rbFixedStep*>();
+}
+
+void rbFrame::begin(sf::Int64 delta)
+{
+	myDelta = delta;
+	myElapsed += delta;
+	myFixedSteps = myFixedStep != nullptr ? myFixedStep->advanceMicroseconds(delta) : 0;
+}
+
+void rbFrame::end()
+{
+	myIndex++;
+}
+
+namespace rb
+{
+
+template<>
+rbFrame* Value::to() const
+{
+	return DataType<rbFrame>::fetch(myValue);
+}
+
+template<>
+const rbFrame* Value::to() const
+{
+	return DataType<rbFrame>::fetch(myValue);
+}
+
+}
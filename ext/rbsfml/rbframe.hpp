@@ -0,0 +1,81 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBFRAME_HPP_
+#define RBSFML_RBFRAME_HPP_
+
+#include <SFML/System/Time.hpp>
+#include <string>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbFrame;
+class rbFixedStep;
+
+typedef rb::Class<rbFrame> rbFrameClass;
+
+class rbFrame : public rb::Object
+{
+public:
+	static void defineClass(const rb::Value& sfml);
+	static rbFrameClass& getDefinition();
+
+	rbFrame();
+	~rbFrame();
+
+	sf::Int64 getIndex() const;
+	float getDelta() const;
+	sf::Int64 getDeltaMicroseconds() const;
+	float getElapsed() const;
+	unsigned int getFixedSteps() const;
+	float getAlpha() const;
+	rb::Value getFixedStep() const;
+
+	void stop();
+	bool isStopped() const;
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+	void setFixedStep(const rb::Value& fixedStep);
+	void begin(sf::Int64 delta);
+	void end();
+
+private:
+	static rbFrameClass ourDefinition;
+
+	sf::Int64 myIndex;
+	sf::Int64 myDelta;
+	sf::Int64 myElapsed;
+	unsigned int myFixedSteps;
+	rbFixedStep* myFixedStep;
+	bool myIsStopped;
+};
+
+namespace rb
+{
+	template<>
+	rbFrame* Value::to() const;
+	template<>
+	const rbFrame* Value::to() const;
+}
+
+#endif // RBSFML_RBFRAME_HPP_
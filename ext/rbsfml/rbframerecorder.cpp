@@ -0,0 +1,438 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbframerecorder.hpp"
+#include "rbasynccapture.hpp"
+#include "rbimage.hpp"
+#include "rbnoncopyable.hpp"
+#include "imagekernels.hpp"
+#include "base.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace
+{
+	constexpr char symVarCapture[] = "@__internal__capture";
+	constexpr char symFormat[] = "format";
+	constexpr char symFps[] = "fps";
+	constexpr char symQueue[] = "queue";
+	constexpr char symPolicy[] = "policy";
+
+	bool endsWith(const std::string& string, const std::string& suffix)
+	{
+		return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+	}
+}
+
+rbFrameRecorderClass rbFrameRecorder::ourDefinition;
+
+void rbFrameRecorder::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbFrameRecorderClass::defineClassUnder("FrameRecorder", sfml);
+	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::record)>("record");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::addImage)>("add_image");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::close)>("close");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::isClosed)>("closed?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::getFramesWritten)>("frames_written");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::getFramesDropped)>("frames_dropped");
+	ourDefinition.defineMethod<RBSFML_FN(&rbFrameRecorder::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("add_image", "<<");
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbFrameRecorderClass& rbFrameRecorder::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbFrameRecorder::rbFrameRecorder()
+: rb::Object()
+, myCapture(nullptr)
+, myFormat(Format::Y4M)
+, myPolicy(Policy::Drop)
+, myFramerate(60)
+, myCapacity(4)
+, myPath()
+, myPathPrefix()
+, myPathSuffix()
+, myPathDigits(0)
+, myFile(nullptr)
+, myFrameSize(0, 0)
+, myPlanes()
+, myFramesWritten(0)
+, myFramesDropped(0)
+, myIsFailed(false)
+, myThread()
+, myMutex()
+, myNotEmpty()
+, myNotFull()
+, myQueue()
+, myPool()
+, myIsStopping(false)
+, myIsWorking(false)
+, myIsClosed(true)
+{
+}
+
+rbFrameRecorder::~rbFrameRecorder()
+{
+	stop();
+}
+
+rb::Value rbFrameRecorder::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	rbFrameRecorder* object = self.to<rbFrameRecorder*>();
+	if(!object->myIsClosed)
+		rb::raise(rb::RuntimeError, "%s is already recording", ourDefinition.getName().c_str());
+
+	rb::Value options = rb::Nil;
+	switch(args.size())
+	{
+		case 3:
+			options = args[2];
+			if(options.getType() != rb::ValueType::Hash)
+				rb::expectedTypes("Hash");
+		case 2:
+			object->myPath = args[1].to<std::string>();
+			if(!args[0].isNil())
+			{
+				rb::Value capture = rbAsyncCapture::getDefinition().newObject(args[0]);
+				self.setVar<symVarCapture>(capture);
+				object->myCapture = capture.to<rbAsyncCapture*>();
+			}
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 2, 3);
+			break;
+	}
+	std::string format;
+	if(!options.isNil())
+	{
+		if(!options.getHashEntry<symFormat>().isNil())
+			format = macro::toName(options.getHashEntry<symFormat>());
+		if(!options.getHashEntry<symFps>().isNil())
+			object->myFramerate = std::max(options.getHashEntry<symFps, unsigned int>(), 1u);
+		if(!options.getHashEntry<symQueue>().isNil())
+			object->myCapacity = std::max(options.getHashEntry<symQueue, unsigned int>(), 1u);
+		if(!options.getHashEntry<symPolicy>().isNil())
+		{
+			std::string policy = macro::toName(options.getHashEntry<symPolicy>());
+			if(policy == "drop")
+				object->myPolicy = Policy::Drop;
+			else if(policy == "block")
+				object->myPolicy = Policy::Block;
+			else
+				rb::raise(rb::ArgumentError, "unknown policy '%s', expected drop or block", policy.c_str());
+		}
+	}
+
+	const std::string& path = object->myPath;
+	if(format.empty())
+		format = path.find('%') != std::string::npos ? "ppm" : (endsWith(path, ".rgba") || endsWith(path, ".raw")) ? "rgba" : "y4m";
+	if(format == "y4m")
+		object->myFormat = Format::Y4M;
+	else if(format == "rgba")
+		object->myFormat = Format::RGBA;
+	else if(format == "ppm")
+		object->myFormat = Format::PPM;
+	else
+		rb::raise(rb::ArgumentError, "unknown format '%s', expected y4m, rgba or ppm", format.c_str());
+
+	if(object->myFormat == Format::PPM)
+	{
+		std::size_t percent = path.find('%');
+		std::size_t end = percent == std::string::npos ? percent : percent + 1;
+		while(end != std::string::npos && end < path.size() && std::isdigit(path[end]))
+			end++;
+		if(end == std::string::npos || end >= path.size() || path[end] != 'd' || path.find('%', end) != std::string::npos)
+			rb::raise(rb::ArgumentError, "expected a single %%d in the frame path '%s'", path.c_str());
+		object->myPathPrefix = path.substr(0, percent);
+		object->myPathSuffix = path.substr(end + 1);
+		object->myPathDigits = std::atoi(path.substr(percent + 1, end - percent - 1).c_str());
+	}
+	else
+	{
+		object->myFile = std::fopen(path.c_str(), "wb");
+		if(object->myFile == nullptr)
+			rb::raise(rb::RuntimeError, "failed to open '%s' for writing", path.c_str());
+	}
+
+	object->myIsClosed = false;
+	object->myIsStopping = false;
+	object->myIsWorking = true;
+	object->myThread = std::thread(&rbFrameRecorder::work, object);
+	return self;
+}
+
+void rbFrameRecorder::record()
+{
+	checkOpen();
+	if(myCapture == nullptr)
+		rb::raise(rb::RuntimeError, "%s has no render target, use add_image instead", ourDefinition.getName().c_str());
+
+	myCapture->capture();
+	collect(false);
+}
+
+rbFrameRecorder* rbFrameRecorder::addImage(const rb::Value& image)
+{
+	checkOpen();
+	const sf::Image& source = image.to<const sf::Image&>();
+	std::unique_ptr<Frame> frame = acquireFrame();
+	frame->size = source.getSize();
+	frame->pixels.assign(source.getPixelsPtr(), source.getPixelsPtr() + frame->size.x * frame->size.y * 4);
+	submit(std::move(frame));
+	return this;
+}
+
+unsigned int rbFrameRecorder::close()
+{
+	if(myIsClosed)
+		return myFramesWritten;
+
+	if(myCapture != nullptr)
+		collect(true);
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		myIsStopping = true;
+	}
+	myNotEmpty.notify_all();
+	// Draining can take a while, so wait for it interruptibly before joining.
+	rb::waitWithoutGVL(myMutex, myNotFull, [this]() { return !myIsWorking; });
+	stop();
+	if(myIsFailed)
+		rb::raise(rb::RuntimeError, "failed to write frames to '%s'", myPath.c_str());
+	return myFramesWritten;
+}
+
+bool rbFrameRecorder::isClosed() const
+{
+	return myIsClosed;
+}
+
+unsigned int rbFrameRecorder::getFramesWritten() const
+{
+	return myFramesWritten;
+}
+
+unsigned int rbFrameRecorder::getFramesDropped() const
+{
+	return myFramesDropped;
+}
+
+std::string rbFrameRecorder::inspect() const
+{
+	return ourDefinition.getName() + "(" + myPath + ", " + macro::toString(myFramesWritten.load()) + ")";
+}
+
+void rbFrameRecorder::checkOpen() const
+{
+	if(myIsClosed)
+		rb::raise(rb::RuntimeError, "%s is closed", ourDefinition.getName().c_str());
+}
+
+std::unique_ptr<rbFrameRecorder::Frame> rbFrameRecorder::acquireFrame()
+{
+	std::lock_guard<std::mutex> lock(myMutex);
+	if(myPool.empty())
+		return std::unique_ptr<Frame>(new Frame());
+	std::unique_ptr<Frame> frame = std::move(myPool.back());
+	myPool.pop_back();
+	return frame;
+}
+
+// Frames are recycled through a pool, so at most queue + 2 frame buffers
+// are ever alive no matter how far the writer falls behind.
+void rbFrameRecorder::submit(std::unique_ptr<Frame> frame)
+{
+	std::unique_lock<std::mutex> lock(myMutex);
+	while(myQueue.size() >= myCapacity)
+	{
+		if(myPolicy == Policy::Drop)
+		{
+			myFramesDropped++;
+			myPool.push_back(std::move(frame));
+			return;
+		}
+		lock.unlock();
+		rb::waitWithoutGVL(myMutex, myNotFull, [this]() { return myQueue.size() < myCapacity; });
+		lock.lock();
+	}
+	myQueue.push_back(std::move(frame));
+	myNotEmpty.notify_one();
+}
+
+void rbFrameRecorder::collect(bool block)
+{
+	for(;;)
+	{
+		std::unique_ptr<Frame> frame = acquireFrame();
+		if(!myCapture->readFrame(frame->pixels, frame->size, block))
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			myPool.push_back(std::move(frame));
+			return;
+		}
+		submit(std::move(frame));
+	}
+}
+
+void rbFrameRecorder::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		myIsStopping = true;
+	}
+	myNotEmpty.notify_all();
+	if(myThread.joinable())
+		myThread.join();
+	if(myFile != nullptr)
+	{
+		if(std::fclose(myFile) != 0)
+			myIsFailed = true;
+		myFile = nullptr;
+	}
+	myIsClosed = true;
+}
+
+void rbFrameRecorder::work()
+{
+	for(;;)
+	{
+		std::unique_ptr<Frame> frame;
+		{
+			std::unique_lock<std::mutex> lock(myMutex);
+			myNotEmpty.wait(lock, [this]() { return myIsStopping || !myQueue.empty(); });
+			if(myQueue.empty())
+			{
+				myIsWorking = false;
+				myNotFull.notify_all();
+				return;
+			}
+			frame = std::move(myQueue.front());
+			myQueue.pop_front();
+		}
+
+		bool written = write(*frame);
+
+		std::lock_guard<std::mutex> lock(myMutex);
+		if(written)
+			myFramesWritten++;
+		else
+			myFramesDropped++;
+		myPool.push_back(std::move(frame));
+		myNotFull.notify_one();
+	}
+}
+
+bool rbFrameRecorder::write(const Frame& frame)
+{
+	if(myIsFailed || frame.size.x == 0 || frame.size.y == 0)
+		return false;
+
+	if(myFormat != Format::PPM)
+	{
+		if(myFrameSize.x == 0)
+			myFrameSize = frame.size;
+		else if(frame.size != myFrameSize)
+			return false;
+	}
+
+	bool success = false;
+	switch(myFormat)
+	{
+		case Format::Y4M:  success = writeY4M(frame);  break;
+		case Format::RGBA: success = writeRGBA(frame); break;
+		case Format::PPM:  success = writePPM(frame);  break;
+	}
+	if(!success)
+		myIsFailed = true;
+	return success;
+}
+
+bool rbFrameRecorder::writeY4M(const Frame& frame)
+{
+	unsigned int width = frame.size.x;
+	unsigned int height = frame.size.y;
+	std::size_t lumaSize = width * height;
+	std::size_t chromaSize = ((width + 1) / 2) * ((height + 1) / 2);
+	if(myPlanes.empty())
+	{
+		if(std::fprintf(myFile, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", width, height, myFramerate) < 0)
+			return false;
+		myPlanes.resize(lumaSize + chromaSize * 2);
+	}
+
+	kernel::convertToYUV420(frame.pixels.data(), width, height, &myPlanes[0], &myPlanes[lumaSize], &myPlanes[lumaSize + chromaSize]);
+	return std::fputs("FRAME\n", myFile) >= 0 && std::fwrite(myPlanes.data(), 1, myPlanes.size(), myFile) == myPlanes.size();
+}
+
+bool rbFrameRecorder::writeRGBA(const Frame& frame)
+{
+	return std::fwrite(frame.pixels.data(), 1, frame.pixels.size(), myFile) == frame.pixels.size();
+}
+
+bool rbFrameRecorder::writePPM(const Frame& frame)
+{
+	std::string number = macro::toString(myFramesWritten.load());
+	if(static_cast<int>(number.size()) < myPathDigits)
+		number.insert(0, myPathDigits - number.size(), '0');
+	std::string filename = myPathPrefix + number + myPathSuffix;
+
+	std::FILE* file = std::fopen(filename.c_str(), "wb");
+	if(file == nullptr)
+		return false;
+
+	std::size_t count = frame.size.x * frame.size.y;
+	myPlanes.resize(count * 3);
+	for(std::size_t index = 0; index < count; index++)
+	{
+		myPlanes[index * 3 + 0] = frame.pixels[index * 4 + 0];
+		myPlanes[index * 3 + 1] = frame.pixels[index * 4 + 1];
+		myPlanes[index * 3 + 2] = frame.pixels[index * 4 + 2];
+	}
+	bool success = std::fprintf(file, "P6\n%u %u\n255\n", frame.size.x, frame.size.y) >= 0 &&
+	               std::fwrite(myPlanes.data(), 1, myPlanes.size(), file) == myPlanes.size();
+	return std::fclose(file) == 0 && success;
+}
+
+namespace rb
+{
+
+template<>
+rbFrameRecorder* Value::to() const
+{
+	return DataType<rbFrameRecorder>::fetch(myValue);
+}
+
+template<>
+const rbFrameRecorder* Value::to() const
+{
+	return DataType<rbFrameRecorder>::fetch(myValue);
+}
+
+}
@@ -0,0 +1,134 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBFRAMERECORDER_HPP_
+#define RBSFML_RBFRAMERECORDER_HPP_
+
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbFrameRecorder;
+class rbAsyncCapture;
+
+typedef rb::Class<rbFrameRecorder> rbFrameRecorderClass;
+
+class rbFrameRecorder : public rb::Object
+{
+public:
+	enum class Format
+	{
+		Y4M,
+		RGBA,
+		PPM
+	};
+
+	enum class Policy
+	{
+		Drop,
+		Block
+	};
+
+	static void defineClass(const rb::Value& sfml);
+	static rbFrameRecorderClass& getDefinition();
+
+	rbFrameRecorder();
+	~rbFrameRecorder();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+
+	void record();
+	rbFrameRecorder* addImage(const rb::Value& image);
+	unsigned int close();
+
+	bool isClosed() const;
+	unsigned int getFramesWritten() const;
+	unsigned int getFramesDropped() const;
+
+	std::string inspect() const;
+
+private:
+	struct Frame
+	{
+		std::vector<sf::Uint8> pixels;
+		sf::Vector2u size;
+	};
+
+	void checkOpen() const;
+	std::unique_ptr<Frame> acquireFrame();
+	void submit(std::unique_ptr<Frame> frame);
+	void collect(bool block);
+	void stop();
+
+	void work();
+	bool write(const Frame& frame);
+	bool writeY4M(const Frame& frame);
+	bool writeRGBA(const Frame& frame);
+	bool writePPM(const Frame& frame);
+
+	static rbFrameRecorderClass ourDefinition;
+
+	rbAsyncCapture* myCapture;
+	Format myFormat;
+	Policy myPolicy;
+	unsigned int myFramerate;
+	unsigned int myCapacity;
+	std::string myPath;
+	std::string myPathPrefix;
+	std::string myPathSuffix;
+	int myPathDigits;
+
+	std::FILE* myFile;
+	sf::Vector2u myFrameSize;
+	std::vector<sf::Uint8> myPlanes;
+	std::atomic<unsigned int> myFramesWritten;
+	std::atomic<unsigned int> myFramesDropped;
+	std::atomic<bool> myIsFailed;
+
+	std::thread myThread;
+	std::mutex myMutex;
+	std::condition_variable myNotEmpty;
+	std::condition_variable myNotFull;
+	std::deque<std::unique_ptr<Frame>> myQueue;
+	std::vector<std::unique_ptr<Frame>> myPool;
+	bool myIsStopping;
+	bool myIsWorking;
+	bool myIsClosed;
+};
+
+namespace rb
+{
+	template<>
+	rbFrameRecorder* Value::to() const;
+	template<>
+	const rbFrameRecorder* Value::to() const;
+}
+
+#endif // RBSFML_RBFRAMERECORDER_HPP_
@@ -24,32 +24,116 @@
 #include "rbrect.hpp"
 #include "rbcolor.hpp"
 #include "error.hpp"
+#include "marshal.hpp"
 #include "macros.hpp"
+#include "base.hpp"
+#include "imagekernels.hpp"
+#include "imageencoder.hpp"
+#include "rbimagesaverequest.hpp"
+#include "simd.hpp"
+#include "threadpool.hpp"
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+	const std::size_t KernelThreadThreshold = 256 * 256;
+
+	constexpr char symFilter[] = "filter";
+	constexpr char symFormat[] = "format";
+	constexpr char symBlock[] = "block";
+
+	// Kernels run with the image pinned, raising on return would leak the pin.
+	template<typename Function>
+	void runKernel(std::size_t count, Function function)
+	{
+		if(count >= KernelThreadThreshold)
+			rb::callWithoutGVLDeferringInterrupts(function);
+		else
+			function();
+	}
+
+	int channelIndex(char channel)
+	{
+		switch(channel)
+		{
+			case 'r': case 'R': return 0;
+			case 'g': case 'G': return 1;
+			case 'b': case 'B': return 2;
+			case 'a': case 'A': return 3;
+		}
+		rb::raise(rb::ArgumentError, "invalid channel '%c', expected one of r, g, b or a", channel);
+		return 0;
+	}
+
+	encoder::Format toFormat(const std::string& name)
+	{
+		encoder::Format format = encoder::Format::Png;
+		if(!encoder::getFormat(name, format))
+			rb::raise(rb::ArgumentError, "unsupported image format '%s', expected png, bmp or tga", name.c_str());
+		return format;
+	}
+
+	kernel::Filter toFilter(const rb::Value& value)
+	{
+		std::string name = macro::toName(value);
+		if(name == "box")
+			return kernel::Filter::Box;
+		else if(name == "bilinear")
+			return kernel::Filter::Bilinear;
+		else if(name == "lanczos")
+			return kernel::Filter::Lanczos;
+		rb::raise(rb::ArgumentError, "unknown filter '%s', expected box, bilinear or lanczos", name.c_str());
+		return kernel::Filter::Bilinear;
+	}
+
+	sf::IntRect clipRect(const sf::IntRect& rect, const sf::Vector2u& size)
+	{
+		int left = std::max(rect.left, 0);
+		int top = std::max(rect.top, 0);
+		int right = std::min(rect.left + rect.width, static_cast<int>(size.x));
+		int bottom = std::min(rect.top + rect.height, static_cast<int>(size.y));
+		return sf::IntRect(left, top, std::max(right - left, 0), std::max(bottom - top, 0));
+	}
+}
 
 rbImageClass rbImage::ourDefinition;
 
 void rbImage::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbImageClass::defineClassUnder("Image", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbImage::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbImage::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbImage::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbImage::marshalLoad);
-	ourDefinition.defineMethod<4>("inspect", &rbImage::inspect);
-	ourDefinition.defineMethod<5>("create_from_color", &rbImage::createFromColor);
-	ourDefinition.defineMethod<6>("create_from_data", &rbImage::createFromData);
-    ourDefinition.defineMethod<7>("load_from_file", &rbImage::loadFromFile);
-    ourDefinition.defineMethod<8>("load_from_memory", &rbImage::loadFromMemory);
-    ourDefinition.defineMethod<9>("save_to_file", &rbImage::saveToFile);
-    ourDefinition.defineMethod<10>("size", &rbImage::getSize);
-    ourDefinition.defineMethod<11>("create_mask_from_color", &rbImage::createMaskFromColor);
-    ourDefinition.defineMethod<12>("copy", &rbImage::copy);
-    ourDefinition.defineMethod<13>("set_pixel", &rbImage::setPixel);
-    ourDefinition.defineMethod<14>("get_pixel", &rbImage::getPixel);
-    ourDefinition.defineMethod<15>("pixels", &rbImage::getPixel);
-    ourDefinition.defineMethod<16>("flip_horizontally", &rbImage::flipHorizontally);
-    ourDefinition.defineMethod<17>("flip_vertically", &rbImage::flipVertically);
-
+	ourDefinition.defineMethod<RBSFML_FN(&rbImage::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImage::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImage::binaryDump)>("_dump");
+	ourDefinition.defineSingletonMethod<RBSFML_FN(&rbImage::binaryLoad)>("_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImage::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImage::createFromColor)>("create_from_color");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImage::createFromData)>("create_from_data");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::loadFromFile)>("load_from_file");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::loadFromMemory)>("load_from_memory");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::saveToFile)>("save_to_file");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::getSize)>("size");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::createMaskFromColor)>("create_mask_from_color");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::copy)>("copy");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::setPixel)>("set_pixel");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::getPixel)>("get_pixel");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::getPixel)>("pixels");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::flipHorizontally)>("flip_horizontally");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::flipVertically)>("flip_vertically");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::premultiplyAlpha)>("premultiply_alpha");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::unpremultiplyAlpha)>("unpremultiply_alpha");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::tint)>("tint");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::grayscale)>("grayscale");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::swizzle)>("swizzle");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::blit)>("blit");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::fillRect)>("fill_rect");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::resize)>("resize");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::saveToMemory)>("save_to_memory");
+    ourDefinition.defineMethod<RBSFML_FN(&rbImage::saveAsync)>("save_async");
+    ourDefinition.defineFunction<RBSFML_FN(&rbImage::getSaveQueueCapacity)>("save_queue_capacity");
+    ourDefinition.defineFunction<RBSFML_FN(&rbImage::setSaveQueueCapacity)>("save_queue_capacity=");
+
+    ourDefinition.defineConstant("SIMD", rb::Value(std::string(simd::getInstructionSet())));
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 }
@@ -62,6 +146,8 @@ rbImageClass& rbImage::getDefinition()
 rbImage::rbImage()
 : rb::Object()
 , myObject()
+, myPinCount(0)
+, myIsWriting(false)
 {
 }
 
@@ -95,33 +181,39 @@ rb::Value rbImage::initialize(rb::Value self, const std::vector<rb::Value>& args
 
 rbImage* rbImage::initializeCopy(const rbImage* value)
 {
+	checkIdle();
 	myObject = value->myObject;
 	return this;
 }
 
-rb::Value rbImage::marshalDump() const
+// The size followed by the raw RGBA pixels, deflated when that pays off.
+rb::Value rbImage::binaryDump(int) const
 {
-    std::vector<rb::Value> data;
-    const sf::Vector2u& imgSize = myObject.getSize();
-    data.push_back(rb::Value::create(imgSize));
-    const sf::Uint8* rawData = myObject.getPixelsPtr();
-    for(int index = 0, size = imgSize.x * imgSize.y; index < size; index++)
-    {
-        data.push_back(rb::Value::create(rawData[index]));
-    }
-	return rb::Value::create(data);
+	sf::Vector2u size = myObject.getSize();
+	std::size_t byteCount = static_cast<std::size_t>(size.x) * size.y * 4;
+	std::string payload;
+	payload.reserve(8 + byteCount);
+	binary::Writer writer(payload);
+	writer.writeUint32(size.x);
+	writer.writeUint32(size.y);
+	if(byteCount > 0)
+		writer.writeBytes(myObject.getPixelsPtr(), byteCount);
+	return marshal::pack(payload, true);
 }
 
-void rbImage::marshalLoad(const std::vector<rb::Value>& data)
+rb::Value rbImage::binaryLoad(rb::Value klass, const rb::Value& data)
 {
-    sf::Vector2u imgSize = data[0].to<sf::Vector2u>();
-    sf::Uint8* rawData = new sf::Uint8[data.size()-1];
-    for(int index = 0, size = data.size()-1; index < size; index++)
-    {
-        rawData[index] = data[index+1].to<sf::Uint8>();
-    }
-    myObject.create(imgSize.x, imgSize.y, rawData);
-    delete[] rawData;
+	std::string payload = marshal::unpack(data, ourDefinition.getName());
+	binary::Reader reader(payload.data(), payload.size());
+	sf::Uint32 width = reader.readUint32();
+	sf::Uint32 height = reader.readUint32();
+	if(reader.isFailed() || reader.getRemaining() != static_cast<std::size_t>(width) * height * 4)
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", ourDefinition.getName().c_str());
+
+	rb::Value object(rb_obj_alloc(klass.to<VALUE>()));
+	if(width > 0 && height > 0)
+		object.to<rbImage*>()->myObject.create(width, height, reinterpret_cast<const sf::Uint8*>(payload.data() + 8));
+	return object;
 }
 
 std::string rbImage::inspect() const
@@ -133,11 +225,13 @@ std::string rbImage::inspect() const
 
 void rbImage::createFromColor(unsigned int width, unsigned int height, sf::Color color)
 {
+    checkIdle();
     myObject.create(width, height, color);
 }
 
 void rbImage::createFromData(unsigned int width, unsigned int height, const std::vector<rb::Value>& data)
 {
+    checkIdle();
     sf::Uint8* rawData = new sf::Uint8[data.size()];
     for(int index = 0, size = data.size(); index < size; index++)
     {
@@ -149,11 +243,13 @@ void rbImage::createFromData(unsigned int width, unsigned int height, const std:
 
 bool rbImage::loadFromFile(const std::string& filename)
 {
+    checkIdle();
     return myObject.loadFromFile(filename);
 }
 
 bool rbImage::loadFromMemory(const std::vector<rb::Value>& data)
 {
+    checkIdle();
     sf::Uint8* rawData = new sf::Uint8[data.size()];
     for(int index = 0, size = data.size(); index < size; index++)
     {
@@ -191,7 +287,11 @@ rb::Value rbImage::createMaskFromColor(rb::Value self, const std::vector<rb::Val
         	break;
     }
 
-    object->myObject.createMaskFromColor(color, alpha);
+    Pin pin(*object, true);
+    sf::Uint8* pixels = object->getMutablePixels();
+    sf::Vector2u size = object->myObject.getSize();
+    std::size_t count = size.x * size.y;
+    runKernel(count, [=]() { kernel::maskColor(pixels, count, color, alpha); });
 
 	return rb::Nil;
 }
@@ -220,6 +320,7 @@ rb::Value rbImage::copy(rb::Value self, const std::vector<rb::Value>& args)
         	break;
     }
 
+    object->checkIdle();
     object->myObject.copy(*source, destX, destY, sourceRect, applyAlpha);
 
 	return rb::Nil;
@@ -227,6 +328,7 @@ rb::Value rbImage::copy(rb::Value self, const std::vector<rb::Value>& args)
 
 void rbImage::setPixel(unsigned int x, unsigned int y, sf::Color color)
 {
+    checkIdle();
     myObject.setPixel(x, y, color);
 }
 
@@ -249,41 +351,344 @@ rb::Value rbImage::getPixels() const
 
 void rbImage::flipHorizontally()
 {
+    checkIdle();
     myObject.flipHorizontally();
 }
 
 void rbImage::flipVertically()
 {
+    checkIdle();
     myObject.flipVertically();
 }
 
+void rbImage::premultiplyAlpha()
+{
+    Pin pin(*this, true);
+    sf::Uint8* pixels = getMutablePixels();
+    std::size_t count = myObject.getSize().x * myObject.getSize().y;
+    runKernel(count, [=]() { kernel::premultiplyAlpha(pixels, count); });
+}
+
+void rbImage::unpremultiplyAlpha()
+{
+    Pin pin(*this, true);
+    sf::Uint8* pixels = getMutablePixels();
+    std::size_t count = myObject.getSize().x * myObject.getSize().y;
+    runKernel(count, [=]() { kernel::unpremultiplyAlpha(pixels, count); });
+}
+
+void rbImage::tint(sf::Color color)
+{
+    Pin pin(*this, true);
+    sf::Uint8* pixels = getMutablePixels();
+    std::size_t count = myObject.getSize().x * myObject.getSize().y;
+    runKernel(count, [=]() { kernel::tint(pixels, count, color); });
+}
+
+void rbImage::grayscale()
+{
+    Pin pin(*this, true);
+    sf::Uint8* pixels = getMutablePixels();
+    std::size_t count = myObject.getSize().x * myObject.getSize().y;
+    runKernel(count, [=]() { kernel::grayscale(pixels, count); });
+}
+
+void rbImage::swizzle(const rb::Value& order)
+{
+    int channels[4];
+    if(order.getType() == rb::ValueType::String)
+    {
+        std::string string = order.to<std::string>();
+        if(string.size() != 4)
+            rb::raise(rb::ArgumentError, "expected 4 channels, got %d", static_cast<int>(string.size()));
+        for(int index = 0; index < 4; index++)
+            channels[index] = channelIndex(string[index]);
+    }
+    else if(order.getType() == rb::ValueType::Array)
+    {
+        std::vector<rb::Value> array = order.to<std::vector<rb::Value>>();
+        if(array.size() != 4)
+            rb::raise(rb::ArgumentError, "expected 4 channels, got %d", static_cast<int>(array.size()));
+        for(int index = 0; index < 4; index++)
+        {
+            channels[index] = array[index].to<int>();
+            if(channels[index] < 0 || channels[index] > 3)
+                rb::raise(rb::ArgumentError, "channel index %d out of range 0..3", channels[index]);
+        }
+    }
+    else
+    {
+        rb::expectedTypes("String", "Array");
+    }
+
+    Pin pin(*this, true);
+    sf::Uint8* pixels = getMutablePixels();
+    std::size_t count = myObject.getSize().x * myObject.getSize().y;
+    runKernel(count, [=]() { kernel::swizzle(pixels, count, channels); });
+}
+
+rb::Value rbImage::blit(rb::Value self, const std::vector<rb::Value>& args)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbImage* object = self.to<rbImage*>();
+	const sf::Image* source = nullptr;
+	int destX = 0;
+	int destY = 0;
+	sf::IntRect sourceRect;
+	switch(args.size())
+    {
+        case 4:
+            sourceRect = args[3].to<sf::IntRect>();
+        case 3:
+            source = &args[0].to<const sf::Image&>();
+            destX = args[1].to<int>();
+            destY = args[2].to<int>();
+            break;
+        default:
+        	rb::expectedNumArgs(args.size(), 3, 4);
+        	break;
+    }
+
+    sf::Vector2u sourceSize = source->getSize();
+    if(sourceRect.width == 0 || sourceRect.height == 0)
+        sourceRect = sf::IntRect(0, 0, sourceSize.x, sourceSize.y);
+    sourceRect = clipRect(sourceRect, sourceSize);
+
+    sf::IntRect destRect = clipRect(sf::IntRect(destX, destY, sourceRect.width, sourceRect.height), object->myObject.getSize());
+    if(destRect.width == 0 || destRect.height == 0)
+        return rb::Nil;
+    sourceRect.left += destRect.left - destX;
+    sourceRect.top += destRect.top - destY;
+
+    sf::Image copy;
+    if(source == &object->myObject)
+    {
+        copy = *source;
+        source = &copy;
+    }
+
+    // Both images are checked up front so neither pin can raise and leak the other.
+    const rbImage* sourceImage = source != &copy ? args[0].to<const rbImage*>() : nullptr;
+    object->checkIdle();
+    if(sourceImage != nullptr && sourceImage->myIsWriting)
+        rb::raise(rb::RuntimeError, "%s is in use by another thread", ourDefinition.getName().c_str());
+
+    Pin destinationPin(*object, true);
+    std::unique_ptr<Pin> sourcePin(sourceImage != nullptr ? new Pin(*sourceImage, false) : nullptr);
+
+    sf::Uint8* destination = object->getMutablePixels();
+    const sf::Uint8* sourcePixels = source->getPixelsPtr();
+    unsigned int destStride = object->myObject.getSize().x * 4;
+    unsigned int sourceStride = sourceSize.x * 4;
+    runKernel(destRect.width * destRect.height, [&]()
+    {
+        for(int row = 0; row < destRect.height; row++)
+        {
+            kernel::blend(destination + (destRect.top + row) * destStride + destRect.left * 4,
+                          sourcePixels + (sourceRect.top + row) * sourceStride + sourceRect.left * 4,
+                          destRect.width);
+        }
+    });
+
+	return rb::Nil;
+}
+
+void rbImage::fillRect(sf::IntRect rect, sf::Color color)
+{
+    rect = clipRect(rect, myObject.getSize());
+    if(rect.width == 0 || rect.height == 0)
+        return;
+
+    Pin pin(*this, true);
+    sf::Uint8* pixels = getMutablePixels();
+    unsigned int stride = myObject.getSize().x * 4;
+    runKernel(rect.width * rect.height, [=]()
+    {
+        for(int row = 0; row < rect.height; row++)
+            kernel::fill(pixels + (rect.top + row) * stride + rect.left * 4, rect.width, color);
+    });
+}
+
+rb::Value rbImage::resize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	const rbImage* object = self.to<const rbImage*>();
+	kernel::Filter filter = kernel::Filter::Bilinear;
+	unsigned int width = 0;
+	unsigned int height = 0;
+	switch(args.size())
+    {
+        case 3:
+            if(args[2].getType() != rb::ValueType::Hash)
+                rb::expectedTypes("Hash");
+            if(!args[2].getHashEntry<symFilter>().isNil())
+                filter = toFilter(args[2].getHashEntry<symFilter>());
+        case 2:
+            width = args[0].to<unsigned int>();
+            height = args[1].to<unsigned int>();
+            break;
+        default:
+        	rb::expectedNumArgs(args.size(), 2, 3);
+        	break;
+    }
+    if(width == 0 || height == 0)
+        rb::raise(rb::ArgumentError, "can't resize to %ux%u", width, height);
+
+    rb::Value result = ourDefinition.newObject();
+    rbImage* image = result.to<rbImage*>();
+    image->myObject.create(width, height);
+
+    sf::Vector2u size = object->myObject.getSize();
+    if(size.x == 0 || size.y == 0)
+        return result;
+
+    Pin pin(*object, false);
+    const sf::Uint8* source = object->myObject.getPixelsPtr();
+    sf::Uint8* destination = image->getMutablePixels();
+    runKernel(std::max<std::size_t>(size.x * size.y, width * height), [=]()
+    {
+        kernel::resize(source, size.x, size.y, destination, width, height, filter, ThreadPool::getShared());
+    });
+
+	return result;
+}
+
+rb::Value rbImage::saveToMemory(const std::string& format) const
+{
+    encoder::Format imageFormat = toFormat(format);
+    sf::Vector2u size = myObject.getSize();
+    if(size.x == 0 || size.y == 0)
+        rb::raise(rb::RuntimeError, "can't encode an empty image");
+
+    std::vector<sf::Uint8> output;
+    bool success = false;
+    {
+        // Raising longjmps past destructors, the pin has to be gone first.
+        Pin pin(*this, false);
+        const sf::Uint8* pixels = myObject.getPixelsPtr();
+        runKernel(size.x * size.y, [&]() { success = encoder::encode(pixels, size.x, size.y, imageFormat, output); });
+    }
+    if(!success)
+        rb::raise(rb::RuntimeError, "failed to encode a %ux%u image as %s", size.x, size.y, format.c_str());
+    return rb::Value(rb_str_new(reinterpret_cast<const char*>(output.data()), output.size()));
+}
+
+rb::Value rbImage::saveAsync(rb::Value self, const std::vector<rb::Value>& args)
+{
+	const rbImage* object = self.to<const rbImage*>();
+	rb::Value options = rb::Nil;
+	switch(args.size())
+    {
+        case 2:
+            options = args[1];
+            if(options.getType() != rb::ValueType::Hash)
+                rb::expectedTypes("Hash");
+        case 1:
+            break;
+        default:
+        	rb::expectedNumArgs(args.size(), 1, 2);
+        	break;
+    }
+
+    rbImageSaveRequest::flushWrites();
+
+    std::shared_ptr<rbImageSaveRequest::Job> job = std::make_shared<rbImageSaveRequest::Job>();
+    job->format = encoder::Format::Png;
+    job->isDone = false;
+    job->isSuccess = false;
+
+    rb::Value io = rb::Nil;
+    rb::Value format = options.isNil() ? rb::Nil : options.getHashEntry<symFormat>();
+    if(args[0].getType() == rb::ValueType::String)
+    {
+        job->filename = args[0].to<std::string>();
+        if(format.isNil() && !encoder::getFormatFromFilename(job->filename, job->format))
+            rb::raise(rb::ArgumentError, "can't guess the image format of '%s'", job->filename.c_str());
+    }
+    else
+    {
+        io = args[0];
+    }
+    if(!format.isNil())
+        job->format = toFormat(macro::toName(format));
+
+    sf::Vector2u size = object->myObject.getSize();
+    if(size.x == 0 || size.y == 0)
+        rb::raise(rb::RuntimeError, "can't encode an empty image");
+    job->width = size.x;
+    job->height = size.y;
+    const sf::Uint8* pixels = object->myObject.getPixelsPtr();
+    job->pixels.assign(pixels, pixels + size.x * size.y * 4);
+
+    bool block = options.isNil() || options.getHashEntry<symBlock>().isNil() || options.getHashEntry<symBlock>().to<bool>();
+    if(!rbImageSaveRequest::enqueue(job, block))
+        return rb::Nil;
+
+    rb::Value request = rbImageSaveRequest::getDefinition().newObject();
+    request.to<rbImageSaveRequest*>()->setJob(job, io);
+	return request;
+}
+
+unsigned int rbImage::getSaveQueueCapacity()
+{
+    return rbImageSaveRequest::getQueueCapacity();
+}
+
+void rbImage::setSaveQueueCapacity(unsigned int capacity)
+{
+    rbImageSaveRequest::setQueueCapacity(capacity);
+}
+
+rbImage::Pin::Pin(const rbImage& image, bool isWriting)
+: myImage(image)
+, myIsWriting(isWriting)
+{
+	if(image.myIsWriting || (isWriting && image.myPinCount > 0))
+		rb::raise(rb::RuntimeError, "%s is in use by another thread", ourDefinition.getName().c_str());
+	image.myPinCount++;
+	image.myIsWriting = isWriting;
+}
+
+rbImage::Pin::~Pin()
+{
+	myImage.myPinCount--;
+	if(myIsWriting)
+		myImage.myIsWriting = false;
+}
+
+void rbImage::checkIdle() const
+{
+	if(myPinCount > 0)
+		rb::raise(rb::RuntimeError, "can't modify %s while another thread is using it", ourDefinition.getName().c_str());
+}
+
+sf::Uint8* rbImage::getMutablePixels()
+{
+    return const_cast<sf::Uint8*>(myObject.getPixelsPtr());
+}
+
 namespace rb
 {
 
 template<>
 rbImage* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbImage* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbImage, object);
-	return object;
+	return DataType<rbImage>::fetch(myValue);
 }
 
 template<>
 const rbImage* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbImage* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbImage, object);
-	return object;
+	return DataType<rbImage>::fetch(myValue);
 }
 
 template<>
 sf::Image& Value::to() const
 {
-    return to<rbImage*>()->myObject;
+    rbImage* image = to<rbImage*>();
+    image->checkIdle();
+    return image->myObject;
 }
 
 template<>
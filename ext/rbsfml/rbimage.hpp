@@ -42,8 +42,8 @@ public:
 	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
 	rbImage* initializeCopy(const rbImage* value);
 
-	rb::Value marshalDump() const;
-	void marshalLoad(const std::vector<rb::Value>& data);
+	rb::Value binaryDump(int level) const;
+	static rb::Value binaryLoad(rb::Value klass, const rb::Value& data);
 
 	std::string inspect() const;
 
@@ -66,11 +66,43 @@ public:
 	void flipHorizontally();
 	void flipVertically();
 
+	void premultiplyAlpha();
+	void unpremultiplyAlpha();
+	void tint(sf::Color color);
+	void grayscale();
+	void swizzle(const rb::Value& order);
+	static rb::Value blit(rb::Value self, const std::vector<rb::Value>& args);
+	void fillRect(sf::IntRect rect, sf::Color color);
+	static rb::Value resize(rb::Value self, const std::vector<rb::Value>& args);
+
+	rb::Value saveToMemory(const std::string& format) const;
+	static rb::Value saveAsync(rb::Value self, const std::vector<rb::Value>& args);
+	static unsigned int getSaveQueueCapacity();
+	static void setSaveQueueCapacity(unsigned int capacity);
+
 private:
+	// Pins the pixel buffer while a kernel works on it without the GVL, so
+	// other Ruby threads can't reallocate or write it in the meantime.
+	class Pin
+	{
+	public:
+		Pin(const rbImage& image, bool isWriting);
+		~Pin();
+
+	private:
+		const rbImage& myImage;
+		bool myIsWriting;
+	};
+
+	void checkIdle() const;
+	sf::Uint8* getMutablePixels();
+
     friend class rb::Value;
 	static rbImageClass ourDefinition;
 
 	sf::Image myObject;
+	mutable unsigned int myPinCount;
+	mutable bool myIsWriting;
 };
 
 namespace rb
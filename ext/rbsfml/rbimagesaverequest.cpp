@@ -0,0 +1,296 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbimagesaverequest.hpp"
+#include "base.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+	constexpr char symVarIO[] = "@__internal__io";
+	constexpr char symVarPendingWrites[] = "@@__internal_pending_writes";
+	constexpr char symWrite[] = "write";
+	constexpr char symPush[] = "push";
+
+	// A single encoder thread drains a bounded queue. When the queue is full
+	// producers wait (without the GVL) instead of piling up pixel copies.
+	class SaveQueue
+	{
+	public:
+		SaveQueue()
+		: myJobs()
+		, myCapacity(8)
+		, myThread()
+		, myMutex()
+		, myNotEmpty()
+		, myNotFull()
+		, myIsStopping(false)
+		{
+		}
+
+		~SaveQueue()
+		{
+			{
+				std::lock_guard<std::mutex> lock(myMutex);
+				myIsStopping = true;
+			}
+			myNotEmpty.notify_all();
+			if(myThread.joinable())
+				myThread.join();
+		}
+
+		bool push(const std::shared_ptr<rbImageSaveRequest::Job>& job, bool block)
+		{
+			std::unique_lock<std::mutex> lock(myMutex);
+			if(!myThread.joinable())
+				myThread = std::thread(&SaveQueue::work, this);
+			while(myJobs.size() >= myCapacity)
+			{
+				if(!block)
+					return false;
+				lock.unlock();
+				rb::waitWithoutGVL(myMutex, myNotFull, [this]() { return myJobs.size() < myCapacity; });
+				lock.lock();
+			}
+			myJobs.push_back(job);
+			myNotEmpty.notify_one();
+			return true;
+		}
+
+		unsigned int getCapacity()
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			return myCapacity;
+		}
+
+		void setCapacity(unsigned int capacity)
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			myCapacity = std::max(capacity, 1u);
+			myNotFull.notify_all();
+		}
+
+	private:
+		void work()
+		{
+			for(;;)
+			{
+				std::shared_ptr<rbImageSaveRequest::Job> job;
+				{
+					std::unique_lock<std::mutex> lock(myMutex);
+					myNotEmpty.wait(lock, [this]() { return myIsStopping || !myJobs.empty(); });
+					if(myJobs.empty())
+						return;
+					job = myJobs.front();
+					myJobs.pop_front();
+					myNotFull.notify_one();
+				}
+				process(*job);
+			}
+		}
+
+		void process(rbImageSaveRequest::Job& job)
+		{
+			bool success = encoder::encode(job.pixels.data(), job.width, job.height, job.format, job.output);
+			std::vector<sf::Uint8>().swap(job.pixels);
+
+			if(!success)
+				std::vector<sf::Uint8>().swap(job.output);
+			else if(!job.filename.empty())
+			{
+				std::ofstream file(job.filename.c_str(), std::ios::binary);
+				file.write(reinterpret_cast<const char*>(job.output.data()), job.output.size());
+				success = file.good();
+				std::vector<sf::Uint8>().swap(job.output);
+			}
+
+			std::lock_guard<std::mutex> lock(job.mutex);
+			job.isSuccess = success;
+			job.isDone = true;
+			job.condition.notify_all();
+		}
+
+		std::deque<std::shared_ptr<rbImageSaveRequest::Job>> myJobs;
+		unsigned int myCapacity;
+		std::thread myThread;
+		std::mutex myMutex;
+		std::condition_variable myNotEmpty;
+		std::condition_variable myNotFull;
+		bool myIsStopping;
+	};
+
+	SaveQueue& getSaveQueue()
+	{
+		static SaveQueue queue;
+		return queue;
+	}
+}
+
+rbImageSaveRequestClass rbImageSaveRequest::ourDefinition;
+
+void rbImageSaveRequest::defineClass(const rb::Value& image)
+{
+	ourDefinition = rbImageSaveRequestClass::defineClassUnder("SaveRequest", image);
+	ourDefinition.defineMethod<RBSFML_FN(&rbImageSaveRequest::poll)>("done?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImageSaveRequest::wait)>("wait");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImageSaveRequest::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbImageSaveRequest::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbImageSaveRequestClass& rbImageSaveRequest::getDefinition()
+{
+	return ourDefinition;
+}
+
+bool rbImageSaveRequest::enqueue(const std::shared_ptr<Job>& job, bool block)
+{
+	return getSaveQueue().push(job, block);
+}
+
+unsigned int rbImageSaveRequest::getQueueCapacity()
+{
+	return getSaveQueue().getCapacity();
+}
+
+void rbImageSaveRequest::setQueueCapacity(unsigned int capacity)
+{
+	getSaveQueue().setCapacity(capacity);
+}
+
+// IO targets are written from a Ruby thread, in submission order: by #wait,
+// by #done? and at the start of every Image#save_async. A fire and forget
+// save to an IO therefore lands at the latest with the next save.
+void rbImageSaveRequest::flushWrites()
+{
+	rb::Value definition(ourDefinition);
+	rb::Value pending = definition.getVar<symVarPendingWrites>();
+	if(pending.isNil())
+		return;
+
+	while(pending.getArrayLength() > 0)
+	{
+		rb::Value request(rb_ary_entry(pending.to<VALUE>(), 0));
+		rbImageSaveRequest* object = request.to<rbImageSaveRequest*>();
+		if(!object->isDone())
+			return;
+		rb_ary_shift(pending.to<VALUE>());
+		object->writeOutput();
+	}
+}
+
+rbImageSaveRequest::rbImageSaveRequest()
+: rb::Object()
+, myJob()
+, myIsWritten(false)
+{
+}
+
+rbImageSaveRequest::~rbImageSaveRequest()
+{
+}
+
+bool rbImageSaveRequest::isDone() const
+{
+	if(!myJob)
+		return true;
+	std::lock_guard<std::mutex> lock(myJob->mutex);
+	return myJob->isDone;
+}
+
+bool rbImageSaveRequest::poll()
+{
+	flushWrites();
+	return isDone();
+}
+
+bool rbImageSaveRequest::wait()
+{
+	if(!myJob)
+		return false;
+
+	std::shared_ptr<Job> job = myJob;
+	rb::waitWithoutGVL(job->mutex, job->condition, [job]() { return job->isDone; });
+
+	flushWrites();
+	writeOutput();
+	return job->isSuccess;
+}
+
+rb::Value rbImageSaveRequest::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbImageSaveRequest::inspect() const
+{
+	return ourDefinition.getName() + "(" + (isDone() ? "done" : "pending") + ")";
+}
+
+void rbImageSaveRequest::setJob(const std::shared_ptr<Job>& job, const rb::Value& io)
+{
+	myJob = job;
+	myValue.setVar<symVarIO>(io);
+	if(io.isNil())
+		return;
+
+	rb::Value definition(ourDefinition);
+	if(definition.getVar<symVarPendingWrites>().isNil())
+		definition.setVar<symVarPendingWrites>(std::vector<rb::Value>());
+	definition.getVar<symVarPendingWrites>().call<symPush>(myValue);
+}
+
+void rbImageSaveRequest::writeOutput()
+{
+	rb::Value io = myValue.getVar<symVarIO>();
+	if(io.isNil() || myIsWritten)
+		return;
+
+	myIsWritten = true;
+	rb::Value data(rb_str_new(reinterpret_cast<const char*>(myJob->output.data()), myJob->output.size()));
+	std::vector<sf::Uint8>().swap(myJob->output);
+	if(myJob->isSuccess)
+		io.call<symWrite>(data);
+}
+
+namespace rb
+{
+
+template<>
+rbImageSaveRequest* Value::to() const
+{
+	return DataType<rbImageSaveRequest>::fetch(myValue);
+}
+
+template<>
+const rbImageSaveRequest* Value::to() const
+{
+	return DataType<rbImageSaveRequest>::fetch(myValue);
+}
+
+}
@@ -0,0 +1,91 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBIMAGESAVEREQUEST_HPP_
+#define RBSFML_RBIMAGESAVEREQUEST_HPP_
+
+#include <SFML/Graphics/Image.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include "class.hpp"
+#include "object.hpp"
+#include "imageencoder.hpp"
+
+class rbImageSaveRequest;
+
+typedef rb::Class<rbImageSaveRequest> rbImageSaveRequestClass;
+
+class rbImageSaveRequest : public rb::Object
+{
+public:
+	struct Job
+	{
+		std::vector<sf::Uint8> pixels;
+		unsigned int width;
+		unsigned int height;
+		encoder::Format format;
+		std::string filename;
+		std::vector<sf::Uint8> output;
+		bool isDone;
+		bool isSuccess;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+
+	static void defineClass(const rb::Value& image);
+	static rbImageSaveRequestClass& getDefinition();
+
+	static bool enqueue(const std::shared_ptr<Job>& job, bool block);
+	static unsigned int getQueueCapacity();
+	static void setQueueCapacity(unsigned int capacity);
+	static void flushWrites();
+
+	rbImageSaveRequest();
+	~rbImageSaveRequest();
+
+	bool isDone() const;
+	bool poll();
+	bool wait();
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+	void setJob(const std::shared_ptr<Job>& job, const rb::Value& io);
+
+private:
+	void writeOutput();
+
+	static rbImageSaveRequestClass ourDefinition;
+
+	std::shared_ptr<Job> myJob;
+	bool myIsWritten;
+};
+
+namespace rb
+{
+	template<>
+	rbImageSaveRequest* Value::to() const;
+	template<>
+	const rbImageSaveRequest* Value::to() const;
+}
+
+#endif // RBSFML_RBIMAGESAVEREQUEST_HPP_
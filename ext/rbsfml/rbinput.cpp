@@ -0,0 +1,232 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbinput.hpp"
+#include "rbkeyboard.hpp"
+#include "rbmouse.hpp"
+#include "rbjoystick.hpp"
+#include "rbvector2.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+
+#include <SFML/Window/Window.hpp>
+
+rbInputClass rbInput::ourDefinition;
+
+void rbInput::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbInputClass::defineClassUnder("Input", sfml);
+	ourDefinition.defineFunction<RBSFML_FN(&rbInput::snapshot)>("snapshot");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::capture)>("capture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::isKeyPressed)>("key_pressed?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::isButtonPressed)>("button_pressed?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::getMouseX)>("mouse_x");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::getMouseY)>("mouse_y");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::getMousePosition)>("mouse_position");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::isJoystickConnected)>("joystick_connected?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::isJoystickButtonPressed)>("joystick_button_pressed?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::getJoystickAxisPosition)>("joystick_axis_position");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::getFrame)>("frame");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbInput::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbInputClass& rbInput::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbInput::rbInput()
+: rb::Object()
+, myKeys()
+, mySampledKeys()
+, myButtons()
+, myMouse()
+, myJoysticks()
+, myFrame(0)
+{
+}
+
+rbInput::~rbInput()
+{
+}
+
+rb::Value rbInput::snapshot(const std::vector<rb::Value>& args)
+{
+	rb::Value object = ourDefinition.newObject();
+	capture(object, args);
+	return object;
+}
+
+rb::Value rbInput::capture(rb::Value self, const std::vector<rb::Value>& args)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbInput* object = self.to<rbInput*>();
+	switch(args.size())
+	{
+		case 0:
+			object->sample(nullptr);
+			break;
+		case 1:
+			object->sample(args[0].isNil() ? nullptr : &args[0].to<const sf::Window&>());
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 0, 1);
+			break;
+	}
+
+	return self;
+}
+
+rbInput* rbInput::initializeCopy(const rbInput* value)
+{
+	myKeys = value->myKeys;
+	mySampledKeys = value->mySampledKeys;
+	myButtons = value->myButtons;
+	myMouse = value->myMouse;
+	std::copy(value->myJoysticks, value->myJoysticks + sf::Joystick::Count, myJoysticks);
+	myFrame = value->myFrame;
+	return this;
+}
+
+bool rbInput::isKeyPressed(sf::Keyboard::Key key) const
+{
+	if(key < 0 || key >= sf::Keyboard::KeyCount)
+		return false;
+
+	if(!mySampledKeys.test(key))
+	{
+		myKeys.set(key, sf::Keyboard::isKeyPressed(key));
+		mySampledKeys.set(key);
+	}
+	return myKeys.test(key);
+}
+
+bool rbInput::isButtonPressed(sf::Mouse::Button button) const
+{
+	if(button < 0 || button >= sf::Mouse::ButtonCount)
+		return false;
+	return myButtons.test(button);
+}
+
+int rbInput::getMouseX() const
+{
+	return myMouse.x;
+}
+
+int rbInput::getMouseY() const
+{
+	return myMouse.y;
+}
+
+sf::Vector2i rbInput::getMousePosition() const
+{
+	return myMouse;
+}
+
+bool rbInput::isJoystickConnected(unsigned int joystick) const
+{
+	return joystick < sf::Joystick::Count && myJoysticks[joystick].connected;
+}
+
+bool rbInput::isJoystickButtonPressed(unsigned int joystick, unsigned int button) const
+{
+	if(joystick >= sf::Joystick::Count || button >= sf::Joystick::ButtonCount)
+		return false;
+	return myJoysticks[joystick].buttons.test(button);
+}
+
+float rbInput::getJoystickAxisPosition(unsigned int joystick, sf::Joystick::Axis axis) const
+{
+	if(joystick >= sf::Joystick::Count || static_cast<unsigned int>(axis) >= sf::Joystick::AxisCount)
+		return 0;
+	return myJoysticks[joystick].axes[axis];
+}
+
+unsigned int rbInput::getFrame() const
+{
+	return myFrame;
+}
+
+rb::Value rbInput::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbInput::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myFrame) + ")";
+}
+
+void rbInput::sample(const sf::Window* window)
+{
+	mySampledKeys.reset();
+
+	for(unsigned int button = 0; button < sf::Mouse::ButtonCount; button++)
+		myButtons.set(button, sf::Mouse::isButtonPressed(static_cast<sf::Mouse::Button>(button)));
+	myMouse = window ? sf::Mouse::getPosition(*window) : sf::Mouse::getPosition();
+
+	// Joystick state is already cached by SFML and refreshed while events are
+	// processed, so reading all of it is cheap.
+	for(unsigned int joystick = 0; joystick < sf::Joystick::Count; joystick++)
+	{
+		JoystickState& state = myJoysticks[joystick];
+		state = JoystickState();
+		state.connected = sf::Joystick::isConnected(joystick);
+		if(!state.connected)
+			continue;
+
+		unsigned int buttons = sf::Joystick::getButtonCount(joystick);
+		for(unsigned int button = 0; button < buttons; button++)
+			state.buttons.set(button, sf::Joystick::isButtonPressed(joystick, button));
+		for(unsigned int axis = 0; axis < sf::Joystick::AxisCount; axis++)
+		{
+			sf::Joystick::Axis value = static_cast<sf::Joystick::Axis>(axis);
+			if(sf::Joystick::hasAxis(joystick, value))
+				state.axes[axis] = sf::Joystick::getAxisPosition(joystick, value);
+		}
+	}
+
+	myFrame++;
+}
+
+namespace rb
+{
+
+template<>
+rbInput* Value::to() const
+{
+	return DataType<rbInput>::fetch(myValue);
+}
+
+template<>
+const rbInput* Value::to() const
+{
+	return DataType<rbInput>::fetch(myValue);
+}
+
+}
@@ -0,0 +1,98 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBINPUT_HPP_
+#define RBSFML_RBINPUT_HPP_
+
+#include <SFML/Window/Keyboard.hpp>
+#include <SFML/Window/Mouse.hpp>
+#include <SFML/Window/Joystick.hpp>
+#include <bitset>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbInput;
+
+typedef rb::Class<rbInput> rbInputClass;
+
+// Keyboard, mouse and joystick state captured once per frame, so that
+// queries neither go to the OS nor allocate.
+class rbInput : public rb::Object
+{
+public:
+	static void defineClass(const rb::Value& sfml);
+	static rbInputClass& getDefinition();
+
+	rbInput();
+	~rbInput();
+
+	static rb::Value snapshot(const std::vector<rb::Value>& args);
+	static rb::Value capture(rb::Value self, const std::vector<rb::Value>& args);
+	rbInput* initializeCopy(const rbInput* value);
+
+	bool isKeyPressed(sf::Keyboard::Key key) const;
+	bool isButtonPressed(sf::Mouse::Button button) const;
+
+	int getMouseX() const;
+	int getMouseY() const;
+	sf::Vector2i getMousePosition() const;
+
+	bool isJoystickConnected(unsigned int joystick) const;
+	bool isJoystickButtonPressed(unsigned int joystick, unsigned int button) const;
+	float getJoystickAxisPosition(unsigned int joystick, sf::Joystick::Axis axis) const;
+
+	unsigned int getFrame() const;
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+private:
+	struct JoystickState
+	{
+		bool connected;
+		std::bitset<sf::Joystick::ButtonCount> buttons;
+		float axes[sf::Joystick::AxisCount];
+	};
+
+	void sample(const sf::Window* window);
+
+	static rbInputClass ourDefinition;
+
+	// Keys are only sampled the first time they are queried after a capture;
+	// on X11 every sample is a server round trip and most frames only look at
+	// a handful of keys.
+	mutable std::bitset<sf::Keyboard::KeyCount> myKeys;
+	mutable std::bitset<sf::Keyboard::KeyCount> mySampledKeys;
+	std::bitset<sf::Mouse::ButtonCount> myButtons;
+	sf::Vector2i myMouse;
+	JoystickState myJoysticks[sf::Joystick::Count];
+	unsigned int myFrame;
+};
+
+namespace rb
+{
+	template<>
+	rbInput* Value::to() const;
+	template<>
+	const rbInput* Value::to() const;
+}
+
+#endif // RBSFML_RBINPUT_HPP_
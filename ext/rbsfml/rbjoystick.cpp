@@ -36,13 +36,13 @@ rbJoystickIdentificationClass rbJoystickIdentification::ourDefinition;
 void rbJoystick::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbJoystickModule::defineModuleUnder("Joystick", sfml);
-	ourDefinition.defineFunction<0>("connected=", &sf::Joystick::isConnected);
-	ourDefinition.defineFunction<1>("get_button_count", &sf::Joystick::getButtonCount);
-	ourDefinition.defineFunction<2>("has_axis?", &sf::Joystick::hasAxis);
-	ourDefinition.defineFunction<3>("button_pressed?", &sf::Joystick::isButtonPressed);
-	ourDefinition.defineFunction<4>("get_axis_position", &sf::Joystick::getAxisPosition);
-	ourDefinition.defineFunction<5>("update", &sf::Joystick::update);
-	ourDefinition.defineFunction<6>("get_identification", &sf::Joystick::getIdentification);
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Joystick::isConnected)>("connected=");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Joystick::getButtonCount)>("get_button_count");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Joystick::hasAxis)>("has_axis?");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Joystick::isButtonPressed)>("button_pressed?");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Joystick::getAxisPosition)>("get_axis_position");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Joystick::update)>("update");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Joystick::getIdentification)>("get_identification");
 
 	ourDefinition.defineConstant("Count", rb::Value(sf::Joystick::Count));
 	ourDefinition.defineConstant("ButtonCount", rb::Value(sf::Joystick::ButtonCount));
@@ -62,10 +62,10 @@ void rbJoystick::defineModule(const rb::Value& sfml)
 void rbJoystickIdentification::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbJoystickIdentificationClass::defineClassUnder<rb::RubyObjAllocator>("Identification", rb::Value(rbJoystick::ourDefinition));	
-	ourDefinition.defineMethod<0>("initialize", &rbJoystickIdentification::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbJoystickIdentification::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbJoystickIdentification::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbJoystickIdentification::marshalLoad);
+	ourDefinition.defineMethod<RBSFML_FN(&rbJoystickIdentification::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbJoystickIdentification::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbJoystickIdentification::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbJoystickIdentification::marshalLoad)>("marshal_load");
 
 	ourDefinition.defineAttribute("x", true, true);
 	ourDefinition.defineAttribute("y", true, true);
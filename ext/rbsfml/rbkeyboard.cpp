@@ -28,8 +28,8 @@ rbKeyboardModule rbKeyboard::ourDefinition;
 void rbKeyboard::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbKeyboardModule::defineModuleUnder("Keyboard", sfml);
-	ourDefinition.defineFunction<0>("key_pressed?", &sf::Keyboard::isKeyPressed);
-	ourDefinition.defineFunction<1>("virtual_keyboard_visible=", &sf::Keyboard::setVirtualKeyboardVisible);
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Keyboard::isKeyPressed)>("key_pressed?");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Keyboard::setVirtualKeyboardVisible)>("virtual_keyboard_visible=");
 
 	ourDefinition.defineConstant("Unknown", rb::Value(sf::Keyboard::Unknown));
 	ourDefinition.defineConstant("A", rb::Value(sf::Keyboard::A));
@@ -29,9 +29,9 @@ rbMouseModule rbMouse::ourDefinition;
 void rbMouse::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbMouseModule::defineModuleUnder("Mouse", sfml);
-	ourDefinition.defineFunction<0>("button_pressed?", &sf::Mouse::isButtonPressed);
-	ourDefinition.defineFunction<1>("get_position", &rbMouse::getPosition);
-	ourDefinition.defineFunction<2>("set_position", &rbMouse::setPosition);
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Mouse::isButtonPressed)>("button_pressed?");
+	ourDefinition.defineFunction<RBSFML_FN(&rbMouse::getPosition)>("get_position");
+	ourDefinition.defineFunction<RBSFML_FN(&rbMouse::setPosition)>("set_position");
 
 	ourDefinition.defineConstant("Left", rb::Value(sf::Mouse::Left));
 	ourDefinition.defineConstant("Right", rb::Value(sf::Mouse::Right));
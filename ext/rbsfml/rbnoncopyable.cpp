@@ -28,8 +28,8 @@ rbNonCopyableModule rbNonCopyable::ourDefinition;
 void rbNonCopyable::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbNonCopyableModule::defineModuleUnder("NonCopyable", sfml);
-	ourDefinition.defineMethod<0>("initialize_copy", &rbNonCopyable::initializeCopy);
-	ourDefinition.defineMethod<1>("marshal_dump", &rbNonCopyable::marshalDump);
+	ourDefinition.defineMethod<RBSFML_FN(&rbNonCopyable::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbNonCopyable::marshalDump)>("marshal_dump");
 }
 
 rbNonCopyableModule rbNonCopyable::getDefinition()
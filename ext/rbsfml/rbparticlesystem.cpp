@@ -0,0 +1,545 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbparticlesystem.hpp"
+#include "rbvector2.hpp"
+#include "rbrect.hpp"
+#include "rbtexture.hpp"
+#include "rbcolor.hpp"
+#include "rbtime.hpp"
+#include "threadpool.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const unsigned int DefaultCapacity = 10000;
+	const unsigned int DefaultParallelThreshold = 4096;
+
+	constexpr char symVarInternalTexture[] = "@__internal__texture";
+
+	constexpr char symPosition[] = "position";
+	constexpr char symArea[] = "area";
+	constexpr char symRate[] = "rate";
+	constexpr char symLifetime[] = "lifetime";
+	constexpr char symLifetimeVariance[] = "lifetime_variance";
+	constexpr char symVelocity[] = "velocity";
+	constexpr char symSpeedVariance[] = "speed_variance";
+	constexpr char symAngleVariance[] = "angle_variance";
+	constexpr char symColor[] = "color";
+	constexpr char symSize[] = "size";
+
+	float toSeconds(const rb::Value& value)
+	{
+		switch(value.getType())
+		{
+			case rb::ValueType::Fixnum:
+				return value.to<sf::Int64>() / 1000000.0f;
+			case rb::ValueType::Float:
+				return value.to<float>();
+			case rb::ValueType::Data:
+				return value.to<const rbTime*>()->asSeconds();
+			default:
+				rb::expectedTypes("Fixnum", "Float", "Time");
+				return 0;
+		}
+	}
+
+	template<const char* Name, typename Type>
+	Type getOption(const rb::Value& options, const Type& fallback)
+	{
+		rb::Value value = options.getHashEntry<Name>();
+		return value.isNil() ? fallback : value.to<Type>();
+	}
+}
+
+rbParticleSystemClass rbParticleSystem::ourDefinition;
+
+void rbParticleSystem::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbParticleSystemClass::defineClassUnder("ParticleSystem", sfml);
+	ourDefinition.includeModule(rb::Value(rbDrawable::getDefinition()));
+	ourDefinition.includeModule(rb::Value(rbTransformable::getDefinition()));
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::addEmitter)>("add_emitter");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::removeEmitter)>("remove_emitter");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::moveEmitter)>("move_emitter");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getEmitterCount)>("emitter_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::emit)>("emit");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::update)>("update");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::clear)>("clear");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setGravity)>("gravity=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getGravity)>("gravity");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setDrag)>("drag=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getDrag)>("drag");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setColorOverLife)>("set_color_over_life");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setSizeOverLife)>("set_size_over_life");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::clearAffectors)>("clear_affectors");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getParticleCount)>("particle_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getVertexCount)>("vertex_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setCapacity)>("capacity=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getCapacity)>("capacity");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setTexture)>("texture=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getTexture)>("texture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setTextureRect)>("texture_rect=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getTextureRect)>("texture_rect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setPrimitiveType)>("primitive_type=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getPrimitiveType)>("primitive_type");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::setParallelThreshold)>("parallel_threshold=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbParticleSystem::getParallelThreshold)>("parallel_threshold");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+	ourDefinition.aliasMethod("particle_count", "size");
+}
+
+rbParticleSystemClass& rbParticleSystem::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbParticleSystem::rbParticleSystem()
+: rbTransformable()
+, myObject()
+, myParticles()
+, myAffectors()
+, myEmitters()
+, myTextureRect()
+, myParallelThreshold(DefaultParallelThreshold)
+, myRandom(std::random_device()())
+{
+	myParticles.setCapacity(DefaultCapacity);
+}
+
+rbParticleSystem::~rbParticleSystem()
+{
+}
+
+rb::Value rbParticleSystem::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	rbParticleSystem* object = self.to<rbParticleSystem*>();
+	switch(args.size())
+	{
+		case 0:
+			break;
+		case 1:
+			object->setCapacity(args[0].to<unsigned int>());
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 0, 1);
+			break;
+	}
+
+	return self;
+}
+
+rbParticleSystem* rbParticleSystem::initializeCopy(const rbParticleSystem* value)
+{
+	myObject = value->myObject;
+	myParticles = value->myParticles;
+	myAffectors = value->myAffectors;
+	myEmitters = value->myEmitters;
+	myTextureRect = value->myTextureRect;
+	myParallelThreshold = value->myParallelThreshold;
+	return this;
+}
+
+rb::Value rbParticleSystem::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbParticleSystem::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myParticles.count) + "/" + macro::toString(myParticles.getCapacity()) + ")";
+}
+
+unsigned int rbParticleSystem::addEmitter(const rb::Value& options)
+{
+	Emitter emitter = toEmitter(options);
+	for(unsigned int id = 0; id < myEmitters.size(); id++)
+	{
+		if(!myEmitters[id].alive)
+		{
+			myEmitters[id] = emitter;
+			return id;
+		}
+	}
+	myEmitters.push_back(emitter);
+	return myEmitters.size() - 1;
+}
+
+void rbParticleSystem::removeEmitter(unsigned int id)
+{
+	getEmitter(id).alive = false;
+}
+
+void rbParticleSystem::moveEmitter(unsigned int id, sf::Vector2f position)
+{
+	getEmitter(id).position = position;
+}
+
+unsigned int rbParticleSystem::getEmitterCount() const
+{
+	return std::count_if(myEmitters.begin(), myEmitters.end(), [](const Emitter& emitter) { return emitter.alive; });
+}
+
+rb::Value rbParticleSystem::emit(rb::Value self, const std::vector<rb::Value>& args)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbParticleSystem* object = self.to<rbParticleSystem*>();
+	Emitter emitter;
+	switch(args.size())
+	{
+		case 2:
+			emitter = toEmitter(args[1]);
+		case 1:
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 1, 2);
+			break;
+	}
+
+	unsigned int emitted = object->spawn(emitter, args[0].to<unsigned int>());
+	object->rebuildVertices();
+	return rb::Value::create(emitted);
+}
+
+void rbParticleSystem::update(const rb::Value& delta)
+{
+	float seconds = toSeconds(delta);
+	if(seconds < 0)
+		rb::raise(rb::ArgumentError, "expected a positive time step, got %f", seconds);
+
+	for(Emitter& emitter : myEmitters)
+	{
+		if(!emitter.alive)
+			continue;
+
+		emitter.accumulator += emitter.rate * seconds;
+		unsigned int count = static_cast<unsigned int>(emitter.accumulator);
+		emitter.accumulator -= count;
+		spawn(emitter, count);
+	}
+
+	// The GVL stays held: simulate already spreads large systems over the
+	// thread pool, and releasing it would let other Ruby threads clear or
+	// resize the particle storage underneath the workers.
+	simulate(seconds);
+	rebuildVertices();
+}
+
+void rbParticleSystem::clear()
+{
+	myParticles.clear();
+	myObject.vertices.clear();
+}
+
+void rbParticleSystem::setGravity(sf::Vector2f gravity)
+{
+	myAffectors.gravity = gravity;
+}
+
+sf::Vector2f rbParticleSystem::getGravity() const
+{
+	return myAffectors.gravity;
+}
+
+void rbParticleSystem::setDrag(float drag)
+{
+	myAffectors.drag = std::max(drag, 0.0f);
+}
+
+float rbParticleSystem::getDrag() const
+{
+	return myAffectors.drag;
+}
+
+void rbParticleSystem::setColorOverLife(sf::Color start, sf::Color end)
+{
+	myAffectors.colorOverLife = true;
+	myAffectors.startColor = start;
+	myAffectors.endColor = end;
+}
+
+void rbParticleSystem::setSizeOverLife(float start, float end)
+{
+	myAffectors.sizeOverLife = true;
+	myAffectors.startSize = start;
+	myAffectors.endSize = end;
+}
+
+void rbParticleSystem::clearAffectors()
+{
+	myAffectors = particle::Affectors();
+}
+
+unsigned int rbParticleSystem::getParticleCount() const
+{
+	return myParticles.count;
+}
+
+unsigned int rbParticleSystem::getVertexCount() const
+{
+	return myObject.vertices.getVertexCount();
+}
+
+void rbParticleSystem::setCapacity(unsigned int capacity)
+{
+	myParticles.setCapacity(capacity);
+	rebuildVertices();
+}
+
+unsigned int rbParticleSystem::getCapacity() const
+{
+	return myParticles.getCapacity();
+}
+
+rb::Value rbParticleSystem::setTexture(rb::Value self, const rb::Value& texture)
+{
+	rbParticleSystem* object = self.to<rbParticleSystem*>();
+	if(texture.isNil())
+	{
+		object->myObject.texture = nullptr;
+	}
+	else
+	{
+		const sf::Texture& value = texture.to<const sf::Texture&>();
+		object->myObject.texture = &value;
+		if(object->myTextureRect == sf::IntRect())
+			object->myTextureRect = sf::IntRect(0, 0, value.getSize().x, value.getSize().y);
+	}
+	self.setVar<symVarInternalTexture>(texture);
+	object->rebuildVertices();
+	return rb::Nil;
+}
+
+rb::Value rbParticleSystem::getTexture() const
+{
+	rb::Value self(myValue);
+	return self.getVar<symVarInternalTexture>();
+}
+
+void rbParticleSystem::setTextureRect(sf::IntRect rect)
+{
+	myTextureRect = rect;
+	rebuildVertices();
+}
+
+const sf::IntRect& rbParticleSystem::getTextureRect() const
+{
+	return myTextureRect;
+}
+
+void rbParticleSystem::setPrimitiveType(sf::PrimitiveType type)
+{
+	if(type != sf::Points && type != sf::Quads)
+		rb::raise(rb::ArgumentError, "particles can only be drawn as points or quads");
+	myObject.vertices.setPrimitiveType(type);
+	rebuildVertices();
+}
+
+sf::PrimitiveType rbParticleSystem::getPrimitiveType() const
+{
+	return myObject.vertices.getPrimitiveType();
+}
+
+void rbParticleSystem::setParallelThreshold(unsigned int threshold)
+{
+	myParallelThreshold = threshold;
+}
+
+unsigned int rbParticleSystem::getParallelThreshold() const
+{
+	return myParallelThreshold;
+}
+
+sf::Drawable* rbParticleSystem::getDrawable()
+{
+	return &myObject;
+}
+
+const sf::Drawable* rbParticleSystem::getDrawable() const
+{
+	return &myObject;
+}
+
+sf::Transformable* rbParticleSystem::getTransformable()
+{
+	return &myObject;
+}
+
+const sf::Transformable* rbParticleSystem::getTransformable() const
+{
+	return &myObject;
+}
+
+rbParticleSystem::Renderer::Renderer()
+: sf::Drawable()
+, sf::Transformable()
+, vertices(sf::Quads)
+, texture(nullptr)
+{
+}
+
+void rbParticleSystem::Renderer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+	states.texture = texture;
+	target.draw(vertices, states);
+}
+
+rbParticleSystem::Emitter::Emitter()
+: position()
+, area()
+, rate(0)
+, lifetime(1)
+, lifetimeVariance(0)
+, velocity()
+, speedVariance(0)
+, angleVariance(0)
+, color(sf::Color::White)
+, size(1)
+, accumulator(0)
+, alive(true)
+{
+}
+
+rbParticleSystem::Emitter rbParticleSystem::toEmitter(const rb::Value& options)
+{
+	Emitter emitter;
+	if(options.isNil())
+		return emitter;
+
+	emitter.position = getOption<symPosition>(options, emitter.position);
+	emitter.area = getOption<symArea>(options, emitter.area);
+	emitter.rate = std::max(getOption<symRate>(options, emitter.rate), 0.0f);
+	emitter.lifetime = getOption<symLifetime>(options, emitter.lifetime);
+	emitter.lifetimeVariance = getOption<symLifetimeVariance>(options, emitter.lifetimeVariance);
+	emitter.velocity = getOption<symVelocity>(options, emitter.velocity);
+	emitter.speedVariance = getOption<symSpeedVariance>(options, emitter.speedVariance);
+	emitter.angleVariance = getOption<symAngleVariance>(options, emitter.angleVariance);
+	emitter.color = getOption<symColor>(options, emitter.color);
+	emitter.size = getOption<symSize>(options, emitter.size);
+	return emitter;
+}
+
+rbParticleSystem::Emitter& rbParticleSystem::getEmitter(unsigned int id)
+{
+	if(id >= myEmitters.size() || !myEmitters[id].alive)
+		rb::raise(rb::ArgumentError, "no emitter with id %u in %s", id, ourDefinition.getName().c_str());
+	return myEmitters[id];
+}
+
+unsigned int rbParticleSystem::spawn(const Emitter& emitter, unsigned int count)
+{
+	const float radians = 3.14159265f / 180.f;
+	unsigned int spawned = 0;
+	for(; spawned < count; spawned++)
+	{
+		sf::Vector2f position(emitter.position.x + random(emitter.area.x), emitter.position.y + random(emitter.area.y));
+
+		float angle = random(emitter.angleVariance) * radians;
+		float speed = 1.0f + random(emitter.speedVariance);
+		float cosine = std::cos(angle);
+		float sine = std::sin(angle);
+		sf::Vector2f velocity((emitter.velocity.x * cosine - emitter.velocity.y * sine) * speed,
+		                      (emitter.velocity.x * sine + emitter.velocity.y * cosine) * speed);
+
+		float lifetime = std::max(emitter.lifetime + random(emitter.lifetimeVariance), 0.0f);
+		if(!myParticles.add(position, velocity, lifetime, emitter.size, emitter.color))
+			break;
+	}
+	return spawned;
+}
+
+float rbParticleSystem::random(float range)
+{
+	if(range == 0)
+		return 0;
+	return std::uniform_real_distribution<float>(-range, range)(myRandom);
+}
+
+void rbParticleSystem::simulate(float delta)
+{
+	ThreadPool& pool = ThreadPool::getShared();
+	if(myParticles.count >= myParallelThreshold)
+	{
+		pool.parallelFor(myParticles.count, [this, delta](std::size_t begin, std::size_t end)
+		{
+			particle::integrate(myParticles, begin, end, delta, myAffectors);
+		});
+	}
+	else
+	{
+		particle::integrate(myParticles, 0, myParticles.count, delta, myAffectors);
+	}
+	particle::removeExpired(myParticles);
+}
+
+void rbParticleSystem::rebuildVertices()
+{
+	bool quads = myObject.vertices.getPrimitiveType() == sf::Quads;
+	std::size_t count = myParticles.count;
+	myObject.vertices.resize(quads ? count * 4 : count);
+	if(count == 0)
+		return;
+
+	sf::Vertex* vertices = &myObject.vertices[0];
+	sf::FloatRect textureRect(myTextureRect);
+	auto write = [this, quads, vertices, &textureRect](std::size_t begin, std::size_t end)
+	{
+		if(quads)
+			particle::writeQuads(myParticles, begin, end, myAffectors, textureRect, vertices);
+		else
+			particle::writePoints(myParticles, begin, end, myAffectors, vertices);
+	};
+
+	if(count >= myParallelThreshold)
+		ThreadPool::getShared().parallelFor(count, write);
+	else
+		write(0, count);
+}
+
+namespace rb
+{
+
+template<>
+rbParticleSystem* Value::to() const
+{
+	return DataType<rbParticleSystem>::fetch(myValue);
+}
+
+template<>
+const rbParticleSystem* Value::to() const
+{
+	return DataType<rbParticleSystem>::fetch(myValue);
+}
+
+}
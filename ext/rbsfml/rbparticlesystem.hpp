@@ -0,0 +1,155 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBPARTICLESYSTEM_HPP_
+#define RBSFML_RBPARTICLESYSTEM_HPP_
+
+#include "class.hpp"
+#include "rbdrawable.hpp"
+#include "rbtransformable.hpp"
+#include "particlekernels.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <random>
+
+class rbParticleSystem;
+
+typedef rb::Class<rbParticleSystem> rbParticleSystemClass;
+
+class rbParticleSystem : public rbTransformable
+{
+public:
+	static void defineClass(const rb::Value& sfml);
+	static rbParticleSystemClass& getDefinition();
+
+	rbParticleSystem();
+	~rbParticleSystem();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+	rbParticleSystem* initializeCopy(const rbParticleSystem* value);
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+	unsigned int addEmitter(const rb::Value& options);
+	void removeEmitter(unsigned int id);
+	void moveEmitter(unsigned int id, sf::Vector2f position);
+	unsigned int getEmitterCount() const;
+
+	static rb::Value emit(rb::Value self, const std::vector<rb::Value>& args);
+	void update(const rb::Value& delta);
+	void clear();
+
+	void setGravity(sf::Vector2f gravity);
+	sf::Vector2f getGravity() const;
+	void setDrag(float drag);
+	float getDrag() const;
+	void setColorOverLife(sf::Color start, sf::Color end);
+	void setSizeOverLife(float start, float end);
+	void clearAffectors();
+
+	unsigned int getParticleCount() const;
+	unsigned int getVertexCount() const;
+	void setCapacity(unsigned int capacity);
+	unsigned int getCapacity() const;
+
+	static rb::Value setTexture(rb::Value self, const rb::Value& texture);
+	rb::Value getTexture() const;
+	void setTextureRect(sf::IntRect rect);
+	const sf::IntRect& getTextureRect() const;
+
+	void setPrimitiveType(sf::PrimitiveType type);
+	sf::PrimitiveType getPrimitiveType() const;
+
+	void setParallelThreshold(unsigned int threshold);
+	unsigned int getParallelThreshold() const;
+
+protected:
+	virtual sf::Drawable* getDrawable();
+	virtual const sf::Drawable* getDrawable() const;
+
+	virtual sf::Transformable* getTransformable();
+	virtual const sf::Transformable* getTransformable() const;
+
+private:
+	friend class rb::Value;
+
+	class Renderer : public sf::Drawable, public sf::Transformable
+	{
+	public:
+		Renderer();
+
+		sf::VertexArray vertices;
+		const sf::Texture* texture;
+
+	private:
+		virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+	};
+
+	struct Emitter
+	{
+		sf::Vector2f position;
+		sf::Vector2f area;
+		float rate;
+		float lifetime;
+		float lifetimeVariance;
+		sf::Vector2f velocity;
+		float speedVariance;
+		float angleVariance;
+		sf::Color color;
+		float size;
+		float accumulator;
+		bool alive;
+
+		Emitter();
+	};
+
+	static Emitter toEmitter(const rb::Value& options);
+
+	Emitter& getEmitter(unsigned int id);
+	unsigned int spawn(const Emitter& emitter, unsigned int count);
+	float random(float range);
+	void simulate(float delta);
+	void rebuildVertices();
+
+	static rbParticleSystemClass ourDefinition;
+
+	Renderer myObject;
+	particle::Storage myParticles;
+	particle::Affectors myAffectors;
+	std::vector<Emitter> myEmitters;
+	sf::IntRect myTextureRect;
+	unsigned int myParallelThreshold;
+	std::minstd_rand myRandom;
+};
+
+namespace rb
+{
+	template<>
+	rbParticleSystem* Value::to() const;
+	template<>
+	const rbParticleSystem* Value::to() const;
+}
+
+#endif // RBSFML_RBPARTICLESYSTEM_HPP_
@@ -22,86 +22,168 @@
 #include "rbrect.hpp"
 #include "rbvector2.hpp"
 #include "error.hpp"
+#include "marshal.hpp"
 #include "macros.hpp"
 #include "base.hpp"
+#include <algorithm>
 
 namespace 
 {
-	constexpr char symVarLeft[] = "@left";
-	constexpr char symVarTop[] = "@top";
-	constexpr char symVarWidth[] = "@width";
-	constexpr char symVarHeight[] = "@height";
-
 	constexpr char symVarX[] = "@x";
 	constexpr char symVarY[] = "@y";
 
 	constexpr char symInspect[] = "inspect";
-	constexpr char symMoreEqual[] = ">=";
-	constexpr char symLessEqual[] = "<=";
-	constexpr char symMore[] = ">";
-	constexpr char symLess[] = "<";
-	constexpr char symAdd[] = "+";
-	constexpr char symSubtract[] = "-";
+
+	bool isIntegerValue(const rb::Value& value)
+	{
+		return value.getType() == rb::ValueType::Fixnum;
+	}
+
+	template<typename Type>
+	Type& component(sf::Rect<Type>& rect, int index)
+	{
+		switch(index)
+		{
+			case 0: return rect.left;
+			case 1: return rect.top;
+			case 2: return rect.width;
+			default: return rect.height;
+		}
+	}
+
+	template<typename Type>
+	Type component(const sf::Rect<Type>& rect, int index)
+	{
+		return component(const_cast<sf::Rect<Type>&>(rect), index);
+	}
+
+	template<typename Type>
+	sf::Rect<Type> unite(const sf::Rect<Type>& a, const sf::Rect<Type>& b)
+	{
+		Type left = std::min(std::min(a.left, a.left + a.width), std::min(b.left, b.left + b.width));
+		Type top = std::min(std::min(a.top, a.top + a.height), std::min(b.top, b.top + b.height));
+		Type right = std::max(std::max(a.left, a.left + a.width), std::max(b.left, b.left + b.width));
+		Type bottom = std::max(std::max(a.top, a.top + a.height), std::max(b.top, b.top + b.height));
+		return sf::Rect<Type>(left, top, right - left, bottom - top);
+	}
+
+	bool readRect(const rb::Value& value, sf::FloatRect& floatRect, sf::IntRect& intRect)
+	{
+		if(value.getType() == rb::ValueType::Array && value.getArrayLength() == 4)
+		{
+			const std::vector<rb::Value>& elements = value.to<const std::vector<rb::Value>&>();
+			if(isIntegerValue(elements[0]) && isIntegerValue(elements[1]) && isIntegerValue(elements[2]) && isIntegerValue(elements[3]))
+			{
+				intRect = sf::IntRect(elements[0].to<int>(), elements[1].to<int>(), elements[2].to<int>(), elements[3].to<int>());
+				floatRect = sf::FloatRect(intRect);
+				return true;
+			}
+			for(int index = 0; index < 4; index++)
+				component(floatRect, index) = isIntegerValue(elements[index]) ? elements[index].to<int>() : elements[index].to<float>();
+			return false;
+		}
+
+		const rbRect* rect = value.to<const rbRect*>();
+		floatRect = rect->getFloatRect();
+		intRect = rect->getIntRect();
+		return rect->isInteger();
+	}
+
+	bool readOffset(const std::vector<rb::Value>& args, rb::Value& x, rb::Value& y)
+	{
+		switch( args.size() )
+		{
+			case 1:
+				if(args[0].getType() == rb::ValueType::Array && args[0].getArrayLength() == 2)
+				{
+					const std::vector<rb::Value>& elements = args[0].to<const std::vector<rb::Value>&>();
+					x = elements[0];
+					y = elements[1];
+				}
+				else
+				{
+					x = args[0].getVar<symVarX>();
+					y = args[0].getVar<symVarY>();
+				}
+				break;
+			case 2:
+				x = args[0];
+				y = args[1];
+				break;
+			default:
+				rb::expectedNumArgs( args.size(), 1, 2 );
+				break;
+		}
+		return isIntegerValue(x) && isIntegerValue(y);
+	}
 }
 
 rbRectClass rbRect::ourDefinition;
 
 void rbRect::defineClass(const rb::Value& sfml)
 {
-	ourDefinition = rbRectClass::defineClassUnder<rb::RubyObjAllocator>("Rect", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbRect::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbRect::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbRect::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbRect::marshalLoad);
-	ourDefinition.defineMethod<4>("contains?", &rbRect::contains);
-	ourDefinition.defineMethod<5>("intersects?", &rbRect::intersects);
-	ourDefinition.defineMethod<6>("==", &rbRect::equal);
-	ourDefinition.defineMethod<7>("eql?", &rbRect::strictEqual);
-	ourDefinition.defineMethod<8>("inspect", &rbRect::inspect);
-
-	ourDefinition.defineAttribute("left", true, true);
-	ourDefinition.defineAttribute("top", true, true);
-	ourDefinition.defineAttribute("width", true, true);
-	ourDefinition.defineAttribute("height", true, true);
-
+	ourDefinition = rbRectClass::defineClassUnder("Rect", sfml);
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::binaryDump)>("_dump");
+	ourDefinition.defineSingletonMethod<RBSFML_FN(&rbRect::binaryLoad)>("_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::contains)>("contains?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::intersects)>("intersects?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::equal)>("==");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::strictEqual)>("eql?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::getLeft)>("left");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::setLeft)>("left=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::getTop)>("top");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::setTop)>("top=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::getWidth)>("width");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::setWidth)>("width=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::getHeight)>("height");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::setHeight)>("height=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::intersectInPlace)>("intersection!");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::unite)>("union");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::uniteInPlace)>("union!");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::expandInPlace)>("expand!");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRect::translateInPlace)>("translate!");
+
+	ourDefinition.aliasMethod("intersects?", "intersection");
 	ourDefinition.aliasMethod("eql?", "equal?");
 	ourDefinition.aliasMethod("inspect", "to_s");
 }
 
-const rbRectClass& rbRect::getDefinition()
+rbRectClass& rbRect::getDefinition()
 {
 	return ourDefinition;
 }
 
+rbRect::rbRect()
+: rb::Object()
+, myIsInteger(true)
+, myFloatRect()
+, myIntRect()
+{
+}
+
+rbRect::~rbRect()
+{
+}
+
 rb::Value rbRect::initialize(rb::Value self, const std::vector<rb::Value>& args)
 {
+	rbRect* object = self.to<rbRect*>();
 	switch( args.size() )
     {
         case 0:
-        	self.setVar<symVarLeft>(0);
-        	self.setVar<symVarTop>(0);
-        	self.setVar<symVarWidth>(0);
-        	self.setVar<symVarHeight>(0);
+            object->setRect(sf::IntRect());
             break;
         case 1:
-        	if(args[0].getType() == rb::ValueType::Array)
-        	{
-        		const std::vector<rb::Value>& elements = args[0].to<const std::vector<rb::Value>&>();
-        		self.setVar<symVarLeft>(elements[0]);
-	        	self.setVar<symVarTop>(elements[1]);
-	        	self.setVar<symVarWidth>(elements[2]);
-	        	self.setVar<symVarHeight>(elements[3]);
-        	}
+        	if(args[0].getType() == rb::ValueType::Array && args[0].getArrayLength() == 4)
+        		object->setComponents(args[0].to<const std::vector<rb::Value>&>().data());
         	else
-        	{
-        		rbRect::initializeCopy(self, args[0]);
-        	}
+        		object->initializeCopy(args[0].to<const rbRect*>());
             break;
         case 4:
-        	self.setVar<symVarLeft>(args[0]);
-        	self.setVar<symVarTop>(args[1]);
-        	self.setVar<symVarWidth>(args[2]);
-        	self.setVar<symVarHeight>(args[3]);
+        	object->setComponents(args.data());
             break;
         default:
         	rb::expectedNumArgs( args.size(), "0, 1 or 4" );
@@ -111,129 +193,351 @@ rb::Value rbRect::initialize(rb::Value self, const std::vector<rb::Value>& args)
 	return self;
 }
 
-rb::Value rbRect::initializeCopy(rb::Value self, const rb::Value& value)
+rbRect* rbRect::initializeCopy(const rbRect* value)
 {
-	self.setVar<symVarLeft>(value.getVar<symVarLeft, rb::Value>());
-    self.setVar<symVarTop>(value.getVar<symVarTop, rb::Value>());
-    self.setVar<symVarWidth>(value.getVar<symVarWidth, rb::Value>());
-    self.setVar<symVarHeight>(value.getVar<symVarHeight, rb::Value>());
-	return self;
+	myIsInteger = value->myIsInteger;
+	myFloatRect = value->myFloatRect;
+	myIntRect = value->myIntRect;
+	return this;
 }
 
-std::vector<rb::Value> rbRect::marshalDump(const rb::Value& self)
+// A kind byte followed by the components as varints or floats, matching
+// whichever rect is stored so the round trip is exact.
+rb::Value rbRect::binaryDump(int) const
 {
-	std::vector<rb::Value> array;
-	array.push_back(self.getVar<symVarLeft, rb::Value>());
-    array.push_back(self.getVar<symVarTop, rb::Value>());
-    array.push_back(self.getVar<symVarWidth, rb::Value>());
-    array.push_back(self.getVar<symVarHeight, rb::Value>());
-    return array;
+	std::string payload;
+	binary::Writer writer(payload);
+	writer.writeUint8(myIsInteger ? 1 : 0);
+	for(int index = 0; index < 4; index++)
+	{
+		if(myIsInteger)
+			writer.writeVarInt(component(myIntRect, index));
+		else
+			writer.writeFloat(component(myFloatRect, index));
+	}
+	return marshal::pack(payload, false);
 }
 
-rb::Value rbRect::marshalLoad(rb::Value self, const rb::Value& data)
+rb::Value rbRect::binaryLoad(rb::Value klass, const rb::Value& data)
 {
-	std::vector<rb::Value> array = data.to<std::vector<rb::Value>>();
-	self.setVar<symVarLeft>(array[0]);
-    self.setVar<symVarTop>(array[1]);
-    self.setVar<symVarWidth>(array[2]);
-    self.setVar<symVarHeight>(array[3]);
-	return rb::Nil;
+	std::string payload = marshal::unpack(data, ourDefinition.getName());
+	binary::Reader reader(payload.data(), payload.size());
+	sf::Uint8 kind = reader.readUint8();
+	sf::IntRect intRect;
+	sf::FloatRect floatRect;
+	for(int index = 0; index < 4; index++)
+	{
+		if(kind == 1)
+			component(intRect, index) = static_cast<int>(reader.readVarInt());
+		else
+			component(floatRect, index) = reader.readFloat();
+	}
+	if(kind > 1 || reader.isFailed() || !reader.isAtEnd())
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", ourDefinition.getName().c_str());
+
+	rb::Value object(rb_obj_alloc(klass.to<VALUE>()));
+	if(kind == 1)
+		object.to<rbRect*>()->setRect(intRect);
+	else
+		object.to<rbRect*>()->setRect(floatRect);
+	return object;
+}
+
+rb::Value rbRect::getLeft() const
+{
+	return getComponent(0);
+}
+
+void rbRect::setLeft(const rb::Value& value)
+{
+	setComponent(0, value);
+}
+
+rb::Value rbRect::getTop() const
+{
+	return getComponent(1);
+}
+
+void rbRect::setTop(const rb::Value& value)
+{
+	setComponent(1, value);
+}
+
+rb::Value rbRect::getWidth() const
+{
+	return getComponent(2);
+}
+
+void rbRect::setWidth(const rb::Value& value)
+{
+	setComponent(2, value);
+}
+
+rb::Value rbRect::getHeight() const
+{
+	return getComponent(3);
+}
+
+void rbRect::setHeight(const rb::Value& value)
+{
+	setComponent(3, value);
 }
 
 rb::Value rbRect::contains(rb::Value self, const std::vector<rb::Value>& args)
 {
-	rb::Value vector = rbVector2::getDefinition().newObject(args);
-	bool result = false;
-	rb::Value x = vector.getVar<symVarX>();
-	rb::Value y = vector.getVar<symVarY>();
-	rb::Value left = self.getVar<symVarLeft>();
-	rb::Value top = self.getVar<symVarTop>();
-	rb::Value width = self.getVar<symVarWidth>();
-	rb::Value height = self.getVar<symVarHeight>();
-
-	if( x.call<symMoreEqual>(left) == rb::True && 
-		x.call<symLess>(left.call<symAdd>(width)) == rb::True && 
-		y.call<symMoreEqual>(top) == rb::True && 
-		y.call<symLess>(top.call<symAdd>(height)) == rb::True)
+	const rbRect* object = self.to<const rbRect*>();
+	sf::Vector2f point;
+	switch( args.size() )
+	{
+		case 1:
+			point = args[0].to<sf::Vector2f>();
+			break;
+		case 2:
+			point.x = isIntegerValue(args[0]) ? args[0].to<int>() : args[0].to<float>();
+			point.y = isIntegerValue(args[1]) ? args[1].to<int>() : args[1].to<float>();
+			break;
+		default:
+			rb::expectedNumArgs( args.size(), 1, 2 );
+			break;
+	}
+
+	return object->getFloatRect().contains(point) ? rb::True : rb::False;
+}
+
+rb::Value rbRect::intersects(const rb::Value& other) const
+{
+	sf::FloatRect otherFloatRect;
+	sf::IntRect otherIntRect;
+	if(readRect(other, otherFloatRect, otherIntRect) && myIsInteger)
 	{
-		return rb::True;
+		sf::IntRect intersection;
+		if(myIntRect.intersects(otherIntRect, intersection))
+			return rb::Value::create(intersection);
 	}
 	else
 	{
-		return rb::False;
+		sf::FloatRect intersection;
+		if(getFloatRect().intersects(otherFloatRect, intersection))
+			return rb::Value::create(intersection);
 	}
+	return rb::Nil;
 }
 
-rb::Value rbRect::intersects(const rb::Value& self, const rb::Value& other)
+rb::Value rbRect::intersectInPlace(const rb::Value& other)
 {
-	rb::Value otherRect = rbRect::getDefinition().newObject(other);
-	bool result = false;
+	sf::FloatRect otherFloatRect;
+	sf::IntRect otherIntRect;
+	if(readRect(other, otherFloatRect, otherIntRect) && myIsInteger)
+	{
+		sf::IntRect intersection;
+		if(!myIntRect.intersects(otherIntRect, intersection))
+			return rb::Nil;
+		setRect(intersection);
+	}
+	else
+	{
+		sf::FloatRect intersection;
+		if(!getFloatRect().intersects(otherFloatRect, intersection))
+			return rb::Nil;
+		setRect(intersection);
+	}
+	return myValue;
+}
 
-	rb::Value myLeft = self.getVar<symVarLeft>();
-	rb::Value myTop = self.getVar<symVarTop>();
-	rb::Value myWidth = self.getVar<symVarWidth>();
-	rb::Value myHeight = self.getVar<symVarHeight>();
-	rb::Value otherLeft = otherRect.getVar<symVarLeft>();
-	rb::Value otherTop = otherRect.getVar<symVarTop>();
-	rb::Value otherWidth = otherRect.getVar<symVarWidth>();
-	rb::Value otherHeight = otherRect.getVar<symVarHeight>();
+rb::Value rbRect::unite(const rb::Value& other) const
+{
+	sf::FloatRect otherFloatRect;
+	sf::IntRect otherIntRect;
+	if(readRect(other, otherFloatRect, otherIntRect) && myIsInteger)
+		return rb::Value::create(::unite(myIntRect, otherIntRect));
+	else
+		return rb::Value::create(::unite(getFloatRect(), otherFloatRect));
+}
 
-	rb::Value left = rb::max(myLeft, otherLeft);
-	rb::Value top = rb::max(myTop, otherTop);
-	rb::Value right = rb::min(myLeft.call<symAdd>(myWidth), otherLeft.call<symAdd>(otherWidth));
-	rb::Value bottom = rb::min(myTop.call<symAdd>(myHeight), otherTop.call<symAdd>(otherHeight));
+rbRect* rbRect::uniteInPlace(const rb::Value& other)
+{
+	sf::FloatRect otherFloatRect;
+	sf::IntRect otherIntRect;
+	if(readRect(other, otherFloatRect, otherIntRect) && myIsInteger)
+		setRect(::unite(myIntRect, otherIntRect));
+	else
+		setRect(::unite(getFloatRect(), otherFloatRect));
+	return this;
+}
+
+rb::Value rbRect::expandInPlace(rb::Value self, const std::vector<rb::Value>& args)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbRect* object = self.to<rbRect*>();
+	rb::Value x;
+	rb::Value y;
+	if(args.size() == 1)
+	{
+		x = args[0];
+		y = args[0];
+	}
+	else
+	{
+		readOffset(args, x, y);
+	}
+
+	if(object->myIsInteger && isIntegerValue(x) && isIntegerValue(y))
+	{
+		int amountX = x.to<int>();
+		int amountY = y.to<int>();
+		sf::IntRect& rect = object->myIntRect;
+		object->setRect(sf::IntRect(rect.left - amountX, rect.top - amountY, rect.width + amountX * 2, rect.height + amountY * 2));
+	}
+	else
+	{
+		float amountX = isIntegerValue(x) ? x.to<int>() : x.to<float>();
+		float amountY = isIntegerValue(y) ? y.to<int>() : y.to<float>();
+		sf::FloatRect rect = object->getFloatRect();
+		object->setRect(sf::FloatRect(rect.left - amountX, rect.top - amountY, rect.width + amountX * 2, rect.height + amountY * 2));
+	}
+	return self;
+}
+
+rb::Value rbRect::translateInPlace(rb::Value self, const std::vector<rb::Value>& args)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
 
-	if(left.call<symLess>(right) == rb::True && top.call<symLess>(bottom) == rb::True)
+	rbRect* object = self.to<rbRect*>();
+	rb::Value x;
+	rb::Value y;
+	if(readOffset(args, x, y) && object->myIsInteger)
 	{
-		rb::Value intersection = ourDefinition.newObject();
-		intersection.setVar<symVarLeft>(left);
-		intersection.setVar<symVarTop>(top);
-		intersection.setVar<symVarWidth>(right.call<symSubtract>(left));
-		intersection.setVar<symVarHeight>(bottom.call<symSubtract>(top));
-		return intersection;
+		object->myIntRect.left += x.to<int>();
+		object->myIntRect.top += y.to<int>();
 	}
 	else
 	{
-		return rb::Nil;
+		sf::FloatRect rect = object->getFloatRect();
+		rect.left += isIntegerValue(x) ? x.to<int>() : x.to<float>();
+		rect.top += isIntegerValue(y) ? y.to<int>() : y.to<float>();
+		object->setRect(rect);
 	}
+	return self;
 }
 
-bool rbRect::equal(const rb::Value& self, const rb::Value& other)
+bool rbRect::equal(const rb::Value& other) const
 {
-	if(	!other.isKindOf(rb::Value(ourDefinition)) && 
+	if(	other.getType() != rb::ValueType::Data && 
 		!(other.getType() == rb::ValueType::Array && other.getArrayLength() == 4))
 		return false;
+	if(other.getType() == rb::ValueType::Data && !rb::DataType<rbRect>::isInstance(other))
+		return false;
 
-	rb::Value rect = ourDefinition.newObject(other);
-	if(!self.getVar<symVarLeft>().equal(rect.getVar<symVarLeft>())) return false;
-	if(!self.getVar<symVarTop>().equal(rect.getVar<symVarTop>())) return false;
-	if(!self.getVar<symVarWidth>().equal(rect.getVar<symVarWidth>())) return false;
-	if(!self.getVar<symVarHeight>().equal(rect.getVar<symVarHeight>())) return false;
-	return true;
+	sf::FloatRect otherFloatRect;
+	sf::IntRect otherIntRect;
+	if(readRect(other, otherFloatRect, otherIntRect) && myIsInteger)
+		return myIntRect == otherIntRect;
+	else
+		return getFloatRect() == otherFloatRect;
 }
 
-bool rbRect::strictEqual(const rb::Value& self, const rb::Value& other)
+bool rbRect::strictEqual(const rb::Value& other) const
 {
-	if(!other.isKindOf(rb::Value(ourDefinition))) return false;
-	if(self.getVar<symVarLeft>().getType() != other.getVar<symVarLeft>().getType()) return false;
-	if(self.getVar<symVarTop>().getType() != other.getVar<symVarTop>().getType()) return false;
-	if(self.getVar<symVarWidth>().getType() != other.getVar<symVarWidth>().getType()) return false;
-	if(self.getVar<symVarHeight>().getType() != other.getVar<symVarHeight>().getType()) return false;
-	return equal(self, other);
+	if(!rb::DataType<rbRect>::isInstance(other)) return false;
+	if(other.to<const rbRect*>()->myIsInteger != myIsInteger) return false;
+	return equal(other);
 }
 
-std::string rbRect::inspect(const rb::Value& self)
+std::string rbRect::inspect() const
 {
-	std::string leftStr = self.getVar<symVarLeft>().call<symInspect, std::string>();
-	std::string topStr = self.getVar<symVarTop>().call<symInspect, std::string>();
-	std::string widthStr = self.getVar<symVarWidth>().call<symInspect, std::string>();
-	std::string heightStr = self.getVar<symVarHeight>().call<symInspect, std::string>();
+	std::string leftStr = getLeft().call<symInspect, std::string>();
+	std::string topStr = getTop().call<symInspect, std::string>();
+	std::string widthStr = getWidth().call<symInspect, std::string>();
+	std::string heightStr = getHeight().call<symInspect, std::string>();
 	return ourDefinition.getName() + "(" + leftStr + ", " + topStr + ", " + widthStr + ", " + heightStr + ")";
 }
 
+bool rbRect::isInteger() const
+{
+	return myIsInteger;
+}
+
+sf::FloatRect rbRect::getFloatRect() const
+{
+	return myIsInteger ? sf::FloatRect(myIntRect) : myFloatRect;
+}
+
+sf::IntRect rbRect::getIntRect() const
+{
+	return myIsInteger ? myIntRect : sf::IntRect(myFloatRect);
+}
+
+void rbRect::setRect(const sf::FloatRect& rect)
+{
+	myIsInteger = false;
+	myFloatRect = rect;
+}
+
+void rbRect::setRect(const sf::IntRect& rect)
+{
+	myIsInteger = true;
+	myIntRect = rect;
+}
+
+rb::Value rbRect::getComponent(int index) const
+{
+	if(myIsInteger)
+		return rb::Value(component(myIntRect, index));
+	else
+		return rb::Value(component(myFloatRect, index));
+}
+
+void rbRect::setComponent(int index, const rb::Value& value)
+{
+	if(myIsInteger && isIntegerValue(value))
+	{
+		component(myIntRect, index) = value.to<int>();
+	}
+	else if(isIntegerValue(value))
+	{
+		component(myFloatRect, index) = value.to<int>();
+	}
+	else
+	{
+		float number = value.to<float>();
+		if(myIsInteger)
+			setRect(sf::FloatRect(myIntRect));
+		component(myFloatRect, index) = number;
+	}
+}
+
+void rbRect::setComponents(const rb::Value* values)
+{
+	if(isIntegerValue(values[0]) && isIntegerValue(values[1]) && isIntegerValue(values[2]) && isIntegerValue(values[3]))
+	{
+		setRect(sf::IntRect(values[0].to<int>(), values[1].to<int>(), values[2].to<int>(), values[3].to<int>()));
+	}
+	else
+	{
+		setRect(sf::FloatRect());
+		for(int index = 0; index < 4; index++)
+			setComponent(index, values[index]);
+	}
+}
+
 namespace rb
 {
 
+template<>
+rbRect* Value::to() const
+{
+	return DataType<rbRect>::fetch(myValue);
+}
+
+template<>
+const rbRect* Value::to() const
+{
+	return DataType<rbRect>::fetch(myValue);
+}
+
 template<>
 sf::FloatRect Value::to() const
 {
@@ -248,12 +552,7 @@ sf::FloatRect Value::to() const
     }
     else
     {
-        errorHandling(T_OBJECT);
-        sf::FloatRect rect(
-            getVar<symVarLeft, float>(), getVar<symVarTop, float>(),
-            getVar<symVarWidth, float>(), getVar<symVarHeight, float>()
-        );
-        return rect;
+        return to<const rbRect*>()->getFloatRect();
     }
 }
 
@@ -271,42 +570,40 @@ sf::IntRect Value::to() const
     }
     else
     {
-        errorHandling(T_OBJECT);
-        sf::IntRect rect(
-            getVar<symVarLeft, int>(), getVar<symVarTop, int>(),
-            getVar<symVarWidth, int>(), getVar<symVarHeight, int>()
-        );
-        return rect;
+        return to<const rbRect*>()->getIntRect();
     }
 }
 
-
 template<>
 Value Value::create<sf::FloatRect>( sf::FloatRect value )
 {
-	rb::Value object = rbRect::getDefinition().newObject(value.left, value.top, value.width, value.height);
+	rb::Value object = rbRect::getDefinition().allocateObject();
+	object.to<rbRect*>()->setRect(value);
 	return object;
 }
 
 template<>
 Value Value::create<const sf::FloatRect&>( const sf::FloatRect& value )
 {
-	rb::Value object = rbRect::getDefinition().newObject(value.left, value.top, value.width, value.height);
+	rb::Value object = rbRect::getDefinition().allocateObject();
+	object.to<rbRect*>()->setRect(value);
 	return object;
 }
 
 template<>
 Value Value::create<sf::IntRect>( sf::IntRect value )
 {
-	rb::Value object = rbRect::getDefinition().newObject(value.left, value.top, value.width, value.height);
+	rb::Value object = rbRect::getDefinition().allocateObject();
+	object.to<rbRect*>()->setRect(value);
 	return object;
 }
 
 template<>
 Value Value::create<const sf::IntRect&>( const sf::IntRect& value )
 {
-	rb::Value object = rbRect::getDefinition().newObject(value.left, value.top, value.width, value.height);
+	rb::Value object = rbRect::getDefinition().allocateObject();
+	object.to<rbRect*>()->setRect(value);
 	return object;
 }
 
-}
\ No newline at end of file
+}
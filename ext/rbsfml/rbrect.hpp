@@ -30,31 +30,69 @@ class rbRect;
 
 typedef rb::Class<rbRect> rbRectClass;
 
-class rbRect
+class rbRect : public rb::Object
 {
 public:
 	static void defineClass(const rb::Value& sfml);
-	static const rbRectClass& getDefinition();
+	static rbRectClass& getDefinition();
+
+	rbRect();
+	~rbRect();
 
 	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
-	static rb::Value initializeCopy(rb::Value self, const rb::Value& value);
-	static std::vector<rb::Value> marshalDump(const rb::Value& self);
-	static rb::Value marshalLoad(rb::Value self, const rb::Value& data);
+	rbRect* initializeCopy(const rbRect* value);
+
+	rb::Value binaryDump(int level) const;
+	static rb::Value binaryLoad(rb::Value klass, const rb::Value& data);
+
+	rb::Value getLeft() const;
+	void setLeft(const rb::Value& value);
+	rb::Value getTop() const;
+	void setTop(const rb::Value& value);
+	rb::Value getWidth() const;
+	void setWidth(const rb::Value& value);
+	rb::Value getHeight() const;
+	void setHeight(const rb::Value& value);
 
 	static rb::Value contains(rb::Value self, const std::vector<rb::Value>& args);
-	static rb::Value intersects(const rb::Value& self, const rb::Value& other);
+	rb::Value intersects(const rb::Value& other) const;
+	rb::Value intersectInPlace(const rb::Value& other);
+	rb::Value unite(const rb::Value& other) const;
+	rbRect* uniteInPlace(const rb::Value& other);
+	static rb::Value expandInPlace(rb::Value self, const std::vector<rb::Value>& args);
+	static rb::Value translateInPlace(rb::Value self, const std::vector<rb::Value>& args);
 
-	static bool equal(const rb::Value& self, const rb::Value& other);
-	static bool strictEqual(const rb::Value& self, const rb::Value& other);
+	bool equal(const rb::Value& other) const;
+	bool strictEqual(const rb::Value& other) const;
 
-	static std::string inspect(const rb::Value& self);
+	std::string inspect() const;
+
+	bool isInteger() const;
+	sf::FloatRect getFloatRect() const;
+	sf::IntRect getIntRect() const;
+	void setRect(const sf::FloatRect& rect);
+	void setRect(const sf::IntRect& rect);
 
 private:
+	friend class rb::Value;
+
+	rb::Value getComponent(int index) const;
+	void setComponent(int index, const rb::Value& value);
+	void setComponents(const rb::Value* values);
+
 	static rbRectClass ourDefinition;
+
+	bool myIsInteger;
+	sf::FloatRect myFloatRect;
+	sf::IntRect myIntRect;
 };
 
 namespace rb
 {
+	template<>
+	rbRect* Value::to() const;
+	template<>
+	const rbRect* Value::to() const;
 	template<>
 	sf::FloatRect Value::to() const;
 	template<>
@@ -70,4 +108,4 @@ namespace rb
 	Value Value::create<const sf::IntRect&>( const sf::IntRect& value );
 }
 
-#endif // RBSFML_RBRECT_HPP
\ No newline at end of file
+#endif // RBSFML_RBRECT_HPP
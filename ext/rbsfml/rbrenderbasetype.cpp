@@ -23,6 +23,7 @@
 #include "error.hpp"
 #include "macros.hpp"
 #include "base.hpp"
+#include <SFML/Window/Window.hpp>
 
 rbRenderBaseType::~rbRenderBaseType()
 {
@@ -32,6 +33,12 @@ rbRenderBaseType::rbRenderBaseType()
 {
 }
 
+bool rbRenderBaseType::activate(bool active)
+{
+    sf::Window* window = getWindow();
+    return window != nullptr && window->setActive(active);
+}
+
 sf::RenderTarget* rbRenderBaseType::getRenderTarget() { return nullptr; }
 const sf::RenderTarget* rbRenderBaseType::getRenderTarget() const { return nullptr; }
 
@@ -47,21 +54,13 @@ namespace rb
 template<>
 rbRenderBaseType* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbRenderBaseType* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderBaseType, object);
-	return object;
+	return DataType<rbRenderBaseType>::fetch(myValue);
 }
 
 template<>
 const rbRenderBaseType* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbRenderBaseType* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderBaseType, object);
-	return object;
+	return DataType<rbRenderBaseType>::fetch(myValue);
 }
 
 template<>
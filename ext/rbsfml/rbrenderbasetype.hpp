@@ -37,8 +37,11 @@ class rbRenderBaseType : public rb::Object
 public:
     virtual ~rbRenderBaseType();
 
+    virtual bool activate(bool active);
+
 protected:
     friend class rb::Value;
+    friend class rbAsyncCapture;
 
     rbRenderBaseType();
 
@@ -0,0 +1,251 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbrenderjob.hpp"
+#include "rbrendertexture.hpp"
+#include "gl.hpp"
+#include "base.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <SFML/Window/Context.hpp>
+#include <algorithm>
+#include <deque>
+#include <thread>
+
+namespace
+{
+	constexpr char symVarTarget[] = "@__internal__target";
+
+	// Render threads each own an sf::Context for their whole life, so SFML
+	// never has to create a transient one while a job draws.
+	class RenderQueue
+	{
+	public:
+		RenderQueue()
+		: myTasks()
+		, myThreadCount(2)
+		, myThreads()
+		, myMutex()
+		, myNotEmpty()
+		, myIsStopping(false)
+		{
+		}
+
+		~RenderQueue()
+		{
+			{
+				std::lock_guard<std::mutex> lock(myMutex);
+				myIsStopping = true;
+			}
+			myNotEmpty.notify_all();
+			for(std::thread& thread : myThreads)
+			{
+				if(thread.joinable())
+					thread.join();
+			}
+		}
+
+		void push(const std::shared_ptr<rbRenderJob::Task>& task)
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			while(myThreads.size() < myThreadCount)
+				myThreads.push_back(std::thread(&RenderQueue::work, this));
+			myTasks.push_back(task);
+			myNotEmpty.notify_one();
+		}
+
+		unsigned int getThreadCount()
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			return myThreadCount;
+		}
+
+		bool setThreadCount(unsigned int count)
+		{
+			std::lock_guard<std::mutex> lock(myMutex);
+			if(!myThreads.empty())
+				return false;
+			myThreadCount = std::max(count, 1u);
+			return true;
+		}
+
+	private:
+		void work()
+		{
+			sf::Context context;
+			for(;;)
+			{
+				std::shared_ptr<rbRenderJob::Task> task;
+				{
+					std::unique_lock<std::mutex> lock(myMutex);
+					myNotEmpty.wait(lock, [this]() { return myIsStopping || !myTasks.empty(); });
+					if(myTasks.empty())
+						return;
+					task = myTasks.front();
+					myTasks.pop_front();
+				}
+				process(*task);
+			}
+		}
+
+		void process(rbRenderJob::Task& task)
+		{
+			sf::RenderTexture& target = *task.target;
+			bool success = target.setActive(true);
+			if(success)
+			{
+				if(task.isClearing)
+					target.clear(task.clearColor);
+				for(const rbRenderJob::Draw& draw : task.draws)
+					target.draw(*draw.drawable, draw.states);
+				target.display();
+				// Other contexts only see the result once it reached the GPU.
+				glFlush();
+				target.setActive(false);
+			}
+			task.draws.clear();
+
+			std::lock_guard<std::mutex> lock(task.mutex);
+			task.isSuccess = success;
+			task.isDone = true;
+			task.condition.notify_all();
+		}
+
+		std::deque<std::shared_ptr<rbRenderJob::Task>> myTasks;
+		unsigned int myThreadCount;
+		std::vector<std::thread> myThreads;
+		std::mutex myMutex;
+		std::condition_variable myNotEmpty;
+		bool myIsStopping;
+	};
+
+	RenderQueue& getRenderQueue()
+	{
+		static RenderQueue queue;
+		return queue;
+	}
+}
+
+rbRenderJobClass rbRenderJob::ourDefinition;
+
+void rbRenderJob::defineClass(const rb::Value& renderTexture)
+{
+	ourDefinition = rbRenderJobClass::defineClassUnder("RenderJob", renderTexture);
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderJob::isDone)>("done?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderJob::wait)>("wait");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderJob::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderJob::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbRenderJobClass& rbRenderJob::getDefinition()
+{
+	return ourDefinition;
+}
+
+void rbRenderJob::enqueue(const std::shared_ptr<Task>& task)
+{
+	getRenderQueue().push(task);
+}
+
+void rbRenderJob::waitFor(const std::shared_ptr<Task>& task)
+{
+	rb::waitWithoutGVL(task->mutex, task->condition, [task]() { return task->isDone; });
+}
+
+bool rbRenderJob::isFinished(const std::shared_ptr<Task>& task)
+{
+	std::lock_guard<std::mutex> lock(task->mutex);
+	return task->isDone;
+}
+
+unsigned int rbRenderJob::getThreadCount()
+{
+	return getRenderQueue().getThreadCount();
+}
+
+void rbRenderJob::setThreadCount(unsigned int count)
+{
+	if(!getRenderQueue().setThreadCount(count))
+		rb::raise(rb::RuntimeError, "can't change the number of render threads once they are running");
+}
+
+rbRenderJob::rbRenderJob()
+: rb::Object()
+, myTask()
+{
+}
+
+rbRenderJob::~rbRenderJob()
+{
+}
+
+bool rbRenderJob::isDone() const
+{
+	return !myTask || isFinished(myTask);
+}
+
+rb::Value rbRenderJob::wait()
+{
+	rb::Value target = myValue.getVar<symVarTarget>();
+	if(!myTask)
+		return rb::Nil;
+
+	waitFor(myTask);
+	if(!myTask->isSuccess)
+		rb::raise(rb::RuntimeError, "failed to activate the render texture on a render thread");
+	return target.to<const rbRenderTexture*>()->getTexture();
+}
+
+rb::Value rbRenderJob::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbRenderJob::inspect() const
+{
+	return ourDefinition.getName() + "(" + (isDone() ? "done" : "pending") + ")";
+}
+
+void rbRenderJob::setTask(const std::shared_ptr<Task>& task, const rb::Value& target)
+{
+	myTask = task;
+	myValue.setVar<symVarTarget>(target);
+}
+
+namespace rb
+{
+
+template<>
+rbRenderJob* Value::to() const
+{
+	return DataType<rbRenderJob>::fetch(myValue);
+}
+
+template<>
+const rbRenderJob* Value::to() const
+{
+	return DataType<rbRenderJob>::fetch(myValue);
+}
+
+}
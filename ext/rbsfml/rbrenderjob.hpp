@@ -0,0 +1,97 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBRENDERJOB_HPP_
+#define RBSFML_RBRENDERJOB_HPP_
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbRenderJob;
+
+typedef rb::Class<rbRenderJob> rbRenderJobClass;
+
+class rbRenderJob : public rb::Object
+{
+public:
+	struct Draw
+	{
+		std::unique_ptr<sf::Drawable> drawable;
+		sf::RenderStates states;
+	};
+
+	// Everything a render thread needs, copied out of Ruby up front so the
+	// thread never has to take the GVL.
+	struct Task
+	{
+		sf::RenderTexture* target;
+		std::vector<Draw> draws;
+		bool isClearing;
+		sf::Color clearColor;
+		bool isDone;
+		bool isSuccess;
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+
+	static void defineClass(const rb::Value& renderTexture);
+	static rbRenderJobClass& getDefinition();
+
+	static void enqueue(const std::shared_ptr<Task>& task);
+	static void waitFor(const std::shared_ptr<Task>& task);
+	static bool isFinished(const std::shared_ptr<Task>& task);
+	static unsigned int getThreadCount();
+	static void setThreadCount(unsigned int count);
+
+	rbRenderJob();
+	~rbRenderJob();
+
+	bool isDone() const;
+	rb::Value wait();
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+	void setTask(const std::shared_ptr<Task>& task, const rb::Value& target);
+
+private:
+	static rbRenderJobClass ourDefinition;
+
+	std::shared_ptr<Task> myTask;
+};
+
+namespace rb
+{
+	template<>
+	rbRenderJob* Value::to() const;
+	template<>
+	const rbRenderJob* Value::to() const;
+}
+
+#endif // RBSFML_RBRENDERJOB_HPP_
@@ -34,6 +34,11 @@ namespace
 	constexpr char symVarTransform[] = "@transform";
 	constexpr char symVarTexture[] = "@texture";
 	constexpr char symVarShader[] = "@shader";
+	constexpr char symVarInternalPool[] = "@__internal__pool";
+	constexpr char symVarInternalTransform[] = "@__internal__transform";
+	constexpr char symVarInternalBlendMode[] = "@__internal__blend_mode";
+
+	constexpr char symPush[] = "push";
 }
 
 rbRenderStatesClass rbRenderStates::ourDefinition;
@@ -41,9 +46,9 @@ rbRenderStatesClass rbRenderStates::ourDefinition;
 void rbRenderStates::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbRenderStatesClass::defineClassUnder<rb::RubyObjAllocator>("RenderStates", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbRenderStates::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbRenderStates::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbRenderStates::marshalDump);
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderStates::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderStates::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderStates::marshalDump)>("marshal_dump");
 
 	ourDefinition.defineAttribute("blend_mode", true, true);
 	ourDefinition.defineAttribute("transform", true, true);
@@ -71,15 +76,15 @@ rb::Value rbRenderStates::initialize(rb::Value self, const std::vector<rb::Value
         	{
         		self.setVar<symVarBlendMode>(args[0]);
         	}
-        	else if(args[0].isKindOf(rb::Value(rbTransform::getDefinition())))
+        	else if(rb::DataType<rbTransform>::isInstance(args[0]))
             {
                 self.setVar<symVarTransform>(args[0]);
             }
-            else if(args[0].isKindOf(rb::Value(rbTexture::getDefinition())))
+            else if(rb::DataType<rbTexture>::isInstance(args[0]))
             {
                 self.setVar<symVarTexture>(args[0]);
             }
-            else if(args[0].isKindOf(rb::Value(rbShader::getDefinition())))
+            else if(rb::DataType<rbShader>::isInstance(args[0]))
             {
                 self.setVar<symVarShader>(args[0]);
             }
@@ -111,7 +116,39 @@ rb::Value rbRenderStates::initializeCopy(rb::Value self, const rb::Value& value)
 	return self;
 }
 
-rb::Value rbRenderStates::marshalDump() const
+// Hands out a copy of states that is reused by every draw at the same nesting
+// depth, so drawing a Ruby drawable doesn't allocate new states each time.
+// Each slot owns its transform and blend mode and only their values are copied
+// in, so changing them in place can't reach the states being copied. The copy
+// is only valid until the next draw at the same depth.
+rb::Value rbRenderStates::copyForDepth(const rb::Value& states, unsigned int depth)
+{
+	rb::Value klass(ourDefinition);
+	if(klass.getVar<symVarInternalPool>() == rb::Nil)
+		klass.setVar<symVarInternalPool>(std::vector<rb::Value>());
+
+	rb::Value pool = klass.getVar<symVarInternalPool>();
+	while(static_cast<unsigned int>(pool.getArrayLength()) <= depth)
+	{
+		rb::Value slot = ourDefinition.newObject();
+		slot.setVar<symVarInternalTransform>(slot.getVar<symVarTransform, rb::Value>());
+		slot.setVar<symVarInternalBlendMode>(slot.getVar<symVarBlendMode, rb::Value>());
+		pool.call<symPush>(slot);
+	}
+
+	rb::Value copy(rb_ary_entry(pool.to<VALUE>(), depth));
+	rb::Value transform = copy.getVar<symVarInternalTransform, rb::Value>();
+	rb::Value blendMode = copy.getVar<symVarInternalBlendMode, rb::Value>();
+	transform.to<sf::Transform&>() = states.getVar<symVarTransform, const sf::Transform&>();
+	rbBlendMode::assign(blendMode, states.getVar<symVarBlendMode, sf::BlendMode>());
+	copy.setVar<symVarBlendMode>(blendMode);
+	copy.setVar<symVarTransform>(transform);
+	copy.setVar<symVarTexture>(states.getVar<symVarTexture, rb::Value>());
+	copy.setVar<symVarShader>(states.getVar<symVarShader, rb::Value>());
+	return copy;
+}
+
+rb::Value rbRenderStates::marshalDump(rb::Value)
 {
 	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str() );
 	return rb::Nil;
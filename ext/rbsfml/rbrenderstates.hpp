@@ -38,7 +38,8 @@ public:
 
 	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
 	static rb::Value initializeCopy(rb::Value self, const rb::Value& value);
-	rb::Value marshalDump() const;
+	static rb::Value copyForDepth(const rb::Value& states, unsigned int depth);
+	static rb::Value marshalDump(rb::Value self);
 
 private:
 	static rbRenderStatesClass ourDefinition;
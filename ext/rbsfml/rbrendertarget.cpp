@@ -30,12 +30,30 @@
 #include "error.hpp"
 #include "macros.hpp"
 
+#include <unordered_map>
+
 namespace
 {
     constexpr char symVarInternalDrawStack[] = "@@__internal_draw_stack";
+    constexpr char symVarInternalTargetRefs[] = "@@__internal_target_refs";
+    constexpr char symVarInternalDefaultStates[] = "@@__internal_default_states";
+    constexpr char symVarInternalView[] = "@__internal__view";
+    constexpr char symVarInternalDefaultView[] = "@__internal__default_view";
 
     constexpr char symPush[] = "push";
     constexpr char symPop[] = "pop";
+
+    // Refs handed to Ruby drawables, one per target they were drawn on. The
+    // module keeps them alive in an array, this only speeds up the lookup.
+    std::unordered_map<const sf::RenderTarget*, rbRenderTargetRef*> targetRefs;
+
+    // Unlike sf::Rect::intersects this counts touching edges as overlap, so
+    // zero width or height bounds (axis aligned lines, points) stay visible.
+    bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b)
+    {
+        return a.left <= b.left + b.width && b.left <= a.left + a.width &&
+               a.top <= b.top + b.height && b.top <= a.top + a.height;
+    }
 }
 
 rbRenderTargetModule rbRenderTarget::ourDefinition;
@@ -45,17 +63,22 @@ void rbRenderTarget::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbRenderTargetModule::defineModuleUnder("RenderTarget", sfml);
 	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
-	ourDefinition.defineMethod<0>("clear", &rbRenderTarget::clear);
-	ourDefinition.defineMethod<1>("view=", &rbRenderTarget::setView);
-	ourDefinition.defineMethod<2>("view", &rbRenderTarget::getView);
-	ourDefinition.defineMethod<3>("default_view", &rbRenderTarget::getDefaultView);
-	ourDefinition.defineMethod<4>("get_viewport", &rbRenderTarget::getViewport);
-	ourDefinition.defineMethod<5>("map_pixel_to_coords", &rbRenderTarget::mapPixelToCoords);
-	ourDefinition.defineMethod<6>("map_coords_to_pixel", &rbRenderTarget::mapCoordsToPixel);
-	ourDefinition.defineMethod<7>("push_gl_states", &rbRenderTarget::pushGLStates);
-	ourDefinition.defineMethod<8>("pop_gl_states", &rbRenderTarget::popGLStates);
-	ourDefinition.defineMethod<9>("reset_gl_states", &rbRenderTarget::resetGLStates);
-	ourDefinition.defineMethod<10>("draw", &rbRenderTarget::draw);
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::clear)>("clear");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::setView)>("view=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::getView)>("view");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::getDefaultView)>("default_view");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::getViewInto)>("view_into");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::getDefaultViewInto)>("default_view_into");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::getViewport)>("get_viewport");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::mapPixelToCoords)>("map_pixel_to_coords");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::mapCoordsToPixel)>("map_coords_to_pixel");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::pushGLStates)>("push_gl_states");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::popGLStates)>("pop_gl_states");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::resetGLStates)>("reset_gl_states");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::draw)>("draw");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::setCulling)>("culling=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::isCulling)>("culling?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTarget::getCulledCount)>("culled_count");
 
 	ourRefDefinition = rbRenderTargetRefClass::defineClassUnder("RenderTargetRef", sfml);
 	ourRefDefinition.includeModule(rb::Value(ourDefinition));
@@ -71,8 +94,48 @@ rbRenderTargetRefClass& rbRenderTarget::getRefDefinition()
     return ourRefDefinition;
 }
 
+rb::Value rbRenderTarget::getRef(sf::RenderTarget& target)
+{
+    auto iterator = targetRefs.find(&target);
+    if(iterator != targetRefs.end())
+        return iterator->second->myValue;
+
+    rb::Value module(ourDefinition);
+    if(module.getVar<symVarInternalTargetRefs>() == rb::Nil)
+        module.setVar<symVarInternalTargetRefs>(std::vector<rb::Value>());
+
+    // Drop the refs of targets destroyed since the last new ref was made.
+    VALUE refs = module.getVar<symVarInternalTargetRefs>().to<VALUE>();
+    long kept = 0;
+    for(long index = 0, length = RARRAY_LEN(refs); index < length; index++)
+    {
+        VALUE entry = rb_ary_entry(refs, index);
+        if(rb::Value(entry).to<const rbRenderTargetRef*>()->myObject != nullptr)
+            rb_ary_store(refs, kept++, entry);
+    }
+    rb_ary_resize(refs, kept);
+
+    rb::Value ref = ourRefDefinition.newObject();
+    ref.to<rbRenderTargetRef*>()->setRef(&target);
+    rb_ary_push(refs, ref.to<VALUE>());
+    targetRefs[&target] = ref.to<rbRenderTargetRef*>();
+    return ref;
+}
+
+void rbRenderTarget::releaseRef(const sf::RenderTarget& target)
+{
+    auto iterator = targetRefs.find(&target);
+    if(iterator == targetRefs.end())
+        return;
+
+    iterator->second->myObject = nullptr;
+    targetRefs.erase(iterator);
+}
+
 rbRenderTarget::rbRenderTarget()
 : rbRenderBaseType()
+, myCulling(false)
+, myCulledCount(0)
 {
 }
 
@@ -93,6 +156,7 @@ rb::Value rbRenderTarget::clear(rb::Value self, const std::vector<rb::Value>& ar
             rb::expectedNumArgs( args.size(), 0, 1 );
     }
     self.to<sf::RenderTarget&>().clear(color);
+    self.to<rbRenderTarget*>()->myCulledCount = 0;
     return rb::Nil;
 }
 
@@ -102,18 +166,38 @@ void rbRenderTarget::setView(const rbView* view)
     getRenderTarget()->setView(val);
 }
 
-rbView* rbRenderTarget::getView() const
+rb::Value rbRenderTarget::getView() const
 {
-    rb::Value object = rbView::getDefinition().newObject();
-    object.to<sf::View&>() = getRenderTarget()->getView();
-    return object.to<rbView*>();
+    rb::Value self(myValue);
+    rb::Value cache = self.getVar<symVarInternalView>();
+    if(rbView::refreshFrozen(cache, getRenderTarget()->getView()) && !self.isFrozen())
+        self.setVar<symVarInternalView>(cache);
+    return cache;
 }
 
-rbView* rbRenderTarget::getDefaultView() const
+rb::Value rbRenderTarget::getDefaultView() const
 {
-    rb::Value object = rbView::getDefinition().newObject();
-    object.to<sf::View&>() = getRenderTarget()->getDefaultView();
-    return object.to<rbView*>();
+    rb::Value self(myValue);
+    rb::Value cache = self.getVar<symVarInternalDefaultView>();
+    if(rbView::refreshFrozen(cache, getRenderTarget()->getDefaultView()) && !self.isFrozen())
+        self.setVar<symVarInternalDefaultView>(cache);
+    return cache;
+}
+
+rb::Value rbRenderTarget::getViewInto(rb::Value view) const
+{
+    if(view.isFrozen())
+        rb::modifiedFrozen(view);
+    view.to<sf::View&>() = getRenderTarget()->getView();
+    return view;
+}
+
+rb::Value rbRenderTarget::getDefaultViewInto(rb::Value view) const
+{
+    if(view.isFrozen())
+        rb::modifiedFrozen(view);
+    view.to<sf::View&>() = getRenderTarget()->getDefaultView();
+    return view;
 }
 
 sf::IntRect rbRenderTarget::getViewport(const rbView* view)
@@ -180,17 +264,23 @@ rb::Value rbRenderTarget::draw(rb::Value self, const std::vector<rb::Value>& arg
     if(rb::Value(ourDefinition).getVar<symVarInternalDrawStack>() == rb::Nil)
     {
         rb::Value(ourDefinition).setVar<symVarInternalDrawStack>(std::vector<rb::Value>());
+        // Ruby drawables get value copies of the stack, never the entries
+        // themselves, so draws without states can share one default states.
+        rb::Value(ourDefinition).setVar<symVarInternalDefaultStates>(rbRenderStates::getDefinition().newObject());
     }
 
     rb::Value internalDrawStack = rb::Value(ourDefinition).getVar<symVarInternalDrawStack>();
 
     sf::RenderTarget& target = self.to<sf::RenderTarget&>();
+    rbRenderTarget* object = self.to<rbRenderTarget*>();
     switch(args.size())
     {
         case 1:
             if(args[0].isKindOf(rb::Value(rbDrawable::getDefinition())))
             {
-                internalDrawStack.call<symPush>(rbRenderStates::getDefinition().newObject());
+                if(object->cull(args[0], sf::RenderStates::Default))
+                    break;
+                internalDrawStack.call<symPush>(rb::Value(ourDefinition).getVar<symVarInternalDefaultStates>());
                 target.draw(args[0].to<const sf::Drawable&>());
                 internalDrawStack.call<symPop>();
             }
@@ -202,8 +292,11 @@ rb::Value rbRenderTarget::draw(rb::Value self, const std::vector<rb::Value>& arg
         case 2:
             if(args[0].isKindOf(rb::Value(rbDrawable::getDefinition())))
             {
+                sf::RenderStates states = args[1].to<sf::RenderStates>();
+                if(object->cull(args[0], states))
+                    break;
                 internalDrawStack.call<symPush>(args[1]);
-                target.draw(args[0].to<const sf::Drawable&>(), args[1].to<sf::RenderStates>());
+                target.draw(args[0].to<const sf::Drawable&>(), states);
                 internalDrawStack.call<symPop>();
             }
             else
@@ -235,11 +328,50 @@ rb::Value rbRenderTarget::draw(rb::Value self, const std::vector<rb::Value>& arg
     return rb::Nil;
 }
 
+void rbRenderTarget::setCulling(bool culling)
+{
+    myCulling = culling;
+}
+
+bool rbRenderTarget::isCulling() const
+{
+    return myCulling;
+}
+
+unsigned int rbRenderTarget::getCulledCount() const
+{
+    return myCulledCount;
+}
+
+bool rbRenderTarget::cull(const rb::Value& drawable, const sf::RenderStates& states)
+{
+    if(!myCulling || !rb::DataType<rbDrawableBaseType>::isInstance(drawable))
+        return false;
+
+    sf::FloatRect bounds;
+    if(!drawable.to<const rbDrawableBaseType*>()->getCullingBounds(bounds))
+        return false;
+
+    bounds = states.transform.transformRect(bounds);
+    if(overlaps(bounds, rbView::getWorldRect(getRenderTarget()->getView())))
+        return false;
+
+    myCulledCount++;
+    return true;
+}
+
 rbRenderTargetRef::rbRenderTargetRef()
 : myObject(nullptr)
 {
 }
 
+// Ruby may free us before our target when the process exits.
+rbRenderTargetRef::~rbRenderTargetRef()
+{
+    if(myObject)
+        targetRefs.erase(myObject);
+}
+
 void rbRenderTargetRef::setRef(sf::RenderTarget* object)
 {
     myObject = object;
@@ -247,11 +379,15 @@ void rbRenderTargetRef::setRef(sf::RenderTarget* object)
 
 sf::RenderTarget* rbRenderTargetRef::getRenderTarget()
 {
+    if(!myObject)
+        rb::raise(rb::RuntimeError, "render target has been destroyed");
     return myObject;
 }
 
 const sf::RenderTarget* rbRenderTargetRef::getRenderTarget() const
 {
+    if(!myObject)
+        rb::raise(rb::RuntimeError, "render target has been destroyed");
     return myObject;
 }
 
@@ -261,41 +397,25 @@ namespace rb
 template<>
 rbRenderTarget* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbRenderTarget* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderTarget, object);
-	return object;
+	return DataType<rbRenderTarget>::fetch(myValue);
 }
 
 template<>
 const rbRenderTarget* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbRenderTarget* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderTarget, object);
-	return object;
+	return DataType<rbRenderTarget>::fetch(myValue);
 }
 
 template<>
 rbRenderTargetRef* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbRenderTargetRef* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderTargetRef, object);
-	return object;
+	return DataType<rbRenderTargetRef>::fetch(myValue);
 }
 
 template<>
 const rbRenderTargetRef* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbRenderTargetRef* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderTargetRef, object);
-	return object;
+	return DataType<rbRenderTargetRef>::fetch(myValue);
 }
 
 }
\ No newline at end of file
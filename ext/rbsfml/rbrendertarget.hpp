@@ -40,14 +40,19 @@ public:
 	static rbRenderTargetModule& getDefinition();
 	static rbRenderTargetRefClass& getRefDefinition();
 
+	static rb::Value getRef(sf::RenderTarget& target);
+	static void releaseRef(const sf::RenderTarget& target);
+
 	rbRenderTarget();
 	virtual ~rbRenderTarget();
 
 	static rb::Value clear(rb::Value self, const std::vector<rb::Value>& args);
 
 	void setView(const rbView* view);
-	rbView* getView() const;
-	rbView* getDefaultView() const;
+	rb::Value getView() const;
+	rb::Value getDefaultView() const;
+	rb::Value getViewInto(rb::Value view) const;
+	rb::Value getDefaultViewInto(rb::Value view) const;
 
 	sf::IntRect getViewport(const rbView* view);
 
@@ -62,16 +67,27 @@ public:
 
 	static rb::Value draw(rb::Value self, const std::vector<rb::Value>& args);
 
+	void setCulling(bool culling);
+	bool isCulling() const;
+	unsigned int getCulledCount() const;
+
 private:
     friend class rb::Value;
+
+    bool cull(const rb::Value& drawable, const sf::RenderStates& states);
+
 	static rbRenderTargetModule ourDefinition;
 	static rbRenderTargetRefClass ourRefDefinition;
+
+	bool myCulling;
+	unsigned int myCulledCount;
 };
 
 class rbRenderTargetRef : public rbRenderTarget
 {
 public:
     rbRenderTargetRef();
+    ~rbRenderTargetRef();
 
     void setRef(sf::RenderTarget* object);
 
@@ -80,6 +96,8 @@ protected:
     virtual const sf::RenderTarget* getRenderTarget() const;
 
 private:
+    friend class rbRenderTarget;
+
     sf::RenderTarget* myObject;
 };
 
@@ -21,6 +21,9 @@
 
 #include "rbrendertexture.hpp"
 #include "rbtexture.hpp"
+#include "rbcolor.hpp"
+#include "rbrenderstates.hpp"
+#include "rbdrawablebasetype.hpp"
 #include "rbvector2.hpp"
 #include "error.hpp"
 #include "macros.hpp"
@@ -29,6 +32,9 @@
 namespace
 {
     constexpr char symVarInternalOwnerRef[] = "@__internal__owner_ref";
+    constexpr char symVarInternalTexture[] = "@__internal__texture";
+    constexpr char symVarInternalRenderJob[] = "@__internal__render_job";
+    constexpr char symVarTexture[] = "@texture";
 
     class rbTextureRefAllocator
     {
@@ -40,13 +46,6 @@ namespace
             rbTexture* object = new(memory) rbTexture(texture);
             return object;
         }
-
-        static void free(void* memory)
-        {
-            rbTexture* object = static_cast<rbTexture*>(memory);
-            object->~rbTexture();
-            xfree(memory);
-        }
     };
 }
 
@@ -56,16 +55,22 @@ void rbRenderTexture::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbRenderTextureClass::defineClassUnder("RenderTexture", sfml);
 	ourDefinition.includeModule(rb::Value(rbRenderTarget::getDefinition()));
-	ourDefinition.defineMethod<0>("initialize", &rbRenderTexture::initialize);
-	ourDefinition.defineMethod<1>("create", &rbRenderTexture::create);
-	ourDefinition.defineMethod<2>("smooth=", &rbRenderTexture::setSmooth);
-	ourDefinition.defineMethod<3>("smooth?", &rbRenderTexture::isSmooth);
-	ourDefinition.defineMethod<4>("repeated=", &rbRenderTexture::setRepeated);
-    ourDefinition.defineMethod<5>("repeated?", &rbRenderTexture::isRepeated);
-    ourDefinition.defineMethod<6>("set_active", &rbRenderTexture::setActive);
-    ourDefinition.defineMethod<7>("display", &rbRenderTexture::display);
-	ourDefinition.defineMethod<8>("size", &rbRenderTexture::getSize);
-	ourDefinition.defineMethod<9>("texture", &rbRenderTexture::getTexture);
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::create)>("create");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::setSmooth)>("smooth=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::isSmooth)>("smooth?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::setRepeated)>("repeated=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::isRepeated)>("repeated?");
+    ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::setActive)>("set_active");
+    ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::display)>("display");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::getSize)>("size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::getTexture)>("texture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::renderAsync)>("render_async");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderTexture::isBusy)>("busy?");
+	ourDefinition.defineFunction<RBSFML_FN(&rbRenderTexture::getRenderThreads)>("render_threads");
+	ourDefinition.defineFunction<RBSFML_FN(&rbRenderTexture::setRenderThreads)>("render_threads=");
+
+	rbRenderJob::defineClass(rb::Value(ourDefinition));
 
 	ourDefinition.aliasMethod("set_active", "active=");
 }
@@ -78,11 +83,19 @@ rbRenderTextureClass& rbRenderTexture::getDefinition()
 rbRenderTexture::rbRenderTexture()
 : rbRenderTarget()
 , myObject()
+, myRenderTask()
 {
 }
 
+// A render thread may still be drawing into us.
 rbRenderTexture::~rbRenderTexture()
 {
+    if(myRenderTask)
+    {
+        std::unique_lock<std::mutex> lock(myRenderTask->mutex);
+        myRenderTask->condition.wait(lock, [this]() { return myRenderTask->isDone; });
+    }
+    rbRenderTarget::releaseRef(myObject);
 }
 
 rb::Value rbRenderTexture::initialize(rb::Value self, const std::vector<rb::Value>& args)
@@ -125,12 +138,14 @@ rb::Value rbRenderTexture::create(rb::Value self, const std::vector<rb::Value>&
             rb::expectedNumArgs(args.size(), 2, 3);
             break;
     }
+    self.to<rbRenderTexture*>()->checkIdle();
     self.to<rbRenderTexture*>()->myObject.create(width, height, depthBuffer);
     return self;
 }
 
 void rbRenderTexture::setSmooth(bool smooth)
 {
+    checkIdle();
     myObject.setSmooth(smooth);
 }
 
@@ -141,6 +156,7 @@ bool rbRenderTexture::isSmooth() const
 
 void rbRenderTexture::setRepeated(bool repeated)
 {
+    checkIdle();
     myObject.setRepeated(repeated);
 }
 
@@ -162,12 +178,14 @@ rb::Value rbRenderTexture::setActive(rb::Value self, const std::vector<rb::Value
             rb::expectedNumArgs(args.size(), 0, 1);
             break;
     }
+    self.to<rbRenderTexture*>()->checkIdle();
     self.to<rbRenderTexture*>()->myObject.setActive(flag);
     return self;
 }
 
 void rbRenderTexture::display()
 {
+    checkIdle();
     myObject.display();
 }
 
@@ -176,18 +194,134 @@ sf::Vector2u rbRenderTexture::getSize() const
     return myObject.getSize();
 }
 
+// The render texture never replaces its texture, so the wrapper is created once.
 rb::Value rbRenderTexture::getTexture() const
 {
     rb::Value self(this);
+    rb::Value cache = self.getVar<symVarInternalTexture>();
+    if(!cache.isNil())
+        return cache;
+
     rbTexture* object = rbTextureRefAllocator::allocate(const_cast<sf::Texture*>(&myObject.getTexture()));
-    rb::Value value = rbTexture::getDefinition().newObjectWithObject<rbTextureRefAllocator>(object);
+    rb::Value value = rbTexture::getDefinition().newObjectWithObject(object);
     value.setVar<symVarInternalOwnerRef>(self);
+    if(isBusy())
+        object->pin(myRenderTask);
     value.freeze();
+    if(!self.isFrozen())
+        self.setVar<symVarInternalTexture>(value);
     return value;
 }
 
+// render_async(drawables, clear_color = Color::Black) draws on one of the
+// render threads and returns a RenderJob. Drawables are copied right away, an
+// entry can also be a [drawable, states] pair. A nil clear color keeps the
+// current contents.
+rb::Value rbRenderTexture::renderAsync(rb::Value self, const std::vector<rb::Value>& args)
+{
+    if(self.isFrozen())
+        rb::modifiedFrozen(self);
+
+    rbRenderTexture* object = self.to<rbRenderTexture*>();
+    object->checkIdle();
+
+    std::shared_ptr<rbRenderJob::Task> task = std::make_shared<rbRenderJob::Task>();
+    task->target = &object->myObject;
+    task->isClearing = true;
+    task->clearColor = sf::Color::Black;
+    task->isDone = false;
+    task->isSuccess = false;
+    switch(args.size())
+    {
+        case 2:
+            task->isClearing = !args[1].isNil();
+            if(task->isClearing)
+                task->clearColor = args[1].to<sf::Color>();
+        case 1:
+            break;
+        default:
+            rb::expectedNumArgs(args.size(), 1, 2);
+            break;
+    }
+
+    // The clones only point at their textures, those are pinned until the job is done.
+    std::vector<rb::Value> textures;
+    for(const rb::Value& entry : args[0].to<std::vector<rb::Value>>())
+    {
+        rbRenderJob::Draw draw;
+        rb::Value drawable = entry;
+        if(entry.getType() == rb::ValueType::Array)
+        {
+            if(entry.getArrayLength() != 2)
+                rb::raise(rb::ArgumentError, "expected a [drawable, states] pair");
+            const std::vector<rb::Value>& pair = entry.to<const std::vector<rb::Value>&>();
+            drawable = pair[0];
+            draw.states = pair[1].to<sf::RenderStates>();
+            // Shaders can be changed or reloaded at any time from Ruby.
+            if(draw.states.shader)
+                rb::raise(rb::ArgumentError, "render states with a shader can't be used on a render thread");
+            if(draw.states.texture)
+                textures.push_back(pair[1].getVar<symVarTexture>());
+        }
+        const rbDrawableBaseType* source = drawable.to<const rbDrawableBaseType*>();
+        draw.drawable = source->cloneDrawable();
+        if(!draw.drawable)
+            rb::raise(rb::TypeError, "%s can't be drawn on a render thread", drawable.getClassName().c_str());
+        if(!source->getTexture().isNil())
+            textures.push_back(source->getTexture());
+        task->draws.push_back(std::move(draw));
+    }
+    if(!self.getVar<symVarInternalTexture>().isNil())
+        textures.push_back(self.getVar<symVarInternalTexture>());
+
+    // The context can only be current on one thread at a time.
+    object->myObject.setActive(false);
+    object->myRenderTask = task;
+    for(const rb::Value& texture : textures)
+        texture.to<rbTexture*>()->pin(task);
+    self.setVar<symVarInternalRenderJob>(args[0]);
+    rbRenderJob::enqueue(task);
+
+    rb::Value job = rbRenderJob::getDefinition().newObject();
+    job.to<rbRenderJob*>()->setTask(task, self);
+    return job;
+}
+
+bool rbRenderTexture::isBusy() const
+{
+    return myRenderTask && !rbRenderJob::isFinished(myRenderTask);
+}
+
+unsigned int rbRenderTexture::getRenderThreads()
+{
+    return rbRenderJob::getThreadCount();
+}
+
+void rbRenderTexture::setRenderThreads(unsigned int count)
+{
+    rbRenderJob::setThreadCount(count);
+}
+
+void rbRenderTexture::checkIdle()
+{
+    if(!myRenderTask)
+        return;
+    if(!rbRenderJob::isFinished(myRenderTask))
+        rb::raise(rb::RuntimeError, "%s is being rendered on a render thread, wait for the job first", ourDefinition.getName().c_str());
+    myRenderTask.reset();
+}
+
+bool rbRenderTexture::activate(bool active)
+{
+    checkIdle();
+    return myObject.setActive(active);
+}
+
+// Everything that draws into us or makes our context current comes through
+// here, so none of it can race a render thread.
 sf::RenderTarget* rbRenderTexture::getRenderTarget()
 {
+    checkIdle();
     return &myObject;
 }
 
@@ -202,21 +336,13 @@ namespace rb
 template<>
 rbRenderTexture* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbRenderTexture* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderTexture, object);
-	return object;
+	return DataType<rbRenderTexture>::fetch(myValue);
 }
 
 template<>
 const rbRenderTexture* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbRenderTexture* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderTexture, object);
-	return object;
+	return DataType<rbRenderTexture>::fetch(myValue);
 }
 
 }
\ No newline at end of file
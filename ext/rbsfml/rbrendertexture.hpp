@@ -25,6 +25,7 @@
 #include <SFML/Graphics/RenderTexture.hpp>
 #include "class.hpp"
 #include "rbrendertarget.hpp"
+#include "rbrenderjob.hpp"
 
 class rbRenderTexture;
 class rbTexture;
@@ -57,6 +58,13 @@ public:
 
 	rb::Value getTexture() const;
 
+	static rb::Value renderAsync(rb::Value self, const std::vector<rb::Value>& args);
+	bool isBusy() const;
+	static unsigned int getRenderThreads();
+	static void setRenderThreads(unsigned int count);
+
+	bool activate(bool active);
+
 protected:
     sf::RenderTarget* getRenderTarget();
     const sf::RenderTarget* getRenderTarget() const;
@@ -64,9 +72,12 @@ protected:
 private:
 	friend class rb::Value;
 
+	void checkIdle();
+
 	static rbRenderTextureClass ourDefinition;
 
 	sf::RenderTexture myObject;
+	std::shared_ptr<rbRenderJob::Task> myRenderTask;
 };
 
 namespace rb
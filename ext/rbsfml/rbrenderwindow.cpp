@@ -21,10 +21,32 @@
 
 #include "rbrenderwindow.hpp"
 #include "rbimage.hpp"
+#include "rbframe.hpp"
+#include "rbfixedstep.hpp"
 #include "rbvector2.hpp"
 #include "error.hpp"
 #include "macros.hpp"
 #include "base.hpp"
+#include <SFML/System/Clock.hpp>
+#include <thread>
+
+namespace
+{
+	constexpr char symTargetFps[] = "target_fps";
+	constexpr char symFixedDt[] = "fixed_dt";
+
+	const sf::Int64 SpinThreshold = 1500;
+
+	void waitUntil(const sf::Clock& clock, sf::Int64 deadline)
+	{
+		sf::Int64 remaining = deadline - clock.getElapsedTime().asMicroseconds();
+		if(remaining > SpinThreshold)
+			rb::sleepWithoutGVL(remaining - SpinThreshold);
+
+		while(clock.getElapsedTime().asMicroseconds() < deadline)
+			std::this_thread::yield();
+	}
+}
 
 rbRenderWindowClass rbRenderWindow::ourDefinition;
 
@@ -32,8 +54,9 @@ void rbRenderWindow::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbRenderWindowClass::defineClassUnder("RenderWindow", sfml, rb::Value(rbWindow::getDefinition()));
 	ourDefinition.includeModule(rb::Value(rbRenderTarget::getDefinition()));
-	ourDefinition.defineMethod<0>("size", &rbRenderWindow::getSize);
-	ourDefinition.defineMethod<1>("capture", &rbRenderWindow::capture);
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderWindow::getSize)>("size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderWindow::capture)>("capture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbRenderWindow::run)>("run");
 }
 
 rbRenderWindowClass& rbRenderWindow::getDefinition()
@@ -50,6 +73,7 @@ rbRenderWindow::rbRenderWindow()
 
 rbRenderWindow::~rbRenderWindow()
 {
+    rbRenderTarget::releaseRef(myObject);
 }
 
 sf::Vector2u rbRenderWindow::getSize() const
@@ -64,6 +88,65 @@ rb::Value rbRenderWindow::capture() const
     return value;
 }
 
+rb::Value rbRenderWindow::run(rb::Value self, const std::vector<rb::Value>& args)
+{
+	if(args.size() > 1)
+		rb::expectedNumArgs( args.size(), 0, 1 );
+	if(!rb::blockGiven())
+		rb::raise(rb::ArgumentError, "no block given");
+
+	sf::Int64 frameDuration = 0;
+	rb::Value fixedStep = rb::Nil;
+	if(args.size() == 1)
+	{
+		if(args[0].getType() != rb::ValueType::Hash)
+			rb::expectedTypes("Hash");
+
+		rb::Value targetFps = args[0].getHashEntry<symTargetFps>();
+		rb::Value fixedDt = args[0].getHashEntry<symFixedDt>();
+		if(!targetFps.isNil())
+		{
+			double fps = targetFps.getType() == rb::ValueType::Fixnum ? targetFps.to<int>() : targetFps.to<double>();
+			if(fps > 0)
+				frameDuration = static_cast<sf::Int64>(1000000.0 / fps);
+		}
+		if(!fixedDt.isNil())
+			fixedStep = rbFixedStep::getDefinition().newObject(fixedDt);
+	}
+
+	rbRenderWindow* object = self.to<rbRenderWindow*>();
+	rb::Value frameValue = rbFrame::getDefinition().newObject();
+	rbFrame* frame = frameValue.to<rbFrame*>();
+	frame->setFixedStep(fixedStep);
+
+	sf::Clock clock;
+	sf::Int64 previous = 0;
+	sf::Int64 deadline = frameDuration;
+	while(object->myObject.isOpen() && !frame->isStopped())
+	{
+		sf::Int64 now = clock.getElapsedTime().asMicroseconds();
+		frame->begin(now - previous);
+		previous = now;
+
+		rb::yield(frameValue);
+		if(!object->myObject.isOpen() || frame->isStopped())
+			break;
+
+		object->myObject.display();
+		frame->end();
+
+		if(frameDuration > 0)
+		{
+			waitUntil(clock, deadline);
+			deadline += frameDuration;
+			if(clock.getElapsedTime().asMicroseconds() > deadline)
+				deadline = clock.getElapsedTime().asMicroseconds() + frameDuration;
+		}
+	}
+
+	return self;
+}
+
 sf::RenderTarget* rbRenderWindow::getRenderTarget()
 {
     return &myObject;
@@ -100,21 +183,13 @@ namespace rb
 template<>
 rbRenderWindow* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbRenderWindow* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderWindow, object);
-	return object;
+	return DataType<rbRenderWindow>::fetch(myValue);
 }
 
 template<>
 const rbRenderWindow* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbRenderWindow* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRenderWindow, object);
-	return object;
+	return DataType<rbRenderWindow>::fetch(myValue);
 }
 
 }
\ No newline at end of file
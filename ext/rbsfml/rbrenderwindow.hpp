@@ -46,6 +46,8 @@ public:
 
 	rb::Value capture() const;
 
+	static rb::Value run(rb::Value self, const std::vector<rb::Value>& args);
+
 protected:
     sf::RenderTarget* getRenderTarget();
     const sf::RenderTarget* getRenderTarget() const;
@@ -0,0 +1,357 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbscenenode.hpp"
+#include "rbtransform.hpp"
+#include "rbnoncopyable.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+namespace
+{
+	constexpr char symVarInternalChildren[] = "@__internal__children";
+	constexpr char symVarInternalParent[] = "@__internal__parent";
+	constexpr char symVarInternalDrawable[] = "@__internal__drawable";
+
+	constexpr char symPush[] = "push";
+	constexpr char symDelete[] = "delete";
+}
+
+rbSceneNodeClass rbSceneNode::ourDefinition;
+
+void rbSceneNode::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbSceneNodeClass::defineClassUnder("SceneNode", sfml);
+	ourDefinition.includeModule(rb::Value(rbDrawable::getDefinition()));
+	ourDefinition.includeModule(rb::Value(rbTransformable::getDefinition()));
+	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::attach)>("attach");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::detach)>("detach");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::getParent)>("parent");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::getChildren)>("children");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::getChildCount)>("child_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::setContent)>("drawable=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::getContent)>("drawable");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::setZOrder)>("z_order=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::getZOrder)>("z_order");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::setVisible)>("visible=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::isVisible)>("visible?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSceneNode::getWorldTransform)>("world_transform");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+	ourDefinition.aliasMethod("attach", "<<");
+}
+
+rbSceneNodeClass& rbSceneNode::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbSceneNode::rbSceneNode()
+: rbTransformable()
+, myObject(*this)
+, myParent(nullptr)
+, myChildren()
+, myContent(nullptr)
+, myZOrder(0)
+, myVisible(true)
+, myWorld()
+, myWorldDirty(true)
+, myWorldVersion(0)
+, myParentVersion(0)
+{
+}
+
+rbSceneNode::~rbSceneNode()
+{
+}
+
+rb::Value rbSceneNode::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	self.setVar<symVarInternalChildren>(std::vector<rb::Value>());
+	switch(args.size())
+	{
+		case 0:
+			break;
+		case 1:
+			setContent(self, args[0]);
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 0, 1);
+			break;
+	}
+
+	return self;
+}
+
+std::string rbSceneNode::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myChildren.size()) + ")";
+}
+
+rb::Value rbSceneNode::attach(rb::Value self, const rb::Value& child)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbSceneNode* node = self.to<rbSceneNode*>();
+	rbSceneNode* childNode = child.to<rbSceneNode*>();
+	if(childNode == node || childNode->isAncestorOf(node))
+		rb::raise(rb::ArgumentError, "can't attach a %s to itself or one of its descendants", ourDefinition.getName().c_str());
+
+	if(childNode->myParent != nullptr)
+		childNode->myParent->removeChild(childNode);
+
+	self.getVar<symVarInternalChildren>().call<symPush>(child);
+	childNode->myValue.setVar<symVarInternalParent>(self);
+	childNode->myParent = node;
+	childNode->myWorldDirty = true;
+	node->myChildren.push_back(childNode);
+	node->sortChildren();
+	return child;
+}
+
+rb::Value rbSceneNode::detach(rb::Value self, const rb::Value& child)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbSceneNode* node = self.to<rbSceneNode*>();
+	rbSceneNode* childNode = child.to<rbSceneNode*>();
+	if(childNode->myParent != node)
+		rb::raise(rb::ArgumentError, "given %s is not a child of this node", child.getClassName().c_str());
+
+	node->removeChild(childNode);
+	return child;
+}
+
+rb::Value rbSceneNode::getParent() const
+{
+	return myParent ? myParent->myValue : rb::Nil;
+}
+
+rb::Value rbSceneNode::getChildren() const
+{
+	std::vector<rb::Value> children;
+	children.reserve(myChildren.size());
+	for(const rbSceneNode* child : myChildren)
+		children.push_back(child->myValue);
+	return rb::Value::create(children);
+}
+
+unsigned int rbSceneNode::getChildCount() const
+{
+	return myChildren.size();
+}
+
+rb::Value rbSceneNode::setContent(rb::Value self, const rb::Value& drawable)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbSceneNode* node = self.to<rbSceneNode*>();
+	if(drawable.isNil())
+	{
+		node->myContent = nullptr;
+	}
+	else
+	{
+		const rbDrawableBaseType* content = drawable.to<const rbDrawableBaseType*>();
+		if(dynamic_cast<const rbSceneNode*>(content) != nullptr)
+			rb::raise(rb::ArgumentError, "attach a %s as a child instead", ourDefinition.getName().c_str());
+		// Ruby defined drawables are drawn with the states on the draw stack,
+		// which wouldn't include the node's world transform.
+		if(dynamic_cast<const rbDrawable*>(content) != nullptr)
+			rb::raise(rb::TypeError, "%s can only hold native drawables", ourDefinition.getName().c_str());
+		node->myContent = &drawable.to<const sf::Drawable&>();
+	}
+	self.setVar<symVarInternalDrawable>(drawable);
+	return drawable;
+}
+
+rb::Value rbSceneNode::getContent() const
+{
+	return myValue.getVar<symVarInternalDrawable>();
+}
+
+void rbSceneNode::setZOrder(int order)
+{
+	myZOrder = order;
+	if(myParent != nullptr)
+		myParent->sortChildren();
+}
+
+int rbSceneNode::getZOrder() const
+{
+	return myZOrder;
+}
+
+void rbSceneNode::setVisible(bool visible)
+{
+	myVisible = visible;
+}
+
+bool rbSceneNode::isVisible() const
+{
+	return myVisible;
+}
+
+rb::Value rbSceneNode::getWorldTransform()
+{
+	updateWorld();
+	rb::Value object = rbTransform::getDefinition().newObject();
+	object.to<sf::Transform&>() = myWorld;
+	return object;
+}
+
+sf::Drawable* rbSceneNode::getDrawable()
+{
+	return &myObject;
+}
+
+const sf::Drawable* rbSceneNode::getDrawable() const
+{
+	return &myObject;
+}
+
+sf::Transformable* rbSceneNode::getTransformable()
+{
+	return &myObject;
+}
+
+const sf::Transformable* rbSceneNode::getTransformable() const
+{
+	return &myObject;
+}
+
+void rbSceneNode::onTransformChanged()
+{
+	myWorldDirty = true;
+}
+
+rbSceneNode::Renderer::Renderer(rbSceneNode& owner)
+: sf::Drawable()
+, sf::Transformable()
+, myOwner(owner)
+{
+}
+
+void rbSceneNode::Renderer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	// The draw can start below the root, whose ancestors drawTree won't visit.
+	myOwner.updateWorld();
+	myOwner.drawTree(target, states);
+}
+
+bool rbSceneNode::isAncestorOf(const rbSceneNode* node) const
+{
+	for(const rbSceneNode* parent = node->myParent; parent != nullptr; parent = parent->myParent)
+	{
+		if(parent == this)
+			return true;
+	}
+	return false;
+}
+
+void rbSceneNode::removeChild(rbSceneNode* child)
+{
+	myChildren.erase(std::find(myChildren.begin(), myChildren.end(), child));
+	myValue.getVar<symVarInternalChildren>().call<symDelete>(child->myValue);
+	child->myValue.setVar<symVarInternalParent>(rb::Nil);
+	child->myParent = nullptr;
+	child->myWorldDirty = true;
+}
+
+void rbSceneNode::sortChildren()
+{
+	std::stable_sort(myChildren.begin(), myChildren.end(), [](const rbSceneNode* left, const rbSceneNode* right)
+	{
+		return left->myZOrder < right->myZOrder;
+	});
+}
+
+// Recomputes the world transform when the node or its parent changed. The
+// parent must be up to date already; every recompute bumps the version, which
+// is how children notice that they are out of date.
+void rbSceneNode::refresh()
+{
+	if(myParent != nullptr && myParent->myWorldVersion != myParentVersion)
+		myWorldDirty = true;
+	if(!myWorldDirty)
+		return;
+
+	const sf::Transform& local = myObject.getTransform();
+	if(myParent != nullptr)
+	{
+		myWorld = myParent->myWorld * local;
+		myParentVersion = myParent->myWorldVersion;
+	}
+	else
+	{
+		myWorld = local;
+	}
+	myWorldVersion++;
+	myWorldDirty = false;
+}
+
+void rbSceneNode::updateWorld()
+{
+	if(myParent != nullptr)
+		myParent->updateWorld();
+	refresh();
+}
+
+void rbSceneNode::drawTree(sf::RenderTarget& target, const sf::RenderStates& states)
+{
+	refresh();
+	if(!myVisible)
+		return;
+
+	if(myContent != nullptr)
+	{
+		sf::RenderStates local(states);
+		local.transform *= myWorld;
+		target.draw(*myContent, local);
+	}
+	for(rbSceneNode* child : myChildren)
+		child->drawTree(target, states);
+}
+
+namespace rb
+{
+
+template<>
+rbSceneNode* Value::to() const
+{
+	return DataType<rbSceneNode>::fetch(myValue);
+}
+
+template<>
+const rbSceneNode* Value::to() const
+{
+	return DataType<rbSceneNode>::fetch(myValue);
+}
+
+}
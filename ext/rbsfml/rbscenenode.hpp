@@ -0,0 +1,120 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBSCENENODE_HPP_
+#define RBSFML_RBSCENENODE_HPP_
+
+#include "class.hpp"
+#include "rbdrawable.hpp"
+#include "rbtransformable.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+
+class rbSceneNode;
+
+typedef rb::Class<rbSceneNode> rbSceneNodeClass;
+
+class rbSceneNode : public rbTransformable
+{
+public:
+	static void defineClass(const rb::Value& sfml);
+	static rbSceneNodeClass& getDefinition();
+
+	rbSceneNode();
+	~rbSceneNode();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+
+	std::string inspect() const;
+
+	static rb::Value attach(rb::Value self, const rb::Value& child);
+	static rb::Value detach(rb::Value self, const rb::Value& child);
+	rb::Value getParent() const;
+	rb::Value getChildren() const;
+	unsigned int getChildCount() const;
+
+	static rb::Value setContent(rb::Value self, const rb::Value& drawable);
+	rb::Value getContent() const;
+
+	void setZOrder(int order);
+	int getZOrder() const;
+
+	void setVisible(bool visible);
+	bool isVisible() const;
+
+	rb::Value getWorldTransform();
+
+protected:
+	virtual sf::Drawable* getDrawable();
+	virtual const sf::Drawable* getDrawable() const;
+
+	virtual sf::Transformable* getTransformable();
+	virtual const sf::Transformable* getTransformable() const;
+
+	virtual void onTransformChanged();
+
+private:
+	friend class rb::Value;
+
+	class Renderer : public sf::Drawable, public sf::Transformable
+	{
+	public:
+		explicit Renderer(rbSceneNode& owner);
+
+	private:
+		virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+		rbSceneNode& myOwner;
+	};
+
+	bool isAncestorOf(const rbSceneNode* node) const;
+	void removeChild(rbSceneNode* child);
+	void sortChildren();
+
+	void refresh();
+	void updateWorld();
+	void drawTree(sf::RenderTarget& target, const sf::RenderStates& states);
+
+	static rbSceneNodeClass ourDefinition;
+
+	Renderer myObject;
+	rbSceneNode* myParent;
+	std::vector<rbSceneNode*> myChildren;
+	const sf::Drawable* myContent;
+	int myZOrder;
+	bool myVisible;
+
+	sf::Transform myWorld;
+	bool myWorldDirty;
+	unsigned int myWorldVersion;
+	unsigned int myParentVersion;
+};
+
+namespace rb
+{
+	template<>
+	rbSceneNode* Value::to() const;
+	template<>
+	const rbSceneNode* Value::to() const;
+}
+
+#endif // RBSFML_RBSCENENODE_HPP_
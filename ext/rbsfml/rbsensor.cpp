@@ -29,9 +29,9 @@ rbSensorModule rbSensor::ourDefinition;
 void rbSensor::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbSensorModule::defineModuleUnder("Sensor", sfml);
-	ourDefinition.defineFunction<0>("available?", &sf::Sensor::isAvailable);
-	ourDefinition.defineFunction<1>("set_enabled", &sf::Sensor::setEnabled);
-	ourDefinition.defineFunction<2>("get_value", &sf::Sensor::getValue);
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Sensor::isAvailable)>("available?");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Sensor::setEnabled)>("set_enabled");
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Sensor::getValue)>("get_value");
 
 	ourDefinition.defineConstant("Accelerometer", rb::Value(sf::Sensor::Accelerometer));
 	ourDefinition.defineConstant("Gyroscope", rb::Value(sf::Sensor::Gyroscope));
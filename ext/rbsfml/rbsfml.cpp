@@ -25,6 +25,7 @@
 #include "class.hpp"
 #include "rbtime.hpp"
 #include "rbclock.hpp"
+#include "rbfixedstep.hpp"
 #include "rbnoncopyable.hpp"
 #include "rbvector2.hpp"
 #include "rbvector3.hpp"
@@ -33,22 +34,30 @@
 #include "rbcontext.hpp"
 #include "rbwindow.hpp"
 #include "rbevent.hpp"
+#include "rbeventlog.hpp"
 #include "rbjoystick.hpp"
 #include "rbkeyboard.hpp"
 #include "rbmouse.hpp"
 #include "rbsensor.hpp"
 #include "rbtouch.hpp"
+#include "rbinput.hpp"
 #include "rbcolor.hpp"
 #include "rbblendmode.hpp"
 #include "rbtransform.hpp"
 #include "rbview.hpp"
 #include "rbimage.hpp"
+#include "rbimagesaverequest.hpp"
+#include "rbasynccapture.hpp"
+#include "rbframerecorder.hpp"
 #include "rbtexture.hpp"
 #include "rbshader.hpp"
+#include "rbshaderuniform.hpp"
+#include "rbuniformblock.hpp"
 #include "rbrenderstates.hpp"
 #include "rbrendertarget.hpp"
 #include "rbvertex.hpp"
 #include "rbrenderwindow.hpp"
+#include "rbframe.hpp"
 #include "rbtransformable.hpp"
 #include "rbdrawable.hpp"
 #include "rbsprite.hpp"
@@ -60,6 +69,11 @@
 #include "rbrect.hpp"
 #include "rbrendertexture.hpp"
 #include "rbvertexarray.hpp"
+#include "rbspatialhash.hpp"
+#include "rbparticlesystem.hpp"
+#include "rbtilemap.hpp"
+#include "rbscenenode.hpp"
+#include "marshal.hpp"
 
 class rbSFML
 {
@@ -68,15 +82,27 @@ public:
 	{
 		sf::sleep(time->getObject());
 	}
+
+	static bool getMarshalCompression()
+	{
+		return marshal::isCompressionEnabled();
+	}
+
+	static void setMarshalCompression(bool enabled)
+	{
+		marshal::setCompressionEnabled(enabled);
+	}
 };
 
 extern "C" void Init_rbsfml() {
 	auto sfml = rb::Module<rbSFML>::defineModule("SFML");
 
-	sfml.defineFunction<0>("seconds", &rbTime::seconds);
-	sfml.defineFunction<1>("milliseconds", &rbTime::milliseconds);
-	sfml.defineFunction<2>("microseconds", &rbTime::microseconds);
-	sfml.defineFunction<3>("sleep", &rbSFML::sleep);
+	sfml.defineFunction<RBSFML_FN(&rbTime::seconds)>("seconds");
+	sfml.defineFunction<RBSFML_FN(&rbTime::milliseconds)>("milliseconds");
+	sfml.defineFunction<RBSFML_FN(&rbTime::microseconds)>("microseconds");
+	sfml.defineFunction<RBSFML_FN(&rbSFML::sleep)>("sleep");
+	sfml.defineFunction<RBSFML_FN(&rbSFML::getMarshalCompression)>("marshal_compression");
+	sfml.defineFunction<RBSFML_FN(&rbSFML::setMarshalCompression)>("marshal_compression=");
 
 	sfml.defineConstant("Points", rb::Value::create(sf::Points));
     sfml.defineConstant("Lines", rb::Value::create(sf::Lines));
@@ -93,6 +119,7 @@ extern "C" void Init_rbsfml() {
 	rbVector3::defineClass(rb::Value(sfml));
 	rbTime::defineClass(rb::Value(sfml));
 	rbClock::defineClass(rb::Value(sfml));
+	rbFixedStep::defineClass(rb::Value(sfml));
 
 	// Window
 	rbVideoMode::defineClass(rb::Value(sfml));
@@ -100,11 +127,13 @@ extern "C" void Init_rbsfml() {
 	rbContext::defineClass(rb::Value(sfml));
 	rbWindow::defineClass(rb::Value(sfml));
 	rbEvent::defineClass(rb::Value(sfml));
+	rbEventLog::defineClass(rb::Value(sfml));
 	rbJoystick::defineModule(rb::Value(sfml));
 	rbKeyboard::defineModule(rb::Value(sfml));
 	rbMouse::defineModule(rb::Value(sfml));
 	rbSensor::defineModule(rb::Value(sfml));
 	rbTouch::defineModule(rb::Value(sfml));
+	rbInput::defineClass(rb::Value(sfml));
 
 	// Graphics
 	rbRect::defineClass(rb::Value(sfml));
@@ -113,12 +142,16 @@ extern "C" void Init_rbsfml() {
 	rbTransform::defineClass(rb::Value(sfml));
 	rbView::defineClass(rb::Value(sfml));
 	rbImage::defineClass(rb::Value(sfml));
+	rbImageSaveRequest::defineClass(rb::Value(rbImage::getDefinition()));
 	rbTexture::defineClass(rb::Value(sfml));
 	rbShader::defineClass(rb::Value(sfml));
+	rbShaderUniform::defineClass(rb::Value(rbShader::getDefinition()));
+	rbUniformBlock::defineClass(rb::Value(rbShader::getDefinition()));
 	rbRenderStates::defineClass(rb::Value(sfml));
 	rbRenderTarget::defineModule(rb::Value(sfml));
 	rbVertex::defineClass(rb::Value(sfml));
 	rbRenderWindow::defineClass(rb::Value(sfml));
+	rbFrame::defineClass(rb::Value(sfml));
 	rbTransformable::defineModule(rb::Value(sfml));
 	rbDrawable::defineModule(rb::Value(sfml));
 	rbSprite::defineClass(rb::Value(sfml));
@@ -127,7 +160,13 @@ extern "C" void Init_rbsfml() {
 	rbText::defineClass(rb::Value(sfml));
 	rbShape::defineClass(rb::Value(sfml));
 	rbRenderTexture::defineClass(rb::Value(sfml));
+	rbAsyncCapture::defineClass(rb::Value(sfml));
+	rbFrameRecorder::defineClass(rb::Value(sfml));
 	rbVertexArray::defineClass(rb::Value(sfml));
+	rbSpatialHash::defineClass(rb::Value(sfml));
+	rbParticleSystem::defineClass(rb::Value(sfml));
+	rbTileMap::defineClass(rb::Value(sfml));
+	rbSceneNode::defineClass(rb::Value(sfml));
 
 	rbDrawable::defineIncludeFunction();
 	rbTransformable::defineIncludeFunction();
@@ -20,6 +20,8 @@
  */
 
 #include "rbshader.hpp"
+#include "rbshaderuniform.hpp"
+#include "rbuniformblock.hpp"
 #include "rbvector2.hpp"
 #include "rbvector3.hpp"
 #include "rbcolor.hpp"
@@ -28,6 +30,23 @@
 #include "rbnoncopyable.hpp"
 #include "error.hpp"
 #include "macros.hpp"
+#include "shadercache.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    bool readFile(const std::string& filename, std::string& contents)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if(!file)
+            return false;
+        std::ostringstream stream;
+        stream << file.rdbuf();
+        contents = stream.str();
+        return true;
+    }
+}
 
 rbShaderClass rbShader::ourDefinition;
 rb::Module<sf::Shader::CurrentTextureType> rbShader::ourCurrentTextureTypeDefinition;
@@ -36,13 +55,19 @@ void rbShader::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbShaderClass::defineClassUnder("Shader", sfml);
 	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
-	ourDefinition.defineMethod<0>("load_from_file", &rbShader::loadFromFile);
-    ourDefinition.defineMethod<1>("load_from_memory", &rbShader::loadFromMemory);
-    ourDefinition.defineMethod<2>("set_parameter", &rbShader::setParameter);
-    ourDefinition.defineMethod<3>("native_handle", &rbShader::getNativeHandle);
+	ourDefinition.defineMethod<RBSFML_FN(&rbShader::loadFromFile)>("load_from_file");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShader::loadFromMemory)>("load_from_memory");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShader::setParameter)>("set_parameter");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShader::getNativeHandle)>("native_handle");
 
-    ourDefinition.defineFunction<4>("bind", &rbShader::bind);
-    ourDefinition.defineFunction<5>("available?", &rbShader::isAvailable);
+    ourDefinition.defineFunction<RBSFML_FN(&rbShader::bind)>("bind");
+    ourDefinition.defineFunction<RBSFML_FN(&rbShader::isAvailable)>("available?");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShader::getUniform)>("uniform");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShader::setParameters)>("set_parameters");
+    ourDefinition.defineFunction<RBSFML_FN(&rbShader::getCacheDirectory)>("cache_directory");
+    ourDefinition.defineFunction<RBSFML_FN(&rbShader::setCacheDirectory)>("cache_directory=");
+    ourDefinition.defineFunction<RBSFML_FN(&rbShader::getCacheHitCount)>("cache_hits");
+    ourDefinition.defineFunction<RBSFML_FN(&rbShader::getCacheMissCount)>("cache_misses");
 
     ourDefinition.aliasMethod("set_parameter", "[]=");
 
@@ -60,6 +85,8 @@ rbShaderClass& rbShader::getDefinition()
 rbShader::rbShader()
 : rb::Object()
 , myObject()
+, myUniforms()
+, myLoadCount(0)
 {
 }
 
@@ -69,6 +96,21 @@ rbShader::~rbShader()
 
 bool rbShader::loadFromFile(rb::Value arg1, rb::Value arg2)
 {
+    myUniforms.reset();
+    myLoadCount++;
+    ShaderCache& cache = ShaderCache::getShared();
+    if(cache.isEnabled())
+    {
+        std::string first, second;
+        if(!readFile(arg1.to<std::string>(), first))
+            return false;
+        if(arg2.getType() == rb::ValueType::Fixnum)
+            return arg2.to<sf::Shader::Type>() == sf::Shader::Vertex ? cache.load(myObject, first, "") : cache.load(myObject, "", first);
+        if(!readFile(arg2.to<std::string>(), second))
+            return false;
+        return cache.load(myObject, first, second);
+    }
+
     if(arg2.getType() == rb::ValueType::Fixnum)
         return myObject.loadFromFile(arg1.to<std::string>(), arg2.to<sf::Shader::Type>());
     else
@@ -77,6 +119,16 @@ bool rbShader::loadFromFile(rb::Value arg1, rb::Value arg2)
 
 bool rbShader::loadFromMemory(rb::Value arg1, rb::Value arg2)
 {
+    myUniforms.reset();
+    myLoadCount++;
+    ShaderCache& cache = ShaderCache::getShared();
+    if(cache.isEnabled())
+    {
+        if(arg2.getType() == rb::ValueType::Fixnum)
+            return arg2.to<sf::Shader::Type>() == sf::Shader::Vertex ? cache.load(myObject, arg1.to<std::string>(), "") : cache.load(myObject, "", arg1.to<std::string>());
+        return cache.load(myObject, arg1.to<std::string>(), arg2.to<std::string>());
+    }
+
     if(arg2.getType() == rb::ValueType::Fixnum)
         return myObject.loadFromMemory(arg1.to<std::string>(), arg2.to<sf::Shader::Type>());
     else
@@ -86,6 +138,7 @@ bool rbShader::loadFromMemory(rb::Value arg1, rb::Value arg2)
 rb::Value rbShader::setParameter(rb::Value self, const std::vector<rb::Value>& args)
 {
     sf::Shader& shader = self.to<sf::Shader&>();
+    self.to<rbShader*>()->myUniforms.invalidate();
     switch(args.size())
     {
         case 2:
@@ -101,15 +154,15 @@ rb::Value rbShader::setParameter(rb::Value self, const std::vector<rb::Value>& a
             {
                 shader.setParameter(args[0].to<std::string>(), args[1].to<sf::Color>());
             }
-            else if(args[1].isKindOf(rb::Value(rbTransform::getDefinition())))
+            else if(rb::DataType<rbTransform>::isInstance(args[1]))
             {
                 shader.setParameter(args[0].to<std::string>(), args[1].to<const sf::Transform&>());
             }
-            else if(args[1].isKindOf(rb::Value(rbTexture::getDefinition())))
+            else if(rb::DataType<rbTexture>::isInstance(args[1]))
             {
                 shader.setParameter(args[0].to<std::string>(), args[1].to<const sf::Texture&>());
             }
-            else if(args[1] == rb::Value(ourCurrentTextureTypeDefinition))
+            else if(isCurrentTexture(args[1]))
             {
                 shader.setParameter(args[0].to<std::string>(), sf::Shader::CurrentTexture);
             }
@@ -134,11 +187,28 @@ rb::Value rbShader::setParameter(rb::Value self, const std::vector<rb::Value>& a
     return rb::Nil;
 }
 
+unsigned int rbShader::setParameters(const rb::Value& values)
+{
+    if(rb::DataType<rbUniformBlock>::isInstance(values))
+        return myUniforms.apply(myObject, values.to<const rbUniformBlock*>()->getValues());
+
+    if(values.getType() != rb::ValueType::Hash)
+        rb::expectedTypes("Hash", "SFML::Shader::UniformBlock");
+    UniformList list;
+    rbUniformBlock::collect(values, list);
+    return myUniforms.apply(myObject, list);
+}
+
 unsigned int rbShader::getNativeHandle() const
 {
     return myObject.getNativeHandle();
 }
 
+rb::Value rbShader::getUniform(rb::Value self, const std::string& name)
+{
+    return rbShaderUniform::create(self, name);
+}
+
 void rbShader::bind(const rbShader* shader)
 {
     if(shader)
@@ -152,27 +222,55 @@ bool rbShader::isAvailable()
     return sf::Shader::isAvailable();
 }
 
+rb::Value rbShader::getCacheDirectory()
+{
+    const ShaderCache& cache = ShaderCache::getShared();
+    return cache.isEnabled() ? rb::Value(cache.getDirectory()) : rb::Nil;
+}
+
+void rbShader::setCacheDirectory(const rb::Value& directory)
+{
+    ShaderCache::getShared().setDirectory(directory.isNil() ? std::string() : directory.to<std::string>());
+}
+
+unsigned int rbShader::getCacheHitCount()
+{
+    return ShaderCache::getShared().getHitCount();
+}
+
+unsigned int rbShader::getCacheMissCount()
+{
+    return ShaderCache::getShared().getMissCount();
+}
+
+UniformCache& rbShader::getUniformCache()
+{
+    return myUniforms;
+}
+
+unsigned int rbShader::getLoadCount() const
+{
+    return myLoadCount;
+}
+
+bool rbShader::isCurrentTexture(const rb::Value& value)
+{
+    return value == rb::Value(ourCurrentTextureTypeDefinition);
+}
+
 namespace rb
 {
 
 template<>
 rbShader* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbShader* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbShader, object);
-	return object;
+	return DataType<rbShader>::fetch(myValue);
 }
 
 template<>
 const rbShader* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbShader* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbShader, object);
-	return object;
+	return DataType<rbShader>::fetch(myValue);
 }
 
 template<>
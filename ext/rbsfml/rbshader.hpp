@@ -25,6 +25,7 @@
 #include <SFML/Graphics/Shader.hpp>
 #include "class.hpp"
 #include "object.hpp"
+#include "uniformcache.hpp"
 
 class rbShader;
 
@@ -43,11 +44,23 @@ public:
 	bool loadFromMemory(rb::Value arg1, rb::Value arg2);
 
 	static rb::Value setParameter(rb::Value self, const std::vector<rb::Value>& args);
+	unsigned int setParameters(const rb::Value& values);
 
 	unsigned int getNativeHandle() const;
+	static rb::Value getUniform(rb::Value self, const std::string& name);
 
 	static void bind(const rbShader* shader);
 	static bool isAvailable();
+	static bool isCurrentTexture(const rb::Value& value);
+
+	static rb::Value getCacheDirectory();
+	static void setCacheDirectory(const rb::Value& directory);
+	static unsigned int getCacheHitCount();
+	static unsigned int getCacheMissCount();
+
+	UniformCache& getUniformCache();
+	// Bumped by every load, since the driver may reuse the old program name.
+	unsigned int getLoadCount() const;
 
 private:
     friend class rb::Value;
@@ -55,6 +68,8 @@ private:
 	static rb::Module<sf::Shader::CurrentTextureType> ourCurrentTextureTypeDefinition;
 
 	sf::Shader myObject;
+	UniformCache myUniforms;
+	unsigned int myLoadCount;
 };
 
 namespace rb
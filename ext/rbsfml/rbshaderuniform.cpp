@@ -0,0 +1,343 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "gl.hpp"
+#include "rbshaderuniform.hpp"
+#include "rbshader.hpp"
+#include "rbvector2.hpp"
+#include "rbvector3.hpp"
+#include "rbcolor.hpp"
+#include "rbtexture.hpp"
+#include "rbtransform.hpp"
+#include "rbnoncopyable.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+
+namespace
+{
+	constexpr char symVarShader[] = "@__internal__shader";
+	constexpr char symVarTexture[] = "@__internal__texture";
+
+	const char* getTypeName(GLenum type)
+	{
+		switch(type)
+		{
+			case GL_FLOAT:        return "float";
+			case GL_FLOAT_VEC2:   return "vec2";
+			case GL_FLOAT_VEC3:   return "vec3";
+			case GL_FLOAT_VEC4:   return "vec4";
+			case GL_INT:          return "int";
+			case GL_BOOL:         return "bool";
+			case GL_FLOAT_MAT3:   return "mat3";
+			case GL_FLOAT_MAT4:   return "mat4";
+			case GL_SAMPLER_2D:   return "sampler2D";
+			default:              return "unknown";
+		}
+	}
+
+	void getFloats(const std::vector<rb::Value>& args, float* values, unsigned int count)
+	{
+		if(args.size() == 1)
+		{
+			if(count == 2 && args[0].isKindOf(rb::Value(rbVector2::getDefinition())))
+			{
+				sf::Vector2f vector = args[0].to<sf::Vector2f>();
+				values[0] = vector.x;
+				values[1] = vector.y;
+				return;
+			}
+			if(count == 3 && args[0].isKindOf(rb::Value(rbVector3::getDefinition())))
+			{
+				sf::Vector3f vector = args[0].to<sf::Vector3f>();
+				values[0] = vector.x;
+				values[1] = vector.y;
+				values[2] = vector.z;
+				return;
+			}
+			if(count == 4 && args[0].isKindOf(rb::Value(rbColor::getDefinition())))
+			{
+				sf::Color color = args[0].to<sf::Color>();
+				values[0] = color.r / 255.f;
+				values[1] = color.g / 255.f;
+				values[2] = color.b / 255.f;
+				values[3] = color.a / 255.f;
+				return;
+			}
+		}
+
+		if(args.size() != count)
+			rb::expectedNumArgs(args.size(), 1, count);
+		for(unsigned int index = 0; index < count; index++)
+			values[index] = args[index].to<float>();
+	}
+}
+
+rbShaderUniformClass rbShaderUniform::ourDefinition;
+
+void rbShaderUniform::defineClass(const rb::Value& shader)
+{
+	ourDefinition = rbShaderUniformClass::defineClassUnder("Uniform", shader);
+	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::getName)>("name");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::getLocation)>("location");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::isActive)>("active?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setFloat)>("set_float");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setVec2)>("set_vec2");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setVec3)>("set_vec3");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setVec4)>("set_vec4");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setInt)>("set_int");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setColor)>("set_color");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setMat3)>("set_mat3");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setMat4)>("set_mat4");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::setTexture)>("set_texture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShaderUniform::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbShaderUniformClass& rbShaderUniform::getDefinition()
+{
+	return ourDefinition;
+}
+
+rb::Value rbShaderUniform::create(const rb::Value& shader, const std::string& name)
+{
+	rb::Value value = ourDefinition.newObject();
+	rbShaderUniform* object = value.to<rbShaderUniform*>();
+	object->myOwner = shader.to<const rbShader*>();
+	object->myShader = &shader.to<sf::Shader&>();
+	object->myCache = &shader.to<rbShader*>()->getUniformCache();
+	object->myName = name;
+	value.setVar<symVarShader>(shader);
+	return value;
+}
+
+rbShaderUniform::rbShaderUniform()
+: rb::Object()
+, myOwner(nullptr)
+, myShader(nullptr)
+, myCache(nullptr)
+, myName()
+, myProgram(0)
+, myLoadCount(0)
+, myLocation(-1)
+, myType(0)
+{
+}
+
+rbShaderUniform::~rbShaderUniform()
+{
+}
+
+const std::string& rbShaderUniform::getName() const
+{
+	return myName;
+}
+
+bool rbShaderUniform::isActive()
+{
+	resolve();
+	return myLocation != -1;
+}
+
+int rbShaderUniform::getLocation()
+{
+	resolve();
+	return myLocation;
+}
+
+void rbShaderUniform::setFloat(float value)
+{
+	upload(GL_FLOAT, "set_float", [=](GLint location) { glUniform1f(location, value); });
+}
+
+rb::Value rbShaderUniform::setVec2(rb::Value self, const std::vector<rb::Value>& args)
+{
+	float values[2];
+	getFloats(args, values, 2);
+	self.to<rbShaderUniform*>()->upload(GL_FLOAT_VEC2, "set_vec2", [&](GLint location) { glUniform2fv(location, 1, values); });
+	return self;
+}
+
+rb::Value rbShaderUniform::setVec3(rb::Value self, const std::vector<rb::Value>& args)
+{
+	float values[3];
+	getFloats(args, values, 3);
+	self.to<rbShaderUniform*>()->upload(GL_FLOAT_VEC3, "set_vec3", [&](GLint location) { glUniform3fv(location, 1, values); });
+	return self;
+}
+
+rb::Value rbShaderUniform::setVec4(rb::Value self, const std::vector<rb::Value>& args)
+{
+	float values[4];
+	getFloats(args, values, 4);
+	self.to<rbShaderUniform*>()->upload(GL_FLOAT_VEC4, "set_vec4", [&](GLint location) { glUniform4fv(location, 1, values); });
+	return self;
+}
+
+void rbShaderUniform::setInt(int value)
+{
+	resolve();
+	if(myLocation != -1 && myType == GL_BOOL)
+		upload(GL_BOOL, "set_int", [=](GLint location) { glUniform1i(location, value); });
+	else
+		upload(GL_INT, "set_int", [=](GLint location) { glUniform1i(location, value); });
+}
+
+void rbShaderUniform::setColor(sf::Color color)
+{
+	const float values[4] = {color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f};
+	upload(GL_FLOAT_VEC4, "set_color", [&](GLint location) { glUniform4fv(location, 1, values); });
+}
+
+void rbShaderUniform::setMat3(const rb::Value& matrix)
+{
+	float values[9];
+	if(rb::DataType<rbTransform>::isInstance(matrix))
+	{
+		// Picks the 2D affine part out of SFML's column-major 4x4 matrix.
+		const float* source = matrix.to<const sf::Transform&>().getMatrix();
+		const unsigned int indices[9] = {0, 1, 3, 4, 5, 7, 12, 13, 15};
+		for(unsigned int index = 0; index < 9; index++)
+			values[index] = source[indices[index]];
+	}
+	else
+	{
+		std::vector<rb::Value> elements = matrix.to<std::vector<rb::Value>>();
+		if(elements.size() != 9)
+			rb::raise(rb::ArgumentError, "expected 9 matrix elements, got %u", static_cast<unsigned int>(elements.size()));
+		for(unsigned int index = 0; index < 9; index++)
+			values[index] = elements[index].to<float>();
+	}
+	upload(GL_FLOAT_MAT3, "set_mat3", [&](GLint location) { glUniformMatrix3fv(location, 1, GL_FALSE, values); });
+}
+
+void rbShaderUniform::setMat4(const sf::Transform& transform)
+{
+	const float* values = transform.getMatrix();
+	upload(GL_FLOAT_MAT4, "set_mat4", [&](GLint location) { glUniformMatrix4fv(location, 1, GL_FALSE, values); });
+}
+
+void rbShaderUniform::setTexture(const rb::Value& texture)
+{
+	resolve();
+	if(myLocation == -1)
+		return;
+	expectType(GL_SAMPLER_2D, "set_texture");
+
+	// Texture units are handed out by sf::Shader when it binds itself, so
+	// textures keep going through it; only the type sniffing is skipped.
+	if(rbShader::isCurrentTexture(texture))
+		myShader->setParameter(myName, sf::Shader::CurrentTexture);
+	else
+		myShader->setParameter(myName, texture.to<const sf::Texture&>());
+	myValue.setVar<symVarTexture>(texture);
+	myCache->invalidate();
+}
+
+rb::Value rbShaderUniform::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbShaderUniform::inspect() const
+{
+	return ourDefinition.getName() + "(" + myName + ", " + getTypeName(myType) + ")";
+}
+
+void rbShaderUniform::resolve()
+{
+	if(myShader->getNativeHandle() == myProgram && myOwner->getLoadCount() == myLoadCount)
+		return;
+
+	gl::ensureContext();
+	if(!gl::initialize() || !GLEW_VERSION_2_0)
+		rb::raise(rb::RuntimeError, "shader uniforms need OpenGL 2.0");
+
+	myProgram = myShader->getNativeHandle();
+	myLoadCount = myOwner->getLoadCount();
+	myLocation = -1;
+	myType = 0;
+	if(myProgram == 0)
+		return;
+
+	myLocation = glGetUniformLocation(myProgram, myName.c_str());
+	if(myLocation == -1)
+		return;
+
+	// Arrays are reported as "name[0]", so accept both spellings.
+	GLint count = 0;
+	glGetProgramiv(myProgram, GL_ACTIVE_UNIFORMS, &count);
+	const std::string arrayName = myName + "[0]";
+	for(GLint index = 0; index < count; index++)
+	{
+		GLchar buffer[256];
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(myProgram, index, sizeof(buffer), &length, &size, &type, buffer);
+		std::string name(buffer, length);
+		if(name == myName || name == arrayName)
+		{
+			myType = type;
+			break;
+		}
+	}
+}
+
+void rbShaderUniform::expectType(unsigned int type, const char* setter)
+{
+	if(myType != type)
+		rb::raise(rb::TypeError, "%s can't be used on uniform '%s' of type %s", setter, myName.c_str(), getTypeName(myType));
+}
+
+template<typename Function>
+void rbShaderUniform::upload(unsigned int type, const char* setter, Function function)
+{
+	resolve();
+	if(myLocation == -1)
+		return;
+	expectType(type, setter);
+
+	gl::ensureContext();
+	gl::ProgramBinding binding(myProgram);
+	function(myLocation);
+	myCache->invalidate();
+}
+
+namespace rb
+{
+
+template<>
+rbShaderUniform* Value::to() const
+{
+	return DataType<rbShaderUniform>::fetch(myValue);
+}
+
+template<>
+const rbShaderUniform* Value::to() const
+{
+	return DataType<rbShaderUniform>::fetch(myValue);
+}
+
+}
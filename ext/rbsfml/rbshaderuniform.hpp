@@ -0,0 +1,90 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBSHADERUNIFORM_HPP_
+#define RBSFML_RBSHADERUNIFORM_HPP_
+
+#include <SFML/Graphics/Shader.hpp>
+#include <string>
+#include "class.hpp"
+#include "object.hpp"
+#include "uniformcache.hpp"
+
+class rbShader;
+class rbShaderUniform;
+
+typedef rb::Class<rbShaderUniform> rbShaderUniformClass;
+
+class rbShaderUniform : public rb::Object
+{
+public:
+	static void defineClass(const rb::Value& shader);
+	static rbShaderUniformClass& getDefinition();
+
+	static rb::Value create(const rb::Value& shader, const std::string& name);
+
+	rbShaderUniform();
+	~rbShaderUniform();
+
+	const std::string& getName() const;
+	bool isActive();
+	int getLocation();
+
+	void setFloat(float value);
+	static rb::Value setVec2(rb::Value self, const std::vector<rb::Value>& args);
+	static rb::Value setVec3(rb::Value self, const std::vector<rb::Value>& args);
+	static rb::Value setVec4(rb::Value self, const std::vector<rb::Value>& args);
+	void setInt(int value);
+	void setColor(sf::Color color);
+	void setMat3(const rb::Value& matrix);
+	void setMat4(const sf::Transform& transform);
+	void setTexture(const rb::Value& texture);
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+private:
+	void resolve();
+	void expectType(unsigned int type, const char* setter);
+	template<typename Function>
+	void upload(unsigned int type, const char* setter, Function function);
+
+	static rbShaderUniformClass ourDefinition;
+
+	const rbShader* myOwner;
+	sf::Shader* myShader;
+	UniformCache* myCache;
+	std::string myName;
+	unsigned int myProgram;
+	unsigned int myLoadCount;
+	int myLocation;
+	unsigned int myType;
+};
+
+namespace rb
+{
+	template<>
+	rbShaderUniform* Value::to() const;
+	template<>
+	const rbShaderUniform* Value::to() const;
+}
+
+#endif // RBSFML_RBSHADERUNIFORM_HPP_
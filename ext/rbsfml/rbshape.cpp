@@ -42,40 +42,40 @@ void rbShape::defineClass(const rb::Value& sfml)
 	ourDefinition = rbShapeClass::defineClassUnder<rb::AbstractAllocator>("Shape", sfml);
 	ourDefinition.includeModule(rb::Value(rbDrawable::getDefinition()));
 	ourDefinition.includeModule(rb::Value(rbTransformable::getDefinition()));
-	ourDefinition.defineMethod<0>("marshal_dump", &rbShape::marshalDump);
-	ourDefinition.defineMethod<1>("texture=", &rbShape::setTexture);
-	ourDefinition.defineMethod<2>("texture", &rbShape::getTexture);
-	ourDefinition.defineMethod<3>("texture_rect=", &rbShape::setTextureRect);
-    ourDefinition.defineMethod<4>("texture_rect", &rbShape::getTextureRect);
-    ourDefinition.defineMethod<5>("fill_color=", &rbShape::setFillColor);
-    ourDefinition.defineMethod<6>("fill_color", &rbShape::getFillColor);
-    ourDefinition.defineMethod<7>("outline_color=", &rbShape::setOutlineColor);
-    ourDefinition.defineMethod<8>("outline_color", &rbShape::getOutlineColor);
-    ourDefinition.defineMethod<9>("outline_thickness=", &rbShape::setOutlineThickness);
-    ourDefinition.defineMethod<10>("outline_thickness", &rbShape::getOutlineThickness);
-    ourDefinition.defineMethod<11>("local_bounds", &rbShape::getLocalBounds);
-    ourDefinition.defineMethod<12>("global_bounds", &rbShape::getGlobalBounds);
-    ourDefinition.defineMethod<13>("point_count", &rbShape::getPointCount);
-    ourDefinition.defineMethod<14>("get_point", &rbShape::getPoint);
+	ourDefinition.defineMethod<RBSFML_FN(&rbShape::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShape::setTexture)>("texture=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShape::getTexture)>("texture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbShape::setTextureRect)>("texture_rect=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getTextureRect)>("texture_rect");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::setFillColor)>("fill_color=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getFillColor)>("fill_color");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::setOutlineColor)>("outline_color=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getOutlineColor)>("outline_color");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::setOutlineThickness)>("outline_thickness=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getOutlineThickness)>("outline_thickness");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getLocalBounds)>("local_bounds");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getGlobalBounds)>("global_bounds");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getPointCount)>("point_count");
+    ourDefinition.defineMethod<RBSFML_FN(&rbShape::getPoint)>("get_point");
 
 	ourDefinition.aliasMethod("texture=", "set_texture");
 	ourDefinition.aliasMethod("get_point", "[]");
 
 	ourCircleDefinition = rbCircleShapeClass::defineClassUnder("CircleShape", sfml, rb::Value(ourDefinition));
-	ourCircleDefinition.defineMethod<0>("initialize", &rbCircleShape::initialize);
-	ourCircleDefinition.defineMethod<1>("radius=", &rbCircleShape::setRadius);
-	ourCircleDefinition.defineMethod<2>("radius", &rbCircleShape::getRadius);
-	ourCircleDefinition.defineMethod<3>("point_count=", &rbCircleShape::setPointCount);
+	ourCircleDefinition.defineMethod<RBSFML_FN(&rbCircleShape::initialize)>("initialize");
+	ourCircleDefinition.defineMethod<RBSFML_FN(&rbCircleShape::setRadius)>("radius=");
+	ourCircleDefinition.defineMethod<RBSFML_FN(&rbCircleShape::getRadius)>("radius");
+	ourCircleDefinition.defineMethod<RBSFML_FN(&rbCircleShape::setPointCount)>("point_count=");
 
 	ourRectangleDefinition = rbRectangleShapeClass::defineClassUnder("RectangleShape", sfml, rb::Value(ourDefinition));
-    ourRectangleDefinition.defineMethod<0>("initialize", &rbRectangleShape::initialize);
-    ourRectangleDefinition.defineMethod<1>("size=", &rbRectangleShape::setSize);
-    ourRectangleDefinition.defineMethod<2>("size", &rbRectangleShape::getSize);
+    ourRectangleDefinition.defineMethod<RBSFML_FN(&rbRectangleShape::initialize)>("initialize");
+    ourRectangleDefinition.defineMethod<RBSFML_FN(&rbRectangleShape::setSize)>("size=");
+    ourRectangleDefinition.defineMethod<RBSFML_FN(&rbRectangleShape::getSize)>("size");
 
     ourConvexDefinition = rbConvexShapeClass::defineClassUnder("ConvexShape", sfml, rb::Value(ourDefinition));
-    ourConvexDefinition.defineMethod<0>("initialize", &rbConvexShape::initialize);
-    ourConvexDefinition.defineMethod<1>("point_count=", &rbConvexShape::setPointCount);
-    ourConvexDefinition.defineMethod<2>("set_point", &rbConvexShape::setPoint);
+    ourConvexDefinition.defineMethod<RBSFML_FN(&rbConvexShape::initialize)>("initialize");
+    ourConvexDefinition.defineMethod<RBSFML_FN(&rbConvexShape::setPointCount)>("point_count=");
+    ourConvexDefinition.defineMethod<RBSFML_FN(&rbConvexShape::setPoint)>("set_point");
 
     ourConvexDefinition.aliasMethod("set_point", "[]=");
 }
@@ -201,6 +201,12 @@ const sf::Drawable* rbShape::getDrawable() const
     return &getShape();
 }
 
+bool rbShape::getCullingBounds(sf::FloatRect& bounds) const
+{
+    bounds = getShape().getGlobalBounds();
+    return true;
+}
+
 sf::Transformable* rbShape::getTransformable()
 {
     return &getShape();
@@ -254,6 +260,11 @@ const sf::Shape& rbCircleShape::getShape() const
     return myObject;
 }
 
+std::unique_ptr<sf::Drawable> rbCircleShape::cloneDrawable() const
+{
+    return std::unique_ptr<sf::Drawable>(new sf::CircleShape(myObject));
+}
+
 rb::Value rbRectangleShape::initialize(rb::Value self, const std::vector<rb::Value>& args)
 {
     rbRectangleShape* shape = self.to<rbRectangleShape*>();
@@ -290,6 +301,11 @@ const sf::Shape& rbRectangleShape::getShape() const
     return myObject;
 }
 
+std::unique_ptr<sf::Drawable> rbRectangleShape::cloneDrawable() const
+{
+    return std::unique_ptr<sf::Drawable>(new sf::RectangleShape(myObject));
+}
+
 rb::Value rbConvexShape::initialize(rb::Value self, const std::vector<rb::Value>& args)
 {
     rbConvexShape* shape = self.to<rbConvexShape*>();
@@ -326,87 +342,60 @@ const sf::Shape& rbConvexShape::getShape() const
     return myObject;
 }
 
+std::unique_ptr<sf::Drawable> rbConvexShape::cloneDrawable() const
+{
+    return std::unique_ptr<sf::Drawable>(new sf::ConvexShape(myObject));
+}
+
 namespace rb
 {
 
 template<>
 rbShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbShape, object);
-	return object;
+	return DataType<rbShape>::fetch(myValue);
 }
 
 template<>
 const rbShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbShape, object);
-	return object;
+	return DataType<rbShape>::fetch(myValue);
 }
 
 template<>
 rbCircleShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbCircleShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbCircleShape, object);
-	return object;
+	return DataType<rbCircleShape>::fetch(myValue);
 }
 
 template<>
 const rbCircleShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbCircleShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbCircleShape, object);
-	return object;
+	return DataType<rbCircleShape>::fetch(myValue);
 }
 
 template<>
 rbRectangleShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbRectangleShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRectangleShape, object);
-	return object;
+	return DataType<rbRectangleShape>::fetch(myValue);
 }
 
 template<>
 const rbRectangleShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbRectangleShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbRectangleShape, object);
-	return object;
+	return DataType<rbRectangleShape>::fetch(myValue);
 }
 
 template<>
 rbConvexShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbConvexShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbConvexShape, object);
-	return object;
+	return DataType<rbConvexShape>::fetch(myValue);
 }
 
 template<>
 const rbConvexShape* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbConvexShape* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbConvexShape, object);
-	return object;
+	return DataType<rbConvexShape>::fetch(myValue);
 }
 
 template<>
@@ -75,6 +75,7 @@ public:
 protected:
     virtual sf::Drawable* getDrawable();
     virtual const sf::Drawable* getDrawable() const;
+    virtual bool getCullingBounds(sf::FloatRect& bounds) const;
 
     virtual sf::Transformable* getTransformable();
     virtual const sf::Transformable* getTransformable() const;
@@ -103,6 +104,7 @@ public:
 protected:
     sf::Shape& getShape();
     const sf::Shape& getShape() const;
+    std::unique_ptr<sf::Drawable> cloneDrawable() const;
 
 private:
     sf::CircleShape myObject;
@@ -119,6 +121,7 @@ public:
 protected:
     sf::Shape& getShape();
     const sf::Shape& getShape() const;
+    std::unique_ptr<sf::Drawable> cloneDrawable() const;
 
 private:
     sf::RectangleShape myObject;
@@ -135,6 +138,7 @@ public:
 protected:
     sf::Shape& getShape();
     const sf::Shape& getShape() const;
+    std::unique_ptr<sf::Drawable> cloneDrawable() const;
 
 private:
     sf::ConvexShape myObject;
@@ -0,0 +1,419 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbspatialhash.hpp"
+#include "rbrect.hpp"
+#include "rbvector2.hpp"
+#include "rbview.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Entries spanning more cells than this are kept in a separate list that
+	// every query scans, instead of being linked into each cell.
+	const long long MaxLinkedCells = 64;
+	// Keeps cell coordinates and range sizes well inside int arithmetic.
+	const double CellLimit = 1 << 30;
+
+	int toCell(float value, float cellSize)
+	{
+		double cell = std::floor(static_cast<double>(value) / cellSize);
+		if(std::isnan(cell))
+			return 0;
+		return static_cast<int>(std::max(-CellLimit, std::min(CellLimit, cell)));
+	}
+
+	struct Bounds
+	{
+		float left, top, right, bottom;
+
+		explicit Bounds(const sf::FloatRect& rect)
+		: left(std::min(rect.left, rect.left + rect.width))
+		, top(std::min(rect.top, rect.top + rect.height))
+		, right(std::max(rect.left, rect.left + rect.width))
+		, bottom(std::max(rect.top, rect.top + rect.height))
+		{
+		}
+
+		bool overlaps(const Bounds& other) const
+		{
+			return other.left <= right && left <= other.right && other.top <= bottom && top <= other.bottom;
+		}
+	};
+
+	void checkFinite(const sf::FloatRect& rect)
+	{
+		if(std::isnan(rect.left) || std::isnan(rect.top) || std::isnan(rect.width) || std::isnan(rect.height))
+			rb::raise(rb::ArgumentError, "rect must not contain NaN");
+	}
+}
+
+rbSpatialHashClass rbSpatialHash::ourDefinition;
+
+void rbSpatialHash::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbSpatialHashClass::defineClassUnder("SpatialHash", sfml);
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::insert)>("insert");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::move)>("move");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::remove)>("remove");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::clear)>("clear");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::contains)>("include?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::getRect)>("[]");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::query)>("query");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::queryPoint)>("query_point");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::getSize)>("size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::getCellSize)>("cell_size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSpatialHash::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("size", "length");
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbSpatialHashClass& rbSpatialHash::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbSpatialHash::rbSpatialHash()
+: rb::Object()
+, myCellSize(64)
+, mySize(0)
+, myCells()
+, myEntries()
+, myFreeIndices()
+, myOversized()
+, myResults()
+, myQueryStamp(0)
+{
+}
+
+rbSpatialHash::~rbSpatialHash()
+{
+}
+
+rb::Value rbSpatialHash::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	rbSpatialHash* object = self.to<rbSpatialHash*>();
+	switch( args.size() )
+	{
+		case 0:
+			break;
+		case 1:
+			object->myCellSize = args[0].to<float>();
+			if(!(object->myCellSize > 0))
+				rb::raise(rb::ArgumentError, "cell size must be positive");
+			break;
+		default:
+			rb::expectedNumArgs( args.size(), 0, 1 );
+			break;
+	}
+
+	return self;
+}
+
+rbSpatialHash* rbSpatialHash::initializeCopy(const rbSpatialHash* value)
+{
+	myCellSize = value->myCellSize;
+	mySize = value->mySize;
+	myCells = value->myCells;
+	myEntries = value->myEntries;
+	myFreeIndices = value->myFreeIndices;
+	myOversized = value->myOversized;
+	myQueryStamp = value->myQueryStamp;
+	return this;
+}
+
+unsigned int rbSpatialHash::insert(sf::FloatRect rect)
+{
+	checkFinite(rect);
+	unsigned int index;
+	if(myFreeIndices.empty())
+	{
+		index = myEntries.size();
+		myEntries.push_back(Entry());
+	}
+	else
+	{
+		index = myFreeIndices.back();
+		myFreeIndices.pop_back();
+	}
+
+	Entry& entry = myEntries[index];
+	entry.rect = rect;
+	entry.cells = getCellRange(rect);
+	entry.alive = true;
+	entry.queryStamp = myQueryStamp;
+	link(index);
+	mySize++;
+	return index;
+}
+
+void rbSpatialHash::move(unsigned int index, sf::FloatRect rect)
+{
+	getEntry(index);
+	checkFinite(rect);
+	Entry& entry = myEntries[index];
+	CellRange cells = getCellRange(rect);
+	if(cells == entry.cells)
+	{
+		entry.rect = rect;
+	}
+	else
+	{
+		unlink(index);
+		entry.rect = rect;
+		entry.cells = cells;
+		link(index);
+	}
+}
+
+void rbSpatialHash::remove(unsigned int index)
+{
+	getEntry(index);
+	unlink(index);
+	myEntries[index].alive = false;
+	myFreeIndices.push_back(index);
+	mySize--;
+}
+
+void rbSpatialHash::clear()
+{
+	myCells.clear();
+	myEntries.clear();
+	myFreeIndices.clear();
+	myOversized.clear();
+	mySize = 0;
+}
+
+bool rbSpatialHash::contains(unsigned int index) const
+{
+	return index < myEntries.size() && myEntries[index].alive;
+}
+
+sf::FloatRect rbSpatialHash::getRect(unsigned int index) const
+{
+	return getEntry(index).rect;
+}
+
+rb::Value rbSpatialHash::query(const rb::Value& area) const
+{
+	if(rb::DataType<rbView>::isInstance(area))
+		return collect(rbView::getWorldRect(area.to<const sf::View&>()));
+	else
+		return collect(area.to<sf::FloatRect>());
+}
+
+rb::Value rbSpatialHash::queryPoint(sf::Vector2f point) const
+{
+	return collect(sf::FloatRect(point.x, point.y, 0, 0));
+}
+
+unsigned int rbSpatialHash::getSize() const
+{
+	return mySize;
+}
+
+float rbSpatialHash::getCellSize() const
+{
+	return myCellSize;
+}
+
+rb::Value rbSpatialHash::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbSpatialHash::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myCellSize) + ", " + macro::toString(mySize) + ")";
+}
+
+bool rbSpatialHash::CellRange::operator==(const CellRange& other) const
+{
+	return left == other.left && top == other.top && right == other.right && bottom == other.bottom;
+}
+
+long long rbSpatialHash::CellRange::getCount() const
+{
+	return (static_cast<long long>(right) - left + 1) * (static_cast<long long>(bottom) - top + 1);
+}
+
+rbSpatialHash::CellKey rbSpatialHash::getKey(int x, int y)
+{
+	return (static_cast<CellKey>(x) << 32) | static_cast<unsigned int>(y);
+}
+
+rbSpatialHash::CellRange rbSpatialHash::getCellRange(const sf::FloatRect& rect) const
+{
+	Bounds bounds(rect);
+
+	CellRange range;
+	range.left = toCell(bounds.left, myCellSize);
+	range.top = toCell(bounds.top, myCellSize);
+	range.right = toCell(bounds.right, myCellSize);
+	range.bottom = toCell(bounds.bottom, myCellSize);
+	return range;
+}
+
+void rbSpatialHash::link(unsigned int index)
+{
+	Entry& entry = myEntries[index];
+	const CellRange& cells = entry.cells;
+	entry.oversized = cells.getCount() > MaxLinkedCells;
+	if(entry.oversized)
+	{
+		myOversized.push_back(index);
+		return;
+	}
+
+	for(int y = cells.top; y <= cells.bottom; y++)
+	{
+		for(int x = cells.left; x <= cells.right; x++)
+		{
+			myCells[getKey(x, y)].push_back(index);
+		}
+	}
+}
+
+void rbSpatialHash::unlink(unsigned int index)
+{
+	const Entry& entry = myEntries[index];
+	if(entry.oversized)
+	{
+		auto position = std::find(myOversized.begin(), myOversized.end(), index);
+		if(position != myOversized.end())
+		{
+			*position = myOversized.back();
+			myOversized.pop_back();
+		}
+		return;
+	}
+
+	const CellRange& cells = entry.cells;
+	for(int y = cells.top; y <= cells.bottom; y++)
+	{
+		for(int x = cells.left; x <= cells.right; x++)
+		{
+			auto iterator = myCells.find(getKey(x, y));
+			if(iterator == myCells.end())
+				continue;
+
+			Cell& cell = iterator->second;
+			auto position = std::find(cell.begin(), cell.end(), index);
+			if(position != cell.end())
+			{
+				*position = cell.back();
+				cell.pop_back();
+			}
+			if(cell.empty())
+				myCells.erase(iterator);
+		}
+	}
+}
+
+const rbSpatialHash::Entry& rbSpatialHash::getEntry(unsigned int index) const
+{
+	if(!contains(index))
+		rb::raise(rb::ArgumentError, "no entry with index %d in %s", index, ourDefinition.getName().c_str());
+	return myEntries[index];
+}
+
+rb::Value rbSpatialHash::collect(const sf::FloatRect& rect) const
+{
+	CellRange cells = getCellRange(rect);
+
+	myResults.clear();
+	if(++myQueryStamp == 0)
+	{
+		for(const Entry& entry : myEntries)
+			entry.queryStamp = 0;
+		myQueryStamp = 1;
+	}
+
+	// Walking more cells than the grid holds is slower than testing every entry.
+	if(cells.getCount() > static_cast<long long>(myCells.size()))
+	{
+		for(unsigned int index = 0; index < myEntries.size(); index++)
+		{
+			if(myEntries[index].alive)
+				test(index, rect);
+		}
+	}
+	else
+	{
+		for(int y = cells.top; y <= cells.bottom; y++)
+		{
+			for(int x = cells.left; x <= cells.right; x++)
+			{
+				auto iterator = myCells.find(getKey(x, y));
+				if(iterator == myCells.end())
+					continue;
+
+				for(unsigned int index : iterator->second)
+					test(index, rect);
+			}
+		}
+
+		for(unsigned int index : myOversized)
+			test(index, rect);
+	}
+
+	std::sort(myResults.begin(), myResults.end());
+	VALUE array = rb_ary_new_capa(myResults.size());
+	for(unsigned int index : myResults)
+		rb_ary_push(array, UINT2NUM(index));
+	return rb::Value(array);
+}
+
+void rbSpatialHash::test(unsigned int index, const sf::FloatRect& area) const
+{
+	const Entry& entry = myEntries[index];
+	if(entry.queryStamp == myQueryStamp)
+		return;
+
+	entry.queryStamp = myQueryStamp;
+	if(Bounds(entry.rect).overlaps(Bounds(area)))
+		myResults.push_back(index);
+}
+
+namespace rb
+{
+
+template<>
+rbSpatialHash* Value::to() const
+{
+	return DataType<rbSpatialHash>::fetch(myValue);
+}
+
+template<>
+const rbSpatialHash* Value::to() const
+{
+	return DataType<rbSpatialHash>::fetch(myValue);
+}
+
+}
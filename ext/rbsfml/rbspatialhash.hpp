@@ -0,0 +1,114 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBSPATIALHASH_HPP_
+#define RBSFML_RBSPATIALHASH_HPP_
+
+#include <SFML/Graphics/Rect.hpp>
+#include <unordered_map>
+#include <vector>
+#include "class.hpp"
+#include "object.hpp"
+
+class rbSpatialHash;
+
+typedef rb::Class<rbSpatialHash> rbSpatialHashClass;
+
+class rbSpatialHash : public rb::Object
+{
+public:
+	static void defineClass(const rb::Value& sfml);
+	static rbSpatialHashClass& getDefinition();
+
+	rbSpatialHash();
+	~rbSpatialHash();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+	rbSpatialHash* initializeCopy(const rbSpatialHash* value);
+
+	unsigned int insert(sf::FloatRect rect);
+	void move(unsigned int index, sf::FloatRect rect);
+	void remove(unsigned int index);
+	void clear();
+
+	bool contains(unsigned int index) const;
+	sf::FloatRect getRect(unsigned int index) const;
+
+	rb::Value query(const rb::Value& area) const;
+	rb::Value queryPoint(sf::Vector2f point) const;
+
+	unsigned int getSize() const;
+	float getCellSize() const;
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+private:
+	typedef long long CellKey;
+	typedef std::vector<unsigned int> Cell;
+
+	struct CellRange
+	{
+		int left, top, right, bottom;
+		bool operator==(const CellRange& other) const;
+		long long getCount() const;
+	};
+
+	struct Entry
+	{
+		sf::FloatRect rect;
+		CellRange cells;
+		bool alive;
+		bool oversized;
+		mutable unsigned int queryStamp;
+	};
+
+	static CellKey getKey(int x, int y);
+
+	CellRange getCellRange(const sf::FloatRect& rect) const;
+	void link(unsigned int index);
+	void unlink(unsigned int index);
+	const Entry& getEntry(unsigned int index) const;
+
+	rb::Value collect(const sf::FloatRect& rect) const;
+	void test(unsigned int index, const sf::FloatRect& area) const;
+
+	static rbSpatialHashClass ourDefinition;
+
+	float myCellSize;
+	unsigned int mySize;
+	std::unordered_map<CellKey, Cell> myCells;
+	std::vector<Entry> myEntries;
+	std::vector<unsigned int> myFreeIndices;
+	std::vector<unsigned int> myOversized;
+	mutable std::vector<unsigned int> myResults;
+	mutable unsigned int myQueryStamp;
+};
+
+namespace rb
+{
+	template<>
+	rbSpatialHash* Value::to() const;
+	template<>
+	const rbSpatialHash* Value::to() const;
+}
+
+#endif // RBSFML_RBSPATIALHASH_HPP_
@@ -39,17 +39,17 @@ void rbSprite::defineClass(const rb::Value& sfml)
 	ourDefinition = rbSpriteClass::defineClassUnder("Sprite", sfml);
 	ourDefinition.includeModule(rb::Value(rbDrawable::getDefinition()));
 	ourDefinition.includeModule(rb::Value(rbTransformable::getDefinition()));
-	ourDefinition.defineMethod<0>("initialize", &rbSprite::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbSprite::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbSprite::marshalDump);
-	ourDefinition.defineMethod<3>("texture=", &rbSprite::setTexture);
-	ourDefinition.defineMethod<4>("texture", &rbSprite::getTexture);
-	ourDefinition.defineMethod<5>("texture_rect=", &rbSprite::setTextureRect);
-    ourDefinition.defineMethod<6>("texture_rect", &rbSprite::getTextureRect);
-    ourDefinition.defineMethod<7>("color=", &rbSprite::setColor);
-    ourDefinition.defineMethod<8>("color", &rbSprite::getColor);
-    ourDefinition.defineMethod<9>("local_bounds", &rbSprite::getLocalBounds);
-    ourDefinition.defineMethod<10>("global_bounds", &rbSprite::getGlobalBounds);
+	ourDefinition.defineMethod<RBSFML_FN(&rbSprite::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSprite::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSprite::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSprite::setTexture)>("texture=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSprite::getTexture)>("texture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbSprite::setTextureRect)>("texture_rect=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbSprite::getTextureRect)>("texture_rect");
+    ourDefinition.defineMethod<RBSFML_FN(&rbSprite::setColor)>("color=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbSprite::getColor)>("color");
+    ourDefinition.defineMethod<RBSFML_FN(&rbSprite::getLocalBounds)>("local_bounds");
+    ourDefinition.defineMethod<RBSFML_FN(&rbSprite::getGlobalBounds)>("global_bounds");
 
 	ourDefinition.aliasMethod("texture=", "set_texture");
 }
@@ -173,6 +173,17 @@ const sf::Drawable* rbSprite::getDrawable() const
     return &myObject;
 }
 
+bool rbSprite::getCullingBounds(sf::FloatRect& bounds) const
+{
+    bounds = myObject.getGlobalBounds();
+    return true;
+}
+
+std::unique_ptr<sf::Drawable> rbSprite::cloneDrawable() const
+{
+    return std::unique_ptr<sf::Drawable>(new sf::Sprite(myObject));
+}
+
 sf::Transformable* rbSprite::getTransformable()
 {
     return &myObject;
@@ -189,21 +200,13 @@ namespace rb
 template<>
 rbSprite* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbSprite* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbSprite, object);
-	return object;
+	return DataType<rbSprite>::fetch(myValue);
 }
 
 template<>
 const rbSprite* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbSprite* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbSprite, object);
-	return object;
+	return DataType<rbSprite>::fetch(myValue);
 }
 
 template<>
@@ -61,6 +61,8 @@ public:
 protected:
     virtual sf::Drawable* getDrawable();
     virtual const sf::Drawable* getDrawable() const;
+    virtual bool getCullingBounds(sf::FloatRect& bounds) const;
+    virtual std::unique_ptr<sf::Drawable> cloneDrawable() const;
 
     virtual sf::Transformable* getTransformable();
     virtual const sf::Transformable* getTransformable() const;
@@ -39,22 +39,22 @@ void rbText::defineClass(const rb::Value& sfml)
 	ourDefinition = rbTextClass::defineClassUnder("Text", sfml);
 	ourDefinition.includeModule(rb::Value(rbDrawable::getDefinition()));
 	ourDefinition.includeModule(rb::Value(rbTransformable::getDefinition()));
-	ourDefinition.defineMethod<0>("initialize", &rbText::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbText::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbText::marshalDump);
-    ourDefinition.defineMethod<3>("color=", &rbText::setColor);
-    ourDefinition.defineMethod<4>("color", &rbText::getColor);
-    ourDefinition.defineMethod<5>("local_bounds", &rbText::getLocalBounds);
-    ourDefinition.defineMethod<6>("global_bounds", &rbText::getGlobalBounds);
-    ourDefinition.defineMethod<7>("string=", &rbText::setString);
-    ourDefinition.defineMethod<8>("string", &rbText::getString);
-    ourDefinition.defineMethod<9>("font=", &rbText::setFont);
-    ourDefinition.defineMethod<10>("font", &rbText::getFont);
-    ourDefinition.defineMethod<11>("character_size=", &rbText::setCharacterSize);
-    ourDefinition.defineMethod<12>("character_size", &rbText::getCharacterSize);
-    ourDefinition.defineMethod<13>("style=", &rbText::setStyle);
-    ourDefinition.defineMethod<14>("style", &rbText::getStyle);
-    ourDefinition.defineMethod<15>("find_character_pos", &rbText::findCharacterPos);
+	ourDefinition.defineMethod<RBSFML_FN(&rbText::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbText::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbText::marshalDump)>("marshal_dump");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::setColor)>("color=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::getColor)>("color");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::getLocalBounds)>("local_bounds");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::getGlobalBounds)>("global_bounds");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::setString)>("string=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::getString)>("string");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::setFont)>("font=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::getFont)>("font");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::setCharacterSize)>("character_size=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::getCharacterSize)>("character_size");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::setStyle)>("style=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::getStyle)>("style");
+    ourDefinition.defineMethod<RBSFML_FN(&rbText::findCharacterPos)>("find_character_pos");
 
     ourDefinition.defineConstant("Regular", rb::Value(sf::Text::Regular));
     ourDefinition.defineConstant("Bold", rb::Value(sf::Text::Bold));
@@ -194,6 +194,12 @@ const sf::Drawable* rbText::getDrawable() const
     return &myObject;
 }
 
+bool rbText::getCullingBounds(sf::FloatRect& bounds) const
+{
+    bounds = myObject.getGlobalBounds();
+    return true;
+}
+
 sf::Transformable* rbText::getTransformable()
 {
     return &myObject;
@@ -210,21 +216,13 @@ namespace rb
 template<>
 rbText* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbText* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbText, object);
-	return object;
+	return DataType<rbText>::fetch(myValue);
 }
 
 template<>
 const rbText* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbText* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbText, object);
-	return object;
+	return DataType<rbText>::fetch(myValue);
 }
 
 template<>
@@ -69,6 +69,7 @@ public:
 protected:
     virtual sf::Drawable* getDrawable();
     virtual const sf::Drawable* getDrawable() const;
+    virtual bool getCullingBounds(sf::FloatRect& bounds) const;
 
     virtual sf::Transformable* getTransformable();
     virtual const sf::Transformable* getTransformable() const;
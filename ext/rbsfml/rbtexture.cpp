@@ -27,31 +27,32 @@
 #include "rbdataptr.hpp"
 #include "error.hpp"
 #include "macros.hpp"
+#include <algorithm>
 
 rbTextureClass rbTexture::ourDefinition;
 
 void rbTexture::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbTextureClass::defineClassUnder("Texture", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbTexture::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbTexture::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbTexture::marshalDump);
-	ourDefinition.defineMethod<3>("create", &rbTexture::create);
-    ourDefinition.defineMethod<4>("load_from_file", &rbTexture::loadFromFile);
-    ourDefinition.defineMethod<5>("load_from_memory", &rbTexture::loadFromMemory);
-    ourDefinition.defineMethod<6>("load_from_image", &rbTexture::loadFromImage);
-    ourDefinition.defineMethod<7>("size", &rbTexture::getSize);
-    ourDefinition.defineMethod<8>("copy_to_image", &rbTexture::copyToImage);
-    ourDefinition.defineMethod<9>("update", &rbTexture::update);
-    ourDefinition.defineMethod<10>("smooth=", &rbTexture::setSmooth);
-    ourDefinition.defineMethod<11>("smooth?", &rbTexture::isSmooth);
-    ourDefinition.defineMethod<12>("repeated=", &rbTexture::setRepeated);
-    ourDefinition.defineMethod<13>("repeated?", &rbTexture::isRepeated);
-    ourDefinition.defineMethod<14>("native_handle", &rbTexture::getNativeHandle);
-    ourDefinition.defineMethod<15>("native_ptr", &rbTexture::getNativePtr);
-
-    ourDefinition.defineFunction<16>("bind", &rbTexture::bind);
-    ourDefinition.defineFunction<17>("maximum_size", &rbTexture::getMaximumSize);
+	ourDefinition.defineMethod<RBSFML_FN(&rbTexture::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTexture::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTexture::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTexture::create)>("create");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::loadFromFile)>("load_from_file");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::loadFromMemory)>("load_from_memory");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::loadFromImage)>("load_from_image");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::getSize)>("size");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::copyToImage)>("copy_to_image");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::update)>("update");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::setSmooth)>("smooth=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::isSmooth)>("smooth?");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::setRepeated)>("repeated=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::isRepeated)>("repeated?");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::getNativeHandle)>("native_handle");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTexture::getNativePtr)>("native_ptr");
+
+    ourDefinition.defineFunction<RBSFML_FN(&rbTexture::bind)>("bind");
+    ourDefinition.defineFunction<RBSFML_FN(&rbTexture::getMaximumSize)>("maximum_size");
 
     ourDefinition.defineConstant("Normalized", rb::Value(sf::Texture::Normalized));
     ourDefinition.defineConstant("Pixels", rb::Value(sf::Texture::Pixels));
@@ -66,6 +67,7 @@ rbTexture::rbTexture()
 : rb::Object()
 , myObject(new sf::Texture())
 , myOwnsObject(true)
+, myRenderTasks()
 {
 }
 
@@ -73,11 +75,18 @@ rbTexture::rbTexture(sf::Texture* texture)
 : rb::Object()
 , myObject(texture)
 , myOwnsObject(false)
+, myRenderTasks()
 {
 }
 
+// Render threads may still be drawing with us.
 rbTexture::~rbTexture()
 {
+    for(const std::shared_ptr<rbRenderJob::Task>& task : myRenderTasks)
+    {
+        std::unique_lock<std::mutex> lock(task->mutex);
+        task->condition.wait(lock, [&task]() { return task->isDone; });
+    }
     if(myOwnsObject)
         delete myObject;
 }
@@ -120,12 +129,14 @@ rb::Value rbTexture::marshalDump() const
 
 void rbTexture::create(unsigned int width, unsigned int height)
 {
+    checkIdle();
     myObject->create(width, height);
 }
 
 rb::Value rbTexture::loadFromFile(rb::Value self, const std::vector<rb::Value>& args)
 {
     rbTexture* object = self.to<rbTexture*>();
+    object->checkIdle();
     std::string filename;
     sf::IntRect rect;
     switch(args.size())
@@ -146,6 +157,7 @@ rb::Value rbTexture::loadFromFile(rb::Value self, const std::vector<rb::Value>&
 rb::Value rbTexture::loadFromMemory(rb::Value self, const std::vector<rb::Value>& args)
 {
     rbTexture* object = self.to<rbTexture*>();
+    object->checkIdle();
     std::vector<rb::Value> data;
     sf::IntRect rect;
     switch(args.size())
@@ -174,6 +186,7 @@ rb::Value rbTexture::loadFromMemory(rb::Value self, const std::vector<rb::Value>
 rb::Value rbTexture::loadFromImage(rb::Value self, const std::vector<rb::Value>& args)
 {
     rbTexture* object = self.to<rbTexture*>();
+    object->checkIdle();
     const sf::Image* img = nullptr;
     sf::IntRect rect;
     switch(args.size())
@@ -206,6 +219,7 @@ rb::Value rbTexture::copyToImage() const
 rb::Value rbTexture::update(rb::Value self, const std::vector<rb::Value>& args)
 {
     rbTexture* texture = self.to<rbTexture*>();
+    texture->checkIdle();
     switch(args.size())
     {
         case 1:
@@ -220,21 +234,21 @@ rb::Value rbTexture::update(rb::Value self, const std::vector<rb::Value>& args)
                 texture->myObject->update(rawData);
                 delete[] rawData;
             }
-            else if(args[0].isKindOf(rb::Value(rbImage::getDefinition())))
+            else if(rb::DataType<rbImage>::isInstance(args[0]))
             {
-                texture->myObject->update(args[0].to<sf::Image&>());
+                texture->myObject->update(args[0].to<const sf::Image&>());
             }
-            else if(args[0].isKindOf(rb::Value(rbWindow::getDefinition())))
+            else if(rb::DataType<rbWindow>::isInstance(args[0]))
             {
                 texture->myObject->update(args[0].to<sf::Window&>());
             }
             break;
         case 3:
-            if(args[0].isKindOf(rb::Value(rbImage::getDefinition())))
+            if(rb::DataType<rbImage>::isInstance(args[0]))
             {
-                texture->myObject->update(args[0].to<sf::Image&>(), args[1].to<unsigned int>(), args[2].to<unsigned int>());
+                texture->myObject->update(args[0].to<const sf::Image&>(), args[1].to<unsigned int>(), args[2].to<unsigned int>());
             }
-            else if(args[0].isKindOf(rb::Value(rbWindow::getDefinition())))
+            else if(rb::DataType<rbWindow>::isInstance(args[0]))
             {
                 texture->myObject->update(args[0].to<sf::Window&>(), args[1].to<unsigned int>(), args[2].to<unsigned int>());
             }
@@ -257,6 +271,7 @@ rb::Value rbTexture::update(rb::Value self, const std::vector<rb::Value>& args)
 
 void rbTexture::setSmooth(bool smooth)
 {
+    checkIdle();
     myObject->setSmooth(smooth);
 }
 
@@ -267,6 +282,7 @@ bool rbTexture::isSmooth() const
 
 void rbTexture::setRepeated(bool repeated)
 {
+    checkIdle();
     myObject->setRepeated(repeated);
 }
 
@@ -300,27 +316,32 @@ rbDataPtr* rbTexture::getNativePtr() const
     return ptr;
 }
 
+void rbTexture::pin(const std::shared_ptr<rbRenderJob::Task>& task)
+{
+    myRenderTasks.erase(std::remove_if(myRenderTasks.begin(), myRenderTasks.end(), rbRenderJob::isFinished), myRenderTasks.end());
+    myRenderTasks.push_back(task);
+}
+
+void rbTexture::checkIdle()
+{
+    myRenderTasks.erase(std::remove_if(myRenderTasks.begin(), myRenderTasks.end(), rbRenderJob::isFinished), myRenderTasks.end());
+    if(!myRenderTasks.empty())
+        rb::raise(rb::RuntimeError, "%s is used by a render job, wait for the job first", ourDefinition.getName().c_str());
+}
+
 namespace rb
 {
 
 template<>
 rbTexture* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbTexture* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbTexture, object);
-	return object;
+	return DataType<rbTexture>::fetch(myValue);
 }
 
 template<>
 const rbTexture* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbTexture* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbTexture, object);
-	return object;
+	return DataType<rbTexture>::fetch(myValue);
 }
 
 template<>
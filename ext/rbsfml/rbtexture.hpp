@@ -25,6 +25,9 @@
 #include <SFML/Graphics/Texture.hpp>
 #include "class.hpp"
 #include "object.hpp"
+#include "rbrenderjob.hpp"
+#include <memory>
+#include <vector>
 
 class rbTexture;
 class rbDataPtr;
@@ -70,12 +73,20 @@ public:
 
 	rbDataPtr* getNativePtr() const;
 
+	// Render jobs keep a raw pointer to the texture, it can't be changed
+	// or freed until they are done.
+	void pin(const std::shared_ptr<rbRenderJob::Task>& task);
+
 private:
     friend class rb::Value;
+
+	void checkIdle();
+
 	static rbTextureClass ourDefinition;
 
 	sf::Texture* myObject;
 	bool myOwnsObject;
+	std::vector<std::shared_ptr<rbRenderJob::Task>> myRenderTasks;
 };
 
 namespace rb
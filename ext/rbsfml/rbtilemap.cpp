@@ -0,0 +1,422 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbtilemap.hpp"
+#include "rbvector2.hpp"
+#include "rbrect.hpp"
+#include "rbtexture.hpp"
+#include "rbview.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const unsigned int DefaultChunkSize = 16;
+
+	constexpr char symVarInternalTexture[] = "@__internal__texture";
+
+	// Clamps a chunk coordinate to the valid range; the view may reach past
+	// either edge of the map.
+	unsigned int clampChunk(float chunk, unsigned int chunkCount)
+	{
+		if(chunk < 0)
+			return 0;
+		return std::min(static_cast<unsigned int>(chunk), chunkCount - 1);
+	}
+}
+
+const int rbTileMap::EmptyTile;
+rbTileMapClass rbTileMap::ourDefinition;
+
+void rbTileMap::defineClass(const rb::Value& sfml)
+{
+	ourDefinition = rbTileMapClass::defineClassUnder("TileMap", sfml);
+	ourDefinition.includeModule(rb::Value(rbDrawable::getDefinition()));
+	ourDefinition.includeModule(rb::Value(rbTransformable::getDefinition()));
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::setTile)>("set_tile");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getTile)>("tile");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::fill)>("fill");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::load)>("load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getWidth)>("width");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getHeight)>("height");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getTileSize)>("tile_size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getChunkSize)>("chunk_size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::setTexture)>("texture=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getTexture)>("texture");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getLocalBounds)>("local_bounds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getGlobalBounds)>("global_bounds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getChunkCount)>("chunk_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getBuiltChunkCount)>("built_chunk_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::getDrawnChunkCount)>("drawn_chunk_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTileMap::rebuild)>("rebuild");
+	ourDefinition.defineConstant("Empty", rb::Value::create(EmptyTile));
+
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbTileMapClass& rbTileMap::getDefinition()
+{
+	return ourDefinition;
+}
+
+rbTileMap::rbTileMap()
+: rbTransformable()
+, myObject(*this)
+, myTiles()
+, myTileSize()
+, myWidth(0)
+, myHeight(0)
+, myChunkSize(DefaultChunkSize)
+, myChunksX(0)
+, myChunksY(0)
+, myChunks()
+, myDrawnChunks(0)
+{
+}
+
+rbTileMap::~rbTileMap()
+{
+}
+
+rb::Value rbTileMap::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	rbTileMap* object = self.to<rbTileMap*>();
+	unsigned int chunkSize = DefaultChunkSize;
+	switch(args.size())
+	{
+		case 5:
+			chunkSize = args[4].to<unsigned int>();
+		case 4:
+			setTexture(self, args[0]);
+			object->create(args[1].to<sf::Vector2u>(), args[2].to<unsigned int>(), args[3].to<unsigned int>(), chunkSize);
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 4, 5);
+			break;
+	}
+
+	return self;
+}
+
+rbTileMap* rbTileMap::initializeCopy(const rbTileMap* value)
+{
+	static_cast<sf::Transformable&>(myObject) = value->myObject;
+	myObject.texture = value->myObject.texture;
+	myTiles = value->myTiles;
+	myTileSize = value->myTileSize;
+	myWidth = value->myWidth;
+	myHeight = value->myHeight;
+	myChunkSize = value->myChunkSize;
+	myChunksX = value->myChunksX;
+	myChunksY = value->myChunksY;
+	myChunks = value->myChunks;
+	return this;
+}
+
+rb::Value rbTileMap::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbTileMap::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myWidth) + "x" + macro::toString(myHeight) + ")";
+}
+
+void rbTileMap::setTile(unsigned int x, unsigned int y, int id)
+{
+	sf::Int32& tile = myTiles[getIndex(x, y)];
+	sf::Int32 value = id < 0 ? EmptyTile : id;
+	if(tile == value)
+		return;
+
+	tile = value;
+	markDirty(x, y);
+}
+
+int rbTileMap::getTile(unsigned int x, unsigned int y) const
+{
+	return myTiles[getIndex(x, y)];
+}
+
+void rbTileMap::fill(int id)
+{
+	std::fill(myTiles.begin(), myTiles.end(), id < 0 ? EmptyTile : id);
+	markAllDirty();
+}
+
+void rbTileMap::load(const rb::Value& ids)
+{
+	const std::vector<rb::Value>& list = ids.to<const std::vector<rb::Value>&>();
+	if(list.size() != myTiles.size())
+		rb::raise(rb::ArgumentError, "expected %u tile ids, got %u", static_cast<unsigned int>(myTiles.size()), static_cast<unsigned int>(list.size()));
+
+	for(std::size_t index = 0; index < list.size(); index++)
+	{
+		int id = list[index].isNil() ? EmptyTile : list[index].to<int>();
+		myTiles[index] = id < 0 ? EmptyTile : id;
+	}
+	markAllDirty();
+}
+
+unsigned int rbTileMap::getWidth() const
+{
+	return myWidth;
+}
+
+unsigned int rbTileMap::getHeight() const
+{
+	return myHeight;
+}
+
+sf::Vector2u rbTileMap::getTileSize() const
+{
+	return myTileSize;
+}
+
+unsigned int rbTileMap::getChunkSize() const
+{
+	return myChunkSize;
+}
+
+rb::Value rbTileMap::setTexture(rb::Value self, const rb::Value& texture)
+{
+	rbTileMap* object = self.to<rbTileMap*>();
+	object->myObject.texture = texture.isNil() ? nullptr : &texture.to<const sf::Texture&>();
+	object->markAllDirty();
+	self.setVar<symVarInternalTexture>(texture);
+	return rb::Nil;
+}
+
+rb::Value rbTileMap::getTexture() const
+{
+	rb::Value self(myValue);
+	return self.getVar<symVarInternalTexture>();
+}
+
+sf::FloatRect rbTileMap::getLocalBounds() const
+{
+	return sf::FloatRect(0, 0, static_cast<float>(myWidth * myTileSize.x), static_cast<float>(myHeight * myTileSize.y));
+}
+
+sf::FloatRect rbTileMap::getGlobalBounds() const
+{
+	return myObject.getTransform().transformRect(getLocalBounds());
+}
+
+unsigned int rbTileMap::getChunkCount() const
+{
+	return myChunks.size();
+}
+
+unsigned int rbTileMap::getBuiltChunkCount() const
+{
+	return std::count_if(myChunks.begin(), myChunks.end(), [](const Chunk& chunk) { return chunk.built && !chunk.dirty; });
+}
+
+unsigned int rbTileMap::getDrawnChunkCount() const
+{
+	return myDrawnChunks;
+}
+
+void rbTileMap::rebuild()
+{
+	markAllDirty();
+}
+
+sf::Drawable* rbTileMap::getDrawable()
+{
+	return &myObject;
+}
+
+const sf::Drawable* rbTileMap::getDrawable() const
+{
+	return &myObject;
+}
+
+bool rbTileMap::getCullingBounds(sf::FloatRect& bounds) const
+{
+	bounds = getGlobalBounds();
+	return true;
+}
+
+sf::Transformable* rbTileMap::getTransformable()
+{
+	return &myObject;
+}
+
+const sf::Transformable* rbTileMap::getTransformable() const
+{
+	return &myObject;
+}
+
+rbTileMap::Renderer::Renderer(const rbTileMap& owner)
+: sf::Drawable()
+, sf::Transformable()
+, texture(nullptr)
+, myOwner(owner)
+{
+}
+
+void rbTileMap::Renderer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+	states.texture = texture;
+	myOwner.drawChunks(target, states);
+}
+
+rbTileMap::Chunk::Chunk()
+: vertices(sf::Quads)
+, built(false)
+, dirty(true)
+{
+}
+
+void rbTileMap::create(sf::Vector2u tileSize, unsigned int width, unsigned int height, unsigned int chunkSize)
+{
+	if(tileSize.x == 0 || tileSize.y == 0)
+		rb::raise(rb::ArgumentError, "tile size must not be zero");
+	if(chunkSize == 0)
+		rb::raise(rb::ArgumentError, "chunk size must not be zero");
+
+	myTileSize = tileSize;
+	myWidth = width;
+	myHeight = height;
+	myChunkSize = chunkSize;
+	myChunksX = (width + chunkSize - 1) / chunkSize;
+	myChunksY = (height + chunkSize - 1) / chunkSize;
+	myTiles.assign(static_cast<std::size_t>(width) * height, EmptyTile);
+	myChunks.assign(static_cast<std::size_t>(myChunksX) * myChunksY, Chunk());
+	myDrawnChunks = 0;
+}
+
+unsigned int rbTileMap::getIndex(unsigned int x, unsigned int y) const
+{
+	if(x >= myWidth || y >= myHeight)
+		rb::raise(rb::ArgumentError, "tile (%u, %u) is outside of %ux%u %s", x, y, myWidth, myHeight, ourDefinition.getName().c_str());
+	return y * myWidth + x;
+}
+
+void rbTileMap::markDirty(unsigned int x, unsigned int y)
+{
+	myChunks[(y / myChunkSize) * myChunksX + x / myChunkSize].dirty = true;
+}
+
+void rbTileMap::markAllDirty()
+{
+	for(Chunk& chunk : myChunks)
+		chunk.dirty = true;
+}
+
+void rbTileMap::buildChunk(unsigned int chunkX, unsigned int chunkY) const
+{
+	Chunk& chunk = myChunks[chunkY * myChunksX + chunkX];
+	chunk.vertices.clear();
+	chunk.built = true;
+	chunk.dirty = false;
+
+	const sf::Texture* texture = myObject.texture;
+	unsigned int columns = texture ? std::max(texture->getSize().x / myTileSize.x, 1u) : 1;
+	float width = static_cast<float>(myTileSize.x);
+	float height = static_cast<float>(myTileSize.y);
+
+	unsigned int left = chunkX * myChunkSize;
+	unsigned int top = chunkY * myChunkSize;
+	unsigned int right = std::min(left + myChunkSize, myWidth);
+	unsigned int bottom = std::min(top + myChunkSize, myHeight);
+	for(unsigned int y = top; y < bottom; y++)
+	{
+		for(unsigned int x = left; x < right; x++)
+		{
+			sf::Int32 id = myTiles[y * myWidth + x];
+			if(id == EmptyTile)
+				continue;
+
+			float positionX = x * width;
+			float positionY = y * height;
+			float textureX = (id % columns) * width;
+			float textureY = (id / columns) * height;
+			chunk.vertices.append(sf::Vertex(sf::Vector2f(positionX, positionY), sf::Vector2f(textureX, textureY)));
+			chunk.vertices.append(sf::Vertex(sf::Vector2f(positionX + width, positionY), sf::Vector2f(textureX + width, textureY)));
+			chunk.vertices.append(sf::Vertex(sf::Vector2f(positionX + width, positionY + height), sf::Vector2f(textureX + width, textureY + height)));
+			chunk.vertices.append(sf::Vertex(sf::Vector2f(positionX, positionY + height), sf::Vector2f(textureX, textureY + height)));
+		}
+	}
+}
+
+void rbTileMap::drawChunks(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	myDrawnChunks = 0;
+	if(myChunks.empty())
+		return;
+
+	// Bring the area the view covers into the map's local space, so only
+	// the chunks overlapping it are built and drawn.
+	sf::FloatRect visible = states.transform.getInverse().transformRect(rbView::getWorldRect(target.getView()));
+	if(!visible.intersects(getLocalBounds()))
+		return;
+
+	float chunkWidth = static_cast<float>(myChunkSize * myTileSize.x);
+	float chunkHeight = static_cast<float>(myChunkSize * myTileSize.y);
+	unsigned int left = clampChunk(std::floor(visible.left / chunkWidth), myChunksX);
+	unsigned int top = clampChunk(std::floor(visible.top / chunkHeight), myChunksY);
+	unsigned int right = clampChunk(std::ceil((visible.left + visible.width) / chunkWidth) - 1, myChunksX);
+	unsigned int bottom = clampChunk(std::ceil((visible.top + visible.height) / chunkHeight) - 1, myChunksY);
+	for(unsigned int chunkY = top; chunkY <= bottom; chunkY++)
+	{
+		for(unsigned int chunkX = left; chunkX <= right; chunkX++)
+		{
+			const Chunk& chunk = myChunks[chunkY * myChunksX + chunkX];
+			if(chunk.dirty)
+				buildChunk(chunkX, chunkY);
+			if(chunk.vertices.getVertexCount() > 0)
+			{
+				target.draw(chunk.vertices, states);
+				myDrawnChunks++;
+			}
+		}
+	}
+}
+
+namespace rb
+{
+
+template<>
+rbTileMap* Value::to() const
+{
+	return DataType<rbTileMap>::fetch(myValue);
+}
+
+template<>
+const rbTileMap* Value::to() const
+{
+	return DataType<rbTileMap>::fetch(myValue);
+}
+
+}
@@ -0,0 +1,138 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBTILEMAP_HPP_
+#define RBSFML_RBTILEMAP_HPP_
+
+#include "class.hpp"
+#include "rbdrawable.hpp"
+#include "rbtransformable.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+class rbTileMap;
+
+typedef rb::Class<rbTileMap> rbTileMapClass;
+
+class rbTileMap : public rbTransformable
+{
+public:
+	static const int EmptyTile = -1;
+
+	static void defineClass(const rb::Value& sfml);
+	static rbTileMapClass& getDefinition();
+
+	rbTileMap();
+	~rbTileMap();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+	rbTileMap* initializeCopy(const rbTileMap* value);
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+	void setTile(unsigned int x, unsigned int y, int id);
+	int getTile(unsigned int x, unsigned int y) const;
+	void fill(int id);
+	void load(const rb::Value& ids);
+
+	unsigned int getWidth() const;
+	unsigned int getHeight() const;
+	sf::Vector2u getTileSize() const;
+	unsigned int getChunkSize() const;
+
+	static rb::Value setTexture(rb::Value self, const rb::Value& texture);
+	rb::Value getTexture() const;
+
+	sf::FloatRect getLocalBounds() const;
+	sf::FloatRect getGlobalBounds() const;
+
+	unsigned int getChunkCount() const;
+	unsigned int getBuiltChunkCount() const;
+	unsigned int getDrawnChunkCount() const;
+	void rebuild();
+
+protected:
+	virtual sf::Drawable* getDrawable();
+	virtual const sf::Drawable* getDrawable() const;
+	virtual bool getCullingBounds(sf::FloatRect& bounds) const;
+
+	virtual sf::Transformable* getTransformable();
+	virtual const sf::Transformable* getTransformable() const;
+
+private:
+	friend class rb::Value;
+
+	class Renderer : public sf::Drawable, public sf::Transformable
+	{
+	public:
+		explicit Renderer(const rbTileMap& owner);
+
+		const sf::Texture* texture;
+
+	private:
+		virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+		const rbTileMap& myOwner;
+	};
+
+	struct Chunk
+	{
+		sf::VertexArray vertices;
+		bool built;
+		bool dirty;
+
+		Chunk();
+	};
+
+	void create(sf::Vector2u tileSize, unsigned int width, unsigned int height, unsigned int chunkSize);
+	unsigned int getIndex(unsigned int x, unsigned int y) const;
+	void markDirty(unsigned int x, unsigned int y);
+	void markAllDirty();
+	void buildChunk(unsigned int chunkX, unsigned int chunkY) const;
+	void drawChunks(sf::RenderTarget& target, sf::RenderStates states) const;
+
+	static rbTileMapClass ourDefinition;
+
+	Renderer myObject;
+	std::vector<sf::Int32> myTiles;
+	sf::Vector2u myTileSize;
+	unsigned int myWidth;
+	unsigned int myHeight;
+	unsigned int myChunkSize;
+	unsigned int myChunksX;
+	unsigned int myChunksY;
+	mutable std::vector<Chunk> myChunks;
+	mutable unsigned int myDrawnChunks;
+};
+
+namespace rb
+{
+	template<>
+	rbTileMap* Value::to() const;
+	template<>
+	const rbTileMap* Value::to() const;
+}
+
+#endif // RBSFML_RBTILEMAP_HPP_
@@ -29,18 +29,20 @@ void rbTime::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbTimeClass::defineClassUnder("Time", sfml);
 	ourDefinition.includeModule(rb::Value(rb_mComparable));
-	ourDefinition.defineMethod<0>("initialize_copy", &rbTime::initializeCopy);
-	ourDefinition.defineMethod<1>("as_seconds", &rbTime::asSeconds);
-	ourDefinition.defineMethod<2>("as_milliseconds", &rbTime::asMilliseconds);
-	ourDefinition.defineMethod<3>("as_microseconds", &rbTime::asMicroseconds);
-	ourDefinition.defineMethod<4>("marshal_dump", &rbTime::marshalDump);
-	ourDefinition.defineMethod<5>("inspect", &rbTime::inspect);
-	ourDefinition.defineMethod<6>("-@", &rbTime::negate);
-	ourDefinition.defineMethod<7>("+", &rbTime::addition);
-	ourDefinition.defineMethod<8>("-", &rbTime::subtract);
-	ourDefinition.defineMethod<9>("*", &rbTime::multiply);
-	ourDefinition.defineMethod<10>("/", &rbTime::divide);
-	ourDefinition.defineMethod<11>("<=>", &rbTime::compare);
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::asSeconds)>("as_seconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::asMilliseconds)>("as_milliseconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::asMicroseconds)>("as_microseconds");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::negate)>("-@");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::addition)>("+");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::subtract)>("-");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::multiply)>("*");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::divide)>("/");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::compare)>("<=>");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::addInPlace)>("add!");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTime::subtractInPlace)>("subtract!");
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 
@@ -51,21 +53,21 @@ void rbTime::defineClass(const rb::Value& sfml)
 
 rbTime* rbTime::seconds(float val)
 {
-	rbTime* object = ourDefinition.newObject().to<rbTime*>();
+	rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 	object->myObject = sf::seconds(val);
 	return object;
 }
 
 rbTime* rbTime::milliseconds(sf::Int32 val)
 {
-	rbTime* object = ourDefinition.newObject().to<rbTime*>();
+	rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 	object->myObject = sf::milliseconds(val);
 	return object;
 }
 
 rbTime* rbTime::microseconds(sf::Int64 val)
 {
-	rbTime* object = ourDefinition.newObject().to<rbTime*>();
+	rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 	object->myObject = sf::microseconds(val);
 	return object;
 }
@@ -114,28 +116,40 @@ std::string rbTime::inspect() const
 
 rbTime* rbTime::negate() const
 {
-	rbTime* object = ourDefinition.newObject().to<rbTime*>();
+	rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 	object->myObject = -myObject;
 	return object;
 }
 
 rbTime* rbTime::addition(const rbTime* other) const
 {
-	rbTime* object = ourDefinition.newObject().to<rbTime*>();
+	rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 	object->myObject = myObject + other->myObject;
 	return object;
 }
 
 rbTime* rbTime::subtract(const rbTime* other) const
 {
-	rbTime* object = ourDefinition.newObject().to<rbTime*>();
+	rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 	object->myObject = myObject - other->myObject;
 	return object;
 }
 
+rbTime* rbTime::addInPlace(const rbTime* other)
+{
+	myObject += other->myObject;
+	return this;
+}
+
+rbTime* rbTime::subtractInPlace(const rbTime* other)
+{
+	myObject -= other->myObject;
+	return this;
+}
+
 rbTime* rbTime::multiply(const rb::Value& other) const
 {
-	rbTime* object = ourDefinition.newObject().to<rbTime*>();
+	rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 	if(other.getType() == rb::ValueType::Fixnum)
 		object->myObject = myObject * other.to<sf::Int64>();
 	else if(other.getType() == rb::ValueType::Float)
@@ -155,7 +169,7 @@ rb::Value rbTime::divide(const rb::Value& other) const
 	}
 	else
 	{
-		rbTime* object = ourDefinition.newObject().to<rbTime*>();
+		rbTime* object = ourDefinition.allocateObject().to<rbTime*>();
 		if(other.getType() == rb::ValueType::Fixnum)
 			object->myObject = myObject / other.to<sf::Int64>();
 		else if(other.getType() == rb::ValueType::Float)
@@ -185,21 +199,13 @@ namespace rb
 template<>
 rbTime* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbTime* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbTime, object);
-	return object;
+	return DataType<rbTime>::fetch(myValue);
 }
 
 template<>
 const rbTime* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbTime* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbTime, object);
-	return object;
+	return DataType<rbTime>::fetch(myValue);
 }
 
 }
\ No newline at end of file
@@ -56,6 +56,8 @@ public:
 	rbTime* negate() const;
 	rbTime* addition(const rbTime* other) const;
 	rbTime* subtract(const rbTime* other) const;
+	rbTime* addInPlace(const rbTime* other);
+	rbTime* subtractInPlace(const rbTime* other);
 	rbTime* multiply(const rb::Value& other) const;
 	rb::Value divide(const rb::Value& other) const;
 
@@ -68,6 +70,7 @@ public:
 
 private:
 	friend class rbClock;
+	friend class rbFixedStep;
 
 	static rbTimeClass ourDefinition;
 
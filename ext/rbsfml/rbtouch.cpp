@@ -29,8 +29,8 @@ rbTouchModule rbTouch::ourDefinition;
 void rbTouch::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbTouchModule::defineModuleUnder("Touch", sfml);
-	ourDefinition.defineFunction<0>("down?", &sf::Touch::isDown);
-	ourDefinition.defineFunction<1>("get_position", &rbTouch::getPosition);
+	ourDefinition.defineFunction<RBSFML_FN(&sf::Touch::isDown)>("down?");
+	ourDefinition.defineFunction<RBSFML_FN(&rbTouch::getPosition)>("get_position");
 }
 
 rb::Value rbTouch::getPosition(const std::vector<rb::Value>& arguments)
@@ -24,36 +24,39 @@
 #include "rbrect.hpp"
 #include "rbdataptr.hpp"
 #include "error.hpp"
+#include "marshal.hpp"
 #include "macros.hpp"
 
+#include <algorithm>
+
 rbTransformClass rbTransform::ourDefinition;
 
 void rbTransform::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbTransformClass::defineClassUnder("Transform", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbTransform::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbTransform::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbTransform::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbTransform::marshalLoad);
-	ourDefinition.defineMethod<4>("inspect", &rbTransform::inspect);
-    ourDefinition.defineMethod<5>("to_ary", &rbTransform::getMatrix);
-    ourDefinition.defineMethod<6>("inverse", &rbTransform::getInverse);
-    ourDefinition.defineMethod<7>("transform_point", &rbTransform::transformPoint);
-    ourDefinition.defineMethod<8>("transform_rect", &rbTransform::transformRect);
-    ourDefinition.defineMethod<9>("combine", &rbTransform::combine);
-    ourDefinition.defineMethod<10>("combine!", &rbTransform::combineBang);
-    ourDefinition.defineMethod<11>("translate", &rbTransform::translate);
-    ourDefinition.defineMethod<12>("translate!", &rbTransform::translateBang);
-    ourDefinition.defineMethod<13>("rotate", &rbTransform::rotate);
-    ourDefinition.defineMethod<14>("rotate!", &rbTransform::rotateBang);
-    ourDefinition.defineMethod<15>("rotate_around", &rbTransform::rotateAround);
-    ourDefinition.defineMethod<16>("rotate_around!", &rbTransform::rotateAroundBang);
-    ourDefinition.defineMethod<17>("scale", &rbTransform::scale);
-    ourDefinition.defineMethod<18>("scale!", &rbTransform::scaleBang);
-    ourDefinition.defineMethod<19>("scale_around", &rbTransform::scaleAround);
-    ourDefinition.defineMethod<20>("scale_around!", &rbTransform::scaleAroundBang);
-    ourDefinition.defineMethod<21>("*", &rbTransform::multiply);
-    ourDefinition.defineMethod<22>("native_ptr", &rbTransform::getNativePtr);
+	ourDefinition.defineMethod<RBSFML_FN(&rbTransform::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTransform::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTransform::binaryDump)>("_dump");
+	ourDefinition.defineSingletonMethod<RBSFML_FN(&rbTransform::binaryLoad)>("_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTransform::inspect)>("inspect");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::getMatrix)>("to_ary");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::getInverse)>("inverse");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::transformPoint)>("transform_point");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::transformRect)>("transform_rect");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::combine)>("combine");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::combineBang)>("combine!");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::translate)>("translate");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::translateBang)>("translate!");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::rotate)>("rotate");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::rotateBang)>("rotate!");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::rotateAround)>("rotate_around");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::rotateAroundBang)>("rotate_around!");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::scale)>("scale");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::scaleBang)>("scale!");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::scaleAround)>("scale_around");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::scaleAroundBang)>("scale_around!");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::multiply)>("*");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransform::getNativePtr)>("native_ptr");
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 	ourDefinition.aliasMethod("to_ary", "to_a");
@@ -68,6 +71,21 @@ rbTransformClass& rbTransform::getDefinition()
     return ourDefinition;
 }
 
+bool rbTransform::refreshFrozen(rb::Value& cache, const sf::Transform& value)
+{
+    if(!cache.isNil())
+    {
+        const float* cached = cache.to<const sf::Transform&>().getMatrix();
+        if(std::equal(cached, cached + 16, value.getMatrix()))
+            return false;
+    }
+
+    cache = ourDefinition.newObject();
+    cache.to<sf::Transform&>() = value;
+    cache.freeze();
+    return true;
+}
+
 rbTransform::rbTransform()
 : rb::Object()
 , myObject()
@@ -121,24 +139,31 @@ rbTransform* rbTransform::initializeCopy(const rbTransform* value)
 	return this;
 }
 
-rb::Value rbTransform::marshalDump() const
+// Only the 3x3 part of the matrix is meaningful, the rest is implied.
+rb::Value rbTransform::binaryDump(int) const
 {
-    std::vector<rb::Value> data;
-    const float* elements = myObject.getMatrix();
-    for(int index = 0, size = 4*4; index < size; index++)
-    {
-        data.push_back(rb::Value::create(elements[index]));
-    }
-	return rb::Value::create(data);
+	static const int Indices[] = {0, 4, 12, 1, 5, 13, 3, 7, 15};
+	const float* elements = myObject.getMatrix();
+	std::string payload;
+	binary::Writer writer(payload);
+	for(int index : Indices)
+		writer.writeFloat(elements[index]);
+	return marshal::pack(payload, false);
 }
 
-void rbTransform::marshalLoad(const std::vector<rb::Value>& data)
+rb::Value rbTransform::binaryLoad(rb::Value klass, const rb::Value& data)
 {
-    myObject = sf::Transform(
-        data[0].to<float>(),data[1].to<float>(),data[2].to<float>(),
-        data[3].to<float>(),data[4].to<float>(),data[5].to<float>(),
-        data[6].to<float>(),data[7].to<float>(),data[8].to<float>()
-    );
+	std::string payload = marshal::unpack(data, ourDefinition.getName());
+	binary::Reader reader(payload.data(), payload.size());
+	float e[9];
+	for(float& element : e)
+		element = reader.readFloat();
+	if(reader.isFailed())
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", ourDefinition.getName().c_str());
+
+	rb::Value object(rb_obj_alloc(klass.to<VALUE>()));
+	object.to<rbTransform*>()->myObject = sf::Transform(e[0], e[1], e[2], e[3], e[4], e[5], e[6], e[7], e[8]);
+	return object;
 }
 
 std::string rbTransform::inspect() const
@@ -259,7 +284,7 @@ rbTransform* rbTransform::scaleAroundBang(sf::Vector2f factors, sf::Vector2f cen
 
 rb::Value rbTransform::multiply(const rb::Value& other) const
 {
-    if(other.isKindOf(rb::Value(ourDefinition)))
+    if(rb::DataType<rbTransform>::isInstance(other))
     {
         return rb::Value::create(combine(other.to<const sf::Transform&>()));
     }
@@ -282,21 +307,13 @@ namespace rb
 template<>
 rbTransform* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbTransform* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbTransform, object);
-	return object;
+	return DataType<rbTransform>::fetch(myValue);
 }
 
 template<>
 const rbTransform* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbTransform* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbTransform, object);
-	return object;
+	return DataType<rbTransform>::fetch(myValue);
 }
 
 template<>
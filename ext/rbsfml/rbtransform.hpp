@@ -37,14 +37,19 @@ public:
 	static void defineClass(const rb::Value& sfml);
 	static rbTransformClass& getDefinition();
 
+	// Points cache to a frozen transform holding value. The object already in
+	// cache is kept when it holds the same matrix; returns true when a new
+	// one had to be created.
+	static bool refreshFrozen(rb::Value& cache, const sf::Transform& value);
+
 	rbTransform();
 	~rbTransform();
 
 	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
 	rbTransform* initializeCopy(const rbTransform* value);
 
-	rb::Value marshalDump() const;
-	void marshalLoad(const std::vector<rb::Value>& data);
+	rb::Value binaryDump(int level) const;
+	static rb::Value binaryLoad(rb::Value klass, const rb::Value& data);
 
 	std::string inspect() const;
 
@@ -27,6 +27,12 @@
 
 #include <SFML/Graphics/Transformable.hpp>
 
+namespace
+{
+    constexpr char symVarInternalTransform[] = "@__internal__transform";
+    constexpr char symVarInternalInverseTransform[] = "@__internal__inverse_transform";
+}
+
 rbTransformableModule rbTransformable::ourDefinition;
 
 class rbTransformableImpl : public rbTransformable, sf::Transformable
@@ -40,24 +46,26 @@ protected:
 void rbTransformable::defineModule(const rb::Value& sfml)
 {
 	ourDefinition = rbTransformableModule::defineModuleUnder("Transformable", sfml);
-	ourDefinition.defineMethod<1>("position=", &rbTransformable::setPosition);
-	ourDefinition.defineMethod<2>("position", &rbTransformable::getPosition);
-	ourDefinition.defineMethod<3>("rotation=", &rbTransformable::setRotation);
-    ourDefinition.defineMethod<4>("rotation", &rbTransformable::getRotation);
-    ourDefinition.defineMethod<5>("scale=", &rbTransformable::setScale);
-    ourDefinition.defineMethod<6>("scale", &rbTransformable::getScale);
-    ourDefinition.defineMethod<7>("origin=", &rbTransformable::setOrigin);
-    ourDefinition.defineMethod<8>("origin", &rbTransformable::getOrigin);
-    ourDefinition.defineMethod<9>("move", &rbTransformable::move);
-    ourDefinition.defineMethod<10>("rotate", &rbTransformable::rotate);
-    ourDefinition.defineMethod<11>("zoom", &rbTransformable::zoom);
-    ourDefinition.defineMethod<12>("transform", &rbTransformable::getTransform);
-    ourDefinition.defineMethod<13>("inverse_transform", &rbTransformable::getInverseTransform);
+	ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::setPosition)>("position=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getPosition)>("position");
+	ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::setRotation)>("rotation=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getRotation)>("rotation");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::setScale)>("scale=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getScale)>("scale");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::setOrigin)>("origin=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getOrigin)>("origin");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::move)>("move");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::rotate)>("rotate");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::zoom)>("zoom");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getTransform)>("transform");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getInverseTransform)>("inverse_transform");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getTransformInto)>("transform_into");
+    ourDefinition.defineMethod<RBSFML_FN(&rbTransformable::getInverseTransformInto)>("inverse_transform_into");
 }
 
 void rbTransformable::defineIncludeFunction()
 {
-    ourDefinition.defineFunction<0>("included", &rbTransformable::included);
+    ourDefinition.defineFunction<RBSFML_FN(&rbTransformable::included)>("included");
 }
 
 rbTransformableModule& rbTransformable::getDefinition()
@@ -69,13 +77,14 @@ void rbTransformable::included(const rb::Value& base)
 {
     if(base.getType() == rb::ValueType::Class)
     {
-        rb::defineAllocator<rb::DefaultAllocator<rbTransformableImpl>>(base);
+        rb::defineAllocator<rb::DefaultAllocator<rbTransformableImpl, rbTransformable>>(base);
     }
 }
 
 void rbTransformable::setPosition(sf::Vector2f value)
 {
     getTransformable()->setPosition(value);
+    onTransformChanged();
 }
 
 const sf::Vector2f& rbTransformable::getPosition() const
@@ -86,6 +95,7 @@ const sf::Vector2f& rbTransformable::getPosition() const
 void rbTransformable::setRotation(float value)
 {
     getTransformable()->setRotation(value);
+    onTransformChanged();
 }
 
 float rbTransformable::getRotation() const
@@ -96,6 +106,7 @@ float rbTransformable::getRotation() const
 void rbTransformable::setScale(sf::Vector2f value)
 {
     getTransformable()->setScale(value);
+    onTransformChanged();
 }
 
 const sf::Vector2f& rbTransformable::getScale() const
@@ -106,6 +117,7 @@ const sf::Vector2f& rbTransformable::getScale() const
 void rbTransformable::setOrigin(sf::Vector2f value)
 {
     getTransformable()->setOrigin(value);
+    onTransformChanged();
 }
 
 const sf::Vector2f& rbTransformable::getOrigin() const
@@ -116,28 +128,55 @@ const sf::Vector2f& rbTransformable::getOrigin() const
 void rbTransformable::move(sf::Vector2f value)
 {
     getTransformable()->move(value);
+    onTransformChanged();
 }
 
 void rbTransformable::rotate(float value)
 {
     getTransformable()->rotate(value);
+    onTransformChanged();
 }
 
 void rbTransformable::zoom(sf::Vector2f value)
 {
     getTransformable()->scale(value);
+    onTransformChanged();
+}
+
+void rbTransformable::onTransformChanged()
+{
 }
 
 rb::Value rbTransformable::getTransform() const
 {
-    rb::Value object = rbTransform::getDefinition().newObject();
-    object.to<sf::Transform&>() = getTransformable()->getTransform();
-    return object;
+    rb::Value self(myValue);
+    rb::Value cache = self.getVar<symVarInternalTransform>();
+    if(rbTransform::refreshFrozen(cache, getTransformable()->getTransform()) && !self.isFrozen())
+        self.setVar<symVarInternalTransform>(cache);
+    return cache;
 }
 
 rb::Value rbTransformable::getInverseTransform() const
 {
-    rb::Value object = rbTransform::getDefinition().newObject();
-    object.to<sf::Transform&>() = getTransformable()->getInverseTransform();
-    return object;
+    rb::Value self(myValue);
+    rb::Value cache = self.getVar<symVarInternalInverseTransform>();
+    if(rbTransform::refreshFrozen(cache, getTransformable()->getInverseTransform()) && !self.isFrozen())
+        self.setVar<symVarInternalInverseTransform>(cache);
+    return cache;
+}
+
+rb::Value rbTransformable::getTransformInto(rb::Value transform) const
+{
+    if(transform.isFrozen())
+        rb::modifiedFrozen(transform);
+    transform.to<sf::Transform&>() = getTransformable()->getTransform();
+    return transform;
+}
+
+rb::Value rbTransformable::getInverseTransformInto(rb::Value transform) const
+{
+    if(transform.isFrozen())
+        rb::modifiedFrozen(transform);
+    transform.to<sf::Transform&>() = getTransformable()->getInverseTransform();
+    return transform;
 }
@@ -57,7 +57,13 @@ public:
     void zoom(sf::Vector2f value);
 
     rb::Value getTransform() const;
-    rb::Value getInverseTransform() const;;
+    rb::Value getInverseTransform() const;
+    rb::Value getTransformInto(rb::Value transform) const;
+    rb::Value getInverseTransformInto(rb::Value transform) const;
+
+protected:
+    // Called after any of the methods above changed the transformable.
+    virtual void onTransformChanged();
 
 private:
     friend class rb::Value;
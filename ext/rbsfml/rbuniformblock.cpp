@@ -0,0 +1,201 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "rbuniformblock.hpp"
+#include "rbtexture.hpp"
+#include "rbnoncopyable.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+
+namespace
+{
+	constexpr char symVarTextures[] = "@__internal__textures";
+
+	int collectEntry(VALUE key, VALUE value, VALUE data)
+	{
+		UniformList& values = *reinterpret_cast<UniformList*>(data);
+		values.emplace_back(macro::toName(rb::Value(key)), UniformValue::convert(rb::Value(value)));
+		return ST_CONTINUE;
+	}
+
+	int storeEntry(VALUE key, VALUE value, VALUE data)
+	{
+		reinterpret_cast<rbUniformBlock*>(data)->store(macro::toName(rb::Value(key)), rb::Value(value));
+		return ST_CONTINUE;
+	}
+}
+
+rbUniformBlockClass rbUniformBlock::ourDefinition;
+
+void rbUniformBlock::defineClass(const rb::Value& shader)
+{
+	ourDefinition = rbUniformBlockClass::defineClassUnder("UniformBlock", shader);
+	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::set)>("set");
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::update)>("update");
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::clear)>("clear");
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::contains)>("include?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::getSize)>("size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbUniformBlock::inspect)>("inspect");
+
+	ourDefinition.aliasMethod("set", "[]=");
+	ourDefinition.aliasMethod("inspect", "to_s");
+}
+
+rbUniformBlockClass& rbUniformBlock::getDefinition()
+{
+	return ourDefinition;
+}
+
+rb::Value rbUniformBlock::initialize(rb::Value self, const std::vector<rb::Value>& args)
+{
+	switch(args.size())
+	{
+		case 1:
+			update(self, args[0]);
+		case 0:
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 0, 1);
+			break;
+	}
+	return self;
+}
+
+rbUniformBlock::rbUniformBlock()
+: rb::Object()
+, myValues()
+{
+}
+
+rbUniformBlock::~rbUniformBlock()
+{
+}
+
+rb::Value rbUniformBlock::set(rb::Value self, const rb::Value& name, const rb::Value& value)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+	self.to<rbUniformBlock*>()->store(macro::toName(name), value);
+	return value;
+}
+
+rb::Value rbUniformBlock::update(rb::Value self, const rb::Value& hash)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+	if(hash.getType() != rb::ValueType::Hash)
+		rb::expectedTypes("Hash");
+	rb_hash_foreach(hash.to<VALUE>(), storeEntry, reinterpret_cast<VALUE>(self.to<rbUniformBlock*>()));
+	return self;
+}
+
+rb::Value rbUniformBlock::clear(rb::Value self)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+	self.to<rbUniformBlock*>()->myValues.clear();
+	self.setVar<symVarTextures>(rb::Nil);
+	return self;
+}
+
+bool rbUniformBlock::contains(const rb::Value& name) const
+{
+	const std::string key = macro::toName(name);
+	for(const auto& value : myValues)
+	{
+		if(value.first == key)
+			return true;
+	}
+	return false;
+}
+
+unsigned int rbUniformBlock::getSize() const
+{
+	return myValues.size();
+}
+
+rb::Value rbUniformBlock::marshalDump() const
+{
+	rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str());
+	return rb::Nil;
+}
+
+std::string rbUniformBlock::inspect() const
+{
+	return ourDefinition.getName() + "(" + macro::toString(myValues.size()) + ")";
+}
+
+const UniformList& rbUniformBlock::getValues() const
+{
+	return myValues;
+}
+
+void rbUniformBlock::collect(const rb::Value& hash, UniformList& values)
+{
+	rb_hash_foreach(hash.to<VALUE>(), collectEntry, reinterpret_cast<VALUE>(&values));
+}
+
+void rbUniformBlock::store(const std::string& name, const rb::Value& value)
+{
+	UniformValue converted = UniformValue::convert(value);
+
+	// The block only holds a pointer to the texture, so keep it referenced.
+	if(converted.kind == UniformValue::Kind::Texture)
+	{
+		rb::Value textures = myValue.getVar<symVarTextures>();
+		if(textures.isNil())
+		{
+			textures = rb::Value(rb_hash_new());
+			myValue.setVar<symVarTextures>(textures);
+		}
+		rb_hash_aset(textures.to<VALUE>(), rb::Value(name).to<VALUE>(), value.to<VALUE>());
+	}
+
+	for(auto& entry : myValues)
+	{
+		if(entry.first == name)
+		{
+			entry.second = converted;
+			return;
+		}
+	}
+	myValues.emplace_back(name, converted);
+}
+
+namespace rb
+{
+
+template<>
+rbUniformBlock* Value::to() const
+{
+	return DataType<rbUniformBlock>::fetch(myValue);
+}
+
+template<>
+const rbUniformBlock* Value::to() const
+{
+	return DataType<rbUniformBlock>::fetch(myValue);
+}
+
+}
@@ -0,0 +1,74 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_RBUNIFORMBLOCK_HPP_
+#define RBSFML_RBUNIFORMBLOCK_HPP_
+
+#include "class.hpp"
+#include "object.hpp"
+#include "uniformcache.hpp"
+
+class rbUniformBlock;
+
+typedef rb::Class<rbUniformBlock> rbUniformBlockClass;
+
+class rbUniformBlock : public rb::Object
+{
+public:
+	static void defineClass(const rb::Value& shader);
+	static rbUniformBlockClass& getDefinition();
+
+	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
+
+	rbUniformBlock();
+	~rbUniformBlock();
+
+	static rb::Value set(rb::Value self, const rb::Value& name, const rb::Value& value);
+	static rb::Value update(rb::Value self, const rb::Value& hash);
+	static rb::Value clear(rb::Value self);
+
+	bool contains(const rb::Value& name) const;
+	unsigned int getSize() const;
+
+	rb::Value marshalDump() const;
+	std::string inspect() const;
+
+	const UniformList& getValues() const;
+
+	void store(const std::string& name, const rb::Value& value);
+
+	static void collect(const rb::Value& hash, UniformList& values);
+
+private:
+	static rbUniformBlockClass ourDefinition;
+
+	UniformList myValues;
+};
+
+namespace rb
+{
+	template<>
+	rbUniformBlock* Value::to() const;
+	template<>
+	const rbUniformBlock* Value::to() const;
+}
+
+#endif // RBSFML_RBUNIFORMBLOCK_HPP_
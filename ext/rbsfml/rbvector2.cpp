@@ -21,6 +21,7 @@
 
 #include "rbvector2.hpp"
 #include "error.hpp"
+#include "marshal.hpp"
 #include "macros.hpp"
 
 namespace 
@@ -66,18 +67,18 @@ rbVector2Class rbVector2::ourDefinition;
 void rbVector2::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbVector2Class::defineClassUnder<rb::RubyObjAllocator>("Vector2", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbVector2::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbVector2::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbVector2::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbVector2::marshalLoad);
-	ourDefinition.defineMethod<4>("-@", &rbVector2::negate);
-	ourDefinition.defineMethod<5>("+", &rbVector2::add);
-	ourDefinition.defineMethod<6>("-", &rbVector2::subtract);
-	ourDefinition.defineMethod<7>("*", &rbVector2::multiply);
-	ourDefinition.defineMethod<8>("/", &rbVector2::divide);
-	ourDefinition.defineMethod<9>("==", &rbVector2::equal);
-	ourDefinition.defineMethod<10>("eql?", &rbVector2::strictEqual);
-	ourDefinition.defineMethod<11>("inspect", &rbVector2::inspect);
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::binaryDump)>("_dump");
+	ourDefinition.defineSingletonMethod<RBSFML_FN(&rbVector2::binaryLoad)>("_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::negate)>("-@");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::add)>("+");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::subtract)>("-");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::multiply)>("*");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::divide)>("/");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::equal)>("==");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::strictEqual)>("eql?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector2::inspect)>("inspect");
 
 	ourDefinition.defineAttribute("x", true, true);
 	ourDefinition.defineAttribute("y", true, true);
@@ -132,20 +133,27 @@ rb::Value rbVector2::initializeCopy(rb::Value self, const rb::Value& value)
 	return self;
 }
 
-std::vector<rb::Value> rbVector2::marshalDump(const rb::Value& self)
+rb::Value rbVector2::binaryDump(const rb::Value& self, int)
 {
-	std::vector<rb::Value> array;
-	array.push_back(self.getVar<symVarX, rb::Value>());
-    array.push_back(self.getVar<symVarY, rb::Value>());
-    return array;
+	const rb::Value components[] = {self.getVar<symVarX, rb::Value>(), self.getVar<symVarY, rb::Value>()};
+	std::string payload;
+	binary::Writer writer(payload);
+	marshal::writeNumerics(writer, components, 2);
+	return marshal::pack(payload, false);
 }
 
-rb::Value rbVector2::marshalLoad(rb::Value self, const rb::Value& data)
+rb::Value rbVector2::binaryLoad(rb::Value klass, const rb::Value& data)
 {
-	std::vector<rb::Value> array = data.to<std::vector<rb::Value>>();
-	self.setVar<symVarX>(array[0]);
-    self.setVar<symVarY>(array[1]);
-	return rb::Nil;
+	std::string payload = marshal::unpack(data, ourDefinition.getName());
+	binary::Reader reader(payload.data(), payload.size());
+	rb::Value components[2];
+	if(!marshal::readNumerics(reader, components, 2) || !reader.isAtEnd())
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", ourDefinition.getName().c_str());
+
+	rb::Value self(rb_obj_alloc(klass.to<VALUE>()));
+	self.setVar<symVarX>(components[0]);
+	self.setVar<symVarY>(components[1]);
+	return self;
 }
 
 rb::Value rbVector2::negate(const rb::Value& self)
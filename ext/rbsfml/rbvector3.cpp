@@ -21,6 +21,7 @@
 
 #include "rbvector3.hpp"
 #include "error.hpp"
+#include "marshal.hpp"
 #include "macros.hpp"
 
 namespace 
@@ -72,18 +73,18 @@ rbVector3Class rbVector3::ourDefinition;
 void rbVector3::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbVector3Class::defineClassUnder<rb::RubyObjAllocator>("Vector3", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbVector3::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbVector3::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbVector3::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbVector3::marshalLoad);
-	ourDefinition.defineMethod<4>("-@", &rbVector3::negate);
-	ourDefinition.defineMethod<5>("+", &rbVector3::add);
-	ourDefinition.defineMethod<6>("-", &rbVector3::subtract);
-	ourDefinition.defineMethod<7>("*", &rbVector3::multiply);
-	ourDefinition.defineMethod<8>("/", &rbVector3::divide);
-	ourDefinition.defineMethod<9>("==", &rbVector3::equal);
-	ourDefinition.defineMethod<10>("eql?", &rbVector3::strictEqual);
-	ourDefinition.defineMethod<11>("inspect", &rbVector3::inspect);
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::binaryDump)>("_dump");
+	ourDefinition.defineSingletonMethod<RBSFML_FN(&rbVector3::binaryLoad)>("_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::negate)>("-@");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::add)>("+");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::subtract)>("-");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::multiply)>("*");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::divide)>("/");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::equal)>("==");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::strictEqual)>("eql?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVector3::inspect)>("inspect");
 
 	ourDefinition.defineAttribute("x", true, true);
 	ourDefinition.defineAttribute("y", true, true);
@@ -143,22 +144,28 @@ rb::Value rbVector3::initializeCopy(rb::Value self, const rb::Value& value)
 	return self;
 }
 
-std::vector<rb::Value> rbVector3::marshalDump(const rb::Value& self)
+rb::Value rbVector3::binaryDump(const rb::Value& self, int)
 {
-	std::vector<rb::Value> array;
-	array.push_back(self.getVar<symVarX, rb::Value>());
-    array.push_back(self.getVar<symVarY, rb::Value>());
-    array.push_back(self.getVar<symVarZ, rb::Value>());
-    return array;
+	const rb::Value components[] = {self.getVar<symVarX, rb::Value>(), self.getVar<symVarY, rb::Value>(), self.getVar<symVarZ, rb::Value>()};
+	std::string payload;
+	binary::Writer writer(payload);
+	marshal::writeNumerics(writer, components, 3);
+	return marshal::pack(payload, false);
 }
 
-rb::Value rbVector3::marshalLoad(rb::Value self, const rb::Value& data)
+rb::Value rbVector3::binaryLoad(rb::Value klass, const rb::Value& data)
 {
-	std::vector<rb::Value> array = data.to<std::vector<rb::Value>>();
-	self.setVar<symVarX>(array[0]);
-    self.setVar<symVarY>(array[1]);
-    self.setVar<symVarZ>(array[2]);
-	return rb::Nil;
+	std::string payload = marshal::unpack(data, ourDefinition.getName());
+	binary::Reader reader(payload.data(), payload.size());
+	rb::Value components[3];
+	if(!marshal::readNumerics(reader, components, 3) || !reader.isAtEnd())
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", ourDefinition.getName().c_str());
+
+	rb::Value self(rb_obj_alloc(klass.to<VALUE>()));
+	self.setVar<symVarX>(components[0]);
+	self.setVar<symVarY>(components[1]);
+	self.setVar<symVarZ>(components[2]);
+	return self;
 }
 
 rb::Value rbVector3::negate(const rb::Value& self)
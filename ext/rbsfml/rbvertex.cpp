@@ -38,8 +38,8 @@ rbVertexClass rbVertex::ourDefinition;
 void rbVertex::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbVertexClass::defineClassUnder<rb::RubyObjAllocator>("Vertex", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbVertex::initialize);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbVertex::marshalDump);
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertex::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertex::marshalDump)>("marshal_dump");
 
 	ourDefinition.defineAttribute("position", true, true);
 	ourDefinition.defineAttribute("color", true, true);
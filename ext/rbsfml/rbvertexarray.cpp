@@ -23,6 +23,7 @@
 #include "rbvertex.hpp"
 #include "rbrect.hpp"
 #include "error.hpp"
+#include "marshal.hpp"
 #include "macros.hpp"
 
 rbVertexArrayClass rbVertexArray::ourDefinition;
@@ -31,18 +32,19 @@ void rbVertexArray::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbVertexArrayClass::defineClassUnder("VertexArray", sfml);
 	ourDefinition.includeModule(rb::Value(rbDrawable::getDefinition()));
-	ourDefinition.defineMethod<0>("initialize", &rbVertexArray::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbVertexArray::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbVertexArray::marshalDump);
-	ourDefinition.defineMethod<3>("vertex_count", &rbVertexArray::getVertexCount);
-	ourDefinition.defineMethod<4>("[]=", &rbVertexArray::setAtIndex);
-	ourDefinition.defineMethod<5>("[]", &rbVertexArray::getAtIndex);
-	ourDefinition.defineMethod<6>("clear", &rbVertexArray::clear);
-	ourDefinition.defineMethod<7>("resize", &rbVertexArray::resize);
-	ourDefinition.defineMethod<8>("append", &rbVertexArray::append);
-	ourDefinition.defineMethod<9>("primitive_type=", &rbVertexArray::setPrimitiveType);
-	ourDefinition.defineMethod<10>("primitive_type", &rbVertexArray::getPrimitiveType);
-	ourDefinition.defineMethod<11>("bounds", &rbVertexArray::getBounds);
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::binaryDump)>("_dump");
+	ourDefinition.defineSingletonMethod<RBSFML_FN(&rbVertexArray::binaryLoad)>("_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::getVertexCount)>("vertex_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::setAtIndex)>("[]=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::getAtIndex)>("[]");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::clear)>("clear");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::resize)>("resize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::append)>("append");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::setPrimitiveType)>("primitive_type=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::getPrimitiveType)>("primitive_type");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVertexArray::getBounds)>("bounds");
 }
 
 rbVertexArrayClass& rbVertexArray::getDefinition()
@@ -86,10 +88,70 @@ rbVertexArray* rbVertexArray::initializeCopy(const rbVertexArray* value)
 	return this;
 }
 
-rb::Value rbVertexArray::marshalDump() const
-{
-    rb::raise(rb::TypeError, "can't dump %s", ourDefinition.getName().c_str() );
-    return rb::Nil;
+// Attributes are stored in separate runs rather than interleaved, which
+// gives the compressor long stretches of similar bytes to work with.
+rb::Value rbVertexArray::binaryDump(int) const
+{
+	std::size_t count = myObject.getVertexCount();
+	std::string payload;
+	payload.reserve(16 + count * 20);
+	binary::Writer writer(payload);
+	writer.writeUint8(static_cast<sf::Uint8>(myObject.getPrimitiveType()));
+	writer.writeVarUint(count);
+	for(std::size_t index = 0; index < count; index++)
+	{
+		writer.writeFloat(myObject[index].position.x);
+		writer.writeFloat(myObject[index].position.y);
+	}
+	for(std::size_t index = 0; index < count; index++)
+	{
+		const sf::Color& color = myObject[index].color;
+		writer.writeUint8(color.r);
+		writer.writeUint8(color.g);
+		writer.writeUint8(color.b);
+		writer.writeUint8(color.a);
+	}
+	for(std::size_t index = 0; index < count; index++)
+	{
+		writer.writeFloat(myObject[index].texCoords.x);
+		writer.writeFloat(myObject[index].texCoords.y);
+	}
+	return marshal::pack(payload, true);
+}
+
+rb::Value rbVertexArray::binaryLoad(rb::Value klass, const rb::Value& data)
+{
+	std::string payload = marshal::unpack(data, ourDefinition.getName());
+	binary::Reader reader(payload.data(), payload.size());
+	sf::Uint8 type = reader.readUint8();
+	sf::Uint64 count = reader.readVarUint();
+	// Compared by division first, a crafted count could overflow count * 20.
+	if(reader.isFailed() || type > sf::Quads || count > reader.getRemaining() / 20 || reader.getRemaining() != count * 20)
+		rb::raise(rb::ArgumentError, "incompatible marshal data for %s", ourDefinition.getName().c_str());
+
+	rb::Value object(rb_obj_alloc(klass.to<VALUE>()));
+	sf::VertexArray& vertices = object.to<rbVertexArray*>()->myObject;
+	vertices.setPrimitiveType(static_cast<sf::PrimitiveType>(type));
+	vertices.resize(count);
+	for(std::size_t index = 0; index < count; index++)
+	{
+		vertices[index].position.x = reader.readFloat();
+		vertices[index].position.y = reader.readFloat();
+	}
+	for(std::size_t index = 0; index < count; index++)
+	{
+		sf::Color& color = vertices[index].color;
+		color.r = reader.readUint8();
+		color.g = reader.readUint8();
+		color.b = reader.readUint8();
+		color.a = reader.readUint8();
+	}
+	for(std::size_t index = 0; index < count; index++)
+	{
+		vertices[index].texCoords.x = reader.readFloat();
+		vertices[index].texCoords.y = reader.readFloat();
+	}
+	return object;
 }
 
 unsigned int rbVertexArray::getVertexCount() const
@@ -147,27 +209,30 @@ const sf::Drawable* rbVertexArray::getDrawable() const
     return &myObject;
 }
 
+bool rbVertexArray::getCullingBounds(sf::FloatRect& bounds) const
+{
+    bounds = myObject.getBounds();
+    return true;
+}
+
+std::unique_ptr<sf::Drawable> rbVertexArray::cloneDrawable() const
+{
+    return std::unique_ptr<sf::Drawable>(new sf::VertexArray(myObject));
+}
+
 namespace rb
 {
 
 template<>
 rbVertexArray* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbVertexArray* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbVertexArray, object);
-	return object;
+	return DataType<rbVertexArray>::fetch(myValue);
 }
 
 template<>
 const rbVertexArray* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbVertexArray* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbVertexArray, object);
-	return object;
+	return DataType<rbVertexArray>::fetch(myValue);
 }
 
 template<>
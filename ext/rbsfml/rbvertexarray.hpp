@@ -43,7 +43,8 @@ public:
 	static rb::Value initialize(rb::Value self, const std::vector<rb::Value>& args);
 	rbVertexArray* initializeCopy(const rbVertexArray* value);
 
-	rb::Value marshalDump() const;
+	rb::Value binaryDump(int level) const;
+	static rb::Value binaryLoad(rb::Value klass, const rb::Value& data);
 
 	unsigned int getVertexCount() const;
 
@@ -62,6 +63,8 @@ public:
 protected:
     virtual sf::Drawable* getDrawable();
     virtual const sf::Drawable* getDrawable() const;
+    virtual bool getCullingBounds(sf::FloatRect& bounds) const;
+    virtual std::unique_ptr<sf::Drawable> cloneDrawable() const;
 
 private:
     friend class rb::Value;
@@ -29,20 +29,20 @@ void rbVideoMode::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbVideoModeClass::defineClassUnder("VideoMode", sfml);
 	ourDefinition.includeModule(rb::Value(rb_mComparable));
-	ourDefinition.defineFunction<0>("desktop_mode", &rbVideoMode::getDesktopMode);
-	ourDefinition.defineFunction<1>("fullscreen_modes", &rbVideoMode::getFullscreenModes);
-	ourDefinition.defineMethod<2>("initialize", &rbVideoMode::initialize);
-	ourDefinition.defineMethod<3>("initialize_copy", &rbVideoMode::initializeCopy);
-	ourDefinition.defineMethod<4>("valid?", &rbVideoMode::isValid);
-	ourDefinition.defineMethod<5>("width", &rbVideoMode::getWidth);
-	ourDefinition.defineMethod<6>("width=", &rbVideoMode::setWidth);
-	ourDefinition.defineMethod<7>("height", &rbVideoMode::getHeight);
-	ourDefinition.defineMethod<8>("height=", &rbVideoMode::setHeight);
-	ourDefinition.defineMethod<9>("bits_per_pixel", &rbVideoMode::getBitsPerPixel);
-	ourDefinition.defineMethod<10>("bits_per_pixel=", &rbVideoMode::setBitsPerPixel);
-	ourDefinition.defineMethod<11>("marshal_dump", &rbVideoMode::marshalDump);
-	ourDefinition.defineMethod<12>("inspect", &rbVideoMode::inspect);
-	ourDefinition.defineMethod<13>("<=>", &rbVideoMode::compare);
+	ourDefinition.defineFunction<RBSFML_FN(&rbVideoMode::getDesktopMode)>("desktop_mode");
+	ourDefinition.defineFunction<RBSFML_FN(&rbVideoMode::getFullscreenModes)>("fullscreen_modes");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::isValid)>("valid?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::getWidth)>("width");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::setWidth)>("width=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::getHeight)>("height");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::setHeight)>("height=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::getBitsPerPixel)>("bits_per_pixel");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::setBitsPerPixel)>("bits_per_pixel=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::inspect)>("inspect");
+	ourDefinition.defineMethod<RBSFML_FN(&rbVideoMode::compare)>("<=>");
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 	ourDefinition.aliasMethod("bits_per_pixel", "bpp");
@@ -172,21 +172,13 @@ namespace rb
 template<>
 rbVideoMode* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbVideoMode* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbVideoMode, object);
-	return object;
+	return DataType<rbVideoMode>::fetch(myValue);
 }
 
 template<>
 const rbVideoMode* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbVideoMode* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbVideoMode, object);
-	return object;
+	return DataType<rbVideoMode>::fetch(myValue);
 }
 
 }
\ No newline at end of file
@@ -26,29 +26,37 @@
 #include "error.hpp"
 #include "macros.hpp"
 
+namespace
+{
+    constexpr char symVarInternalTransform[] = "@__internal__transform";
+    constexpr char symVarInternalInverseTransform[] = "@__internal__inverse_transform";
+}
+
 rbViewClass rbView::ourDefinition;
 
 void rbView::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbViewClass::defineClassUnder("View", sfml);
-	ourDefinition.defineMethod<0>("initialize", &rbView::initialize);
-	ourDefinition.defineMethod<1>("initialize_copy", &rbView::initializeCopy);
-	ourDefinition.defineMethod<2>("marshal_dump", &rbView::marshalDump);
-	ourDefinition.defineMethod<3>("marshal_load", &rbView::marshalLoad);
-	ourDefinition.defineMethod<4>("inspect", &rbView::inspect);
-    ourDefinition.defineMethod<5>("center=", &rbView::setCenter);
-    ourDefinition.defineMethod<6>("center", &rbView::getCenter);
-    ourDefinition.defineMethod<7>("size=", &rbView::setSize);
-    ourDefinition.defineMethod<8>("size", &rbView::getSize);
-    ourDefinition.defineMethod<9>("rotation=", &rbView::setRotation);
-    ourDefinition.defineMethod<10>("rotation", &rbView::getRotation);
-    ourDefinition.defineMethod<11>("reset", &rbView::reset);
-    ourDefinition.defineMethod<12>("viewport", &rbView::getViewport);
-    ourDefinition.defineMethod<13>("move", &rbView::move);
-    ourDefinition.defineMethod<14>("rotate", &rbView::rotate);
-    ourDefinition.defineMethod<15>("zoom", &rbView::zoom);
-    ourDefinition.defineMethod<16>("transform", &rbView::getTransform);
-    ourDefinition.defineMethod<17>("inverse_transform", &rbView::getInverseTransform);
+	ourDefinition.defineMethod<RBSFML_FN(&rbView::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbView::initializeCopy)>("initialize_copy");
+	ourDefinition.defineMethod<RBSFML_FN(&rbView::marshalDump)>("marshal_dump");
+	ourDefinition.defineMethod<RBSFML_FN(&rbView::marshalLoad)>("marshal_load");
+	ourDefinition.defineMethod<RBSFML_FN(&rbView::inspect)>("inspect");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::setCenter)>("center=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getCenter)>("center");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::setSize)>("size=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getSize)>("size");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::setRotation)>("rotation=");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getRotation)>("rotation");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::reset)>("reset");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getViewport)>("viewport");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::move)>("move");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::rotate)>("rotate");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::zoom)>("zoom");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getTransform)>("transform");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getInverseTransform)>("inverse_transform");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getTransformInto)>("transform_into");
+    ourDefinition.defineMethod<RBSFML_FN(&rbView::getInverseTransformInto)>("inverse_transform_into");
 
 	ourDefinition.aliasMethod("inspect", "to_s");
 }
@@ -58,6 +66,27 @@ rbViewClass& rbView::getDefinition()
     return ourDefinition;
 }
 
+sf::FloatRect rbView::getWorldRect(const sf::View& view)
+{
+    return view.getInverseTransform().transformRect(sf::FloatRect(-1, -1, 2, 2));
+}
+
+bool rbView::refreshFrozen(rb::Value& cache, const sf::View& value)
+{
+    if(!cache.isNil())
+    {
+        const sf::View& cached = cache.to<const sf::View&>();
+        if(cached.getCenter() == value.getCenter() && cached.getSize() == value.getSize() &&
+           cached.getRotation() == value.getRotation() && cached.getViewport() == value.getViewport())
+            return false;
+    }
+
+    cache = ourDefinition.newObject();
+    cache.to<sf::View&>() = value;
+    cache.freeze();
+    return true;
+}
+
 rbView::rbView()
 : rb::Object()
 , myObject()
@@ -171,17 +200,37 @@ void rbView::zoom(float factor)
     myObject.zoom(factor);
 }
 
-rbTransform* rbView::getTransform() const
+rb::Value rbView::getTransform() const
+{
+    rb::Value self(myValue);
+    rb::Value cache = self.getVar<symVarInternalTransform>();
+    if(rbTransform::refreshFrozen(cache, myObject.getTransform()) && !self.isFrozen())
+        self.setVar<symVarInternalTransform>(cache);
+    return cache;
+}
+
+rb::Value rbView::getInverseTransform() const
+{
+    rb::Value self(myValue);
+    rb::Value cache = self.getVar<symVarInternalInverseTransform>();
+    if(rbTransform::refreshFrozen(cache, myObject.getInverseTransform()) && !self.isFrozen())
+        self.setVar<symVarInternalInverseTransform>(cache);
+    return cache;
+}
+
+rb::Value rbView::getTransformInto(rb::Value transform) const
 {
-    rbTransform* transform = rbTransform::getDefinition().newObject().to<rbTransform*>();
-    transform->myObject = myObject.getTransform();
+    if(transform.isFrozen())
+        rb::modifiedFrozen(transform);
+    transform.to<sf::Transform&>() = myObject.getTransform();
     return transform;
 }
 
-rbTransform* rbView::getInverseTransform() const
+rb::Value rbView::getInverseTransformInto(rb::Value transform) const
 {
-    rbTransform* transform = rbTransform::getDefinition().newObject().to<rbTransform*>();
-    transform->myObject = myObject.getInverseTransform();
+    if(transform.isFrozen())
+        rb::modifiedFrozen(transform);
+    transform.to<sf::Transform&>() = myObject.getInverseTransform();
     return transform;
 }
 
@@ -191,21 +240,13 @@ namespace rb
 template<>
 rbView* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbView* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbView, object);
-	return object;
+	return DataType<rbView>::fetch(myValue);
 }
 
 template<>
 const rbView* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbView* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbView, object);
-	return object;
+	return DataType<rbView>::fetch(myValue);
 }
 
 template<>
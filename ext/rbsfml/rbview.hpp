@@ -37,6 +37,9 @@ public:
 	static void defineClass(const rb::Value& sfml);
 	static rbViewClass& getDefinition();
 
+	static sf::FloatRect getWorldRect(const sf::View& view);
+	static bool refreshFrozen(rb::Value& cache, const sf::View& value);
+
 	rbView();
 	~rbView();
 
@@ -64,8 +67,10 @@ public:
 	void rotate(float angle);
 	void zoom(float factor);
 
-	rbTransform* getTransform() const;
-	rbTransform* getInverseTransform() const;
+	rb::Value getTransform() const;
+	rb::Value getInverseTransform() const;
+	rb::Value getTransformInto(rb::Value transform) const;
+	rb::Value getInverseTransformInto(rb::Value transform) const;
 
 private:
     friend class rb::Value;
@@ -25,6 +25,7 @@
 #include "rbnoncopyable.hpp"
 #include "rbvector2.hpp"
 #include "rbevent.hpp"
+#include "rbeventlog.hpp"
 #include "error.hpp"
 #include "macros.hpp"
 #include "base.hpp"
@@ -41,7 +42,35 @@ namespace
 	{
 	};
 
-	constexpr char freezeSym[] = "freeze";
+	constexpr char symVarInternalSettings[] = "@__internal__settings";
+	constexpr char symVarInternalEventRecorder[] = "@__internal__event_recorder";
+	constexpr char symVarInternalEventReplay[] = "@__internal__event_replay";
+
+	constexpr unsigned int AllEvents = (1u << sf::Event::Count) - 1;
+
+	bool isMotion(sf::Event::EventType type)
+	{
+		return type == sf::Event::MouseMoved || type == sf::Event::JoystickMoved || type == sf::Event::TouchMoved;
+	}
+
+	// Whether next only updates the value event carries, so that event can
+	// be replaced by it.
+	bool isSameMotion(const sf::Event& event, const sf::Event& next)
+	{
+		if(event.type != next.type)
+			return false;
+
+		switch(event.type)
+		{
+			case sf::Event::JoystickMoved:
+				return event.joystickMove.joystickId == next.joystickMove.joystickId &&
+				       event.joystickMove.axis == next.joystickMove.axis;
+			case sf::Event::TouchMoved:
+				return event.touch.finger == next.touch.finger;
+			default:
+				return true;
+		}
+	}
 }
 
 class rbWindowImpl : public rbWindow
@@ -55,37 +84,47 @@ private:
     sf::Window myObject;
 };
 
-typedef rb::DefaultAllocator<rbWindowImpl> AllocatorImpl;
+typedef rb::DefaultAllocator<rbWindowImpl, rbWindow> AllocatorImpl;
 
 void rbWindow::defineClass(const rb::Value& sfml)
 {
 	ourDefinition = rbWindowClass::defineClassUnder<AllocatorImpl>("Window", sfml);
 	ourDefinition.includeModule(rb::Value(rbNonCopyable::getDefinition()));
-	ourDefinition.defineMethod<0>("initialize", &rbWindow::initialize);
-	ourDefinition.defineMethod<1>("create", &rbWindow::create);
-	ourDefinition.defineMethod<2>("close", &rbWindow::close);
-	ourDefinition.defineMethod<3>("open?", &rbWindow::isOpen);
-	ourDefinition.defineMethod<4>("settings", &rbWindow::getSettings);
-	ourDefinition.defineMethod<5>("position=", &rbWindow::setPosition);
-	ourDefinition.defineMethod<6>("position", &rbWindow::getPosition);
-	ourDefinition.defineMethod<7>("size=", &rbWindow::setSize);
-	ourDefinition.defineMethod<8>("size", &rbWindow::getSize);
-	ourDefinition.defineMethod<9>("set_title", &rbWindow::setTitle);
-	ourDefinition.defineMethod<10>("set_icon", &rbWindow::setIcon);
-	ourDefinition.defineMethod<11>("visible=", &rbWindow::setVisible);
-	ourDefinition.defineMethod<12>("vertical_sync_enabled=", &rbWindow::setVerticalSyncEnabled);
-	ourDefinition.defineMethod<13>("mouse_cursor_visible=", &rbWindow::setMouseCursorVisible);
-	ourDefinition.defineMethod<14>("key_repeat_enabled=", &rbWindow::setKeyRepeatEnabled);
-	ourDefinition.defineMethod<15>("framerate_limit=", &rbWindow::setFramerateLimit);
-	ourDefinition.defineMethod<16>("joystick_threshold=", &rbWindow::setJoystickThreshold);
-	ourDefinition.defineMethod<17>("set_active", &rbWindow::setActive);
-	ourDefinition.defineMethod<18>("request_focus", &rbWindow::requestFocus);
-	ourDefinition.defineMethod<19>("has_focus", &rbWindow::hasFocus);
-	ourDefinition.defineMethod<20>("display", &rbWindow::display);
-	ourDefinition.defineMethod<21>("system_handle", &rbWindow::getSystemHandle);
-	ourDefinition.defineMethod<22>("poll_event", &rbWindow::pollEvent);
-	ourDefinition.defineMethod<23>("wait_event", &rbWindow::waitEvent);
-	ourDefinition.defineMethod<24>("each_event", &rbWindow::eachEvent);
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::initialize)>("initialize");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::create)>("create");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::close)>("close");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::isOpen)>("open?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getSettings)>("settings");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getSettingsInto)>("settings_into");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setPosition)>("position=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getPosition)>("position");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setSize)>("size=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getSize)>("size");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setTitle)>("set_title");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setIcon)>("set_icon");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setVisible)>("visible=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setVerticalSyncEnabled)>("vertical_sync_enabled=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setMouseCursorVisible)>("mouse_cursor_visible=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setKeyRepeatEnabled)>("key_repeat_enabled=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setFramerateLimit)>("framerate_limit=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setJoystickThreshold)>("joystick_threshold=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setActive)>("set_active");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::requestFocus)>("request_focus");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::hasFocus)>("has_focus");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::display)>("display");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getSystemHandle)>("system_handle");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::pollEvent)>("poll_event");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::waitEvent)>("wait_event");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::eachEvent)>("each_event");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setEventMask)>("event_mask=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getEventMask)>("event_mask");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setCoalescing)>("coalesce_motion=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::isCoalescing)>("coalesce_motion?");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getCoalescedCount)>("coalesced_count");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::setEventRecorder)>("event_recorder=");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::getEventRecorder)>("event_recorder");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::replayEvents)>("replay_events");
+	ourDefinition.defineMethod<RBSFML_FN(&rbWindow::isReplaying)>("replaying?");
 
 	ourDefinition.aliasMethod("set_active", "active=");
 
@@ -105,6 +144,16 @@ rbWindowClass& rbWindow::getDefinition()
 
 rbWindow::rbWindow()
 : rbRenderBaseType()
+, myEventMask(AllEvents)
+, myCoalescing(false)
+, myCoalescedCount(0)
+, myPendingEvent()
+, myHasPendingEvent(false)
+, myRecorder(nullptr)
+, myReplay(nullptr)
+, myReplayPosition(0)
+, myReplayClock()
+, myReplayRealtime(true)
 {
 }
 
@@ -185,16 +234,24 @@ void rbWindow::close()
 
 bool rbWindow::isOpen() const
 {
-	getWindow()->isOpen();
+	return getWindow()->isOpen();
 }
 
-rbContextSettings* rbWindow::getSettings() const
+rb::Value rbWindow::getSettings() const
 {
-	rb::Value value = rbContextSettings::ourDefinition.newObject();
-	rbContextSettings* object = value.to<rbContextSettings*>();
-	object->myObject = getWindow()->getSettings();
-	value.call<freezeSym>();
-	return object;
+	rb::Value self(myValue);
+	rb::Value cache = self.getVar<symVarInternalSettings>();
+	if(rbContextSettings::refreshFrozen(cache, getWindow()->getSettings()) && !self.isFrozen())
+		self.setVar<symVarInternalSettings>(cache);
+	return cache;
+}
+
+rb::Value rbWindow::getSettingsInto(rb::Value settings) const
+{
+	if(settings.isFrozen())
+		rb::modifiedFrozen(settings);
+	settings.to<rbContextSettings*>()->myObject = getWindow()->getSettings();
+	return settings;
 }
 
 void rbWindow::setPosition(sf::Vector2i position)
@@ -302,7 +359,7 @@ sf::WindowHandle rbWindow::getSystemHandle() const
 rbEvent* rbWindow::pollEvent()
 {
 	sf::Event event;
-	if(getWindow()->pollEvent(event) == false)
+	if(nextEvent(event, false) == false)
 		return nullptr;
 
 	rbEvent* object = rbEvent::createEvent(event);
@@ -312,7 +369,7 @@ rbEvent* rbWindow::pollEvent()
 rbEvent* rbWindow::waitEvent()
 {
 	sf::Event event;
-	if(getWindow()->waitEvent(event) == false)
+	if(nextEvent(event, true) == false)
 		return nullptr;
 
 	rbEvent* object = rbEvent::createEvent(event);
@@ -325,7 +382,7 @@ rb::Value rbWindow::eachEvent()
 		return rb::getEnumerator(myValue);
 
 	sf::Event event;
-	while(getWindow()->pollEvent(event))
+	while(nextEvent(event, false))
 	{
 		rbEvent* object = rbEvent::createEvent(event);
 		rb::yield(rb::Value(object));
@@ -333,27 +390,221 @@ rb::Value rbWindow::eachEvent()
 	return myValue;
 }
 
+rb::Value rbWindow::setEventMask(rb::Value self, const rb::Value& mask)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	unsigned int bits = 0;
+	switch(mask.getType())
+	{
+		case rb::ValueType::Fixnum:
+			bits = mask.to<unsigned int>();
+			break;
+		case rb::ValueType::Array:
+			for(const rb::Value& type : mask.to<const std::vector<rb::Value>&>())
+			{
+				unsigned int value = type.to<unsigned int>();
+				if(value >= sf::Event::Count)
+					rb::raise(rb::ArgumentError, "unknown event type %u", value);
+				bits |= 1u << value;
+			}
+			break;
+		default:
+			rb::expectedTypes("Fixnum", "Array");
+			break;
+	}
+
+	self.to<rbWindow*>()->myEventMask = bits & AllEvents;
+	return mask;
+}
+
+unsigned int rbWindow::getEventMask() const
+{
+	return myEventMask;
+}
+
+void rbWindow::setCoalescing(bool coalescing)
+{
+	myCoalescing = coalescing;
+}
+
+bool rbWindow::isCoalescing() const
+{
+	return myCoalescing;
+}
+
+unsigned int rbWindow::getCoalescedCount() const
+{
+	return myCoalescedCount;
+}
+
+// Fetches the next event that passes the mask. With coalescing enabled a
+// motion event swallows the motion events queued right behind it, the first
+// event that doesn't belong to it is kept back for the next call.
+bool rbWindow::nextEvent(sf::Event& event, bool wait)
+{
+	for(;;)
+	{
+		if(myHasPendingEvent)
+		{
+			event = myPendingEvent;
+			myHasPendingEvent = false;
+		}
+		else if(!fetchEvent(event, wait))
+		{
+			return false;
+		}
+
+		if((myEventMask & (1u << event.type)) == 0)
+			continue;
+
+		if(myCoalescing && isMotion(event.type))
+		{
+			sf::Event next;
+			while(fetchEvent(next, false))
+			{
+				if((myEventMask & (1u << next.type)) == 0)
+					continue;
+				if(!isSameMotion(event, next))
+				{
+					myPendingEvent = next;
+					myHasPendingEvent = true;
+					break;
+				}
+				event = next;
+				myCoalescedCount++;
+			}
+		}
+		return true;
+	}
+}
+
+// Reads from the replayed log instead of the OS while a replay is running and
+// hands every event to the recorder. Pending events were recorded when they
+// were first fetched, so this sits below the mask and coalescing.
+bool rbWindow::fetchEvent(sf::Event& event, bool wait)
+{
+	if(myReplay != nullptr)
+	{
+		if(myReplayPosition >= myReplay->getEntryCount())
+		{
+			stopReplay();
+			return false;
+		}
+
+		// Copied out, other threads can change the log while we sleep below.
+		const rbEventLog* log = myReplay;
+		std::size_t position = myReplayPosition;
+		sf::Int64 time = log->getEntry(position).time;
+		event = log->getEntry(position).event;
+		if(myReplayRealtime)
+		{
+			sf::Int64 delay = time - myReplayClock.getElapsedTime().asMicroseconds();
+			if(delay > 0)
+			{
+				if(!wait)
+					return false;
+				rb::sleepWithoutGVL(delay);
+				// The replay may have been stopped, replaced or cleared meanwhile.
+				if(myReplay != log || myReplayPosition != position || position >= log->getEntryCount())
+					return fetchEvent(event, wait);
+			}
+		}
+		myReplayPosition++;
+	}
+	else if(!(wait ? getWindow()->waitEvent(event) : getWindow()->pollEvent(event)))
+	{
+		return false;
+	}
+
+	if(myRecorder != nullptr)
+		myRecorder->record(event);
+	return true;
+}
+
+void rbWindow::stopReplay()
+{
+	myReplay = nullptr;
+	myReplayPosition = 0;
+	rb::Value(myValue).setVar<symVarInternalEventReplay>(rb::Nil);
+}
+
+rb::Value rbWindow::setEventRecorder(rb::Value self, const rb::Value& log)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbWindow* object = self.to<rbWindow*>();
+	if(log.isNil())
+	{
+		object->myRecorder = nullptr;
+	}
+	else
+	{
+		object->myRecorder = log.to<rbEventLog*>();
+		object->myRecorder->beginRecording();
+	}
+	self.setVar<symVarInternalEventRecorder>(log);
+	return log;
+}
+
+rb::Value rbWindow::getEventRecorder() const
+{
+	return myValue.getVar<symVarInternalEventRecorder>();
+}
+
+// replay_events(log, realtime = true) feeds the events of log to poll_event,
+// wait_event and each_event instead of the OS. Real time replay keeps the
+// recorded spacing, otherwise every event is available at once. Passing nil
+// stops a running replay.
+rb::Value rbWindow::replayEvents(rb::Value self, const std::vector<rb::Value>& args)
+{
+	if(self.isFrozen())
+		rb::modifiedFrozen(self);
+
+	rbWindow* object = self.to<rbWindow*>();
+	bool realtime = true;
+	switch(args.size())
+	{
+		case 2:
+			realtime = args[1].to<bool>();
+		case 1:
+			break;
+		default:
+			rb::expectedNumArgs(args.size(), 1, 2);
+			break;
+	}
+
+	object->stopReplay();
+	if(!args[0].isNil())
+	{
+		object->myReplay = args[0].to<const rbEventLog*>();
+		object->myReplayRealtime = realtime;
+		object->myReplayClock.restart();
+		self.setVar<symVarInternalEventReplay>(args[0]);
+	}
+	return self;
+}
+
+bool rbWindow::isReplaying() const
+{
+	return myReplay != nullptr;
+}
+
 namespace rb
 {
 
 template<>
 rbWindow* Value::to() const
 {
-	errorHandling(T_DATA);
-	rbWindow* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbWindow, object);
-	return object;
+	return DataType<rbWindow>::fetch(myValue);
 }
 
 template<>
 const rbWindow* Value::to() const
 {
-	errorHandling(T_DATA);
-	const rbWindow* object = nullptr;
-	if(myValue != Qnil)
-	    Data_Get_Struct(myValue, rbWindow, object);
-	return object;
+	return DataType<rbWindow>::fetch(myValue);
 }
 
 }
\ No newline at end of file
@@ -23,6 +23,8 @@
 #define RBSFML_RBWINDOW_HPP_
 
 #include <SFML/Window/Window.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/System/Clock.hpp>
 #include "class.hpp"
 #include "rbrenderbasetype.hpp"
 
@@ -30,6 +32,7 @@
 class rbWindow;
 class rbContextSettings;
 class rbEvent;
+class rbEventLog;
 
 typedef rb::Class<rbWindow> rbWindowClass;
 
@@ -48,7 +51,8 @@ public:
 	void close();
 	bool isOpen() const;
 
-	rbContextSettings* getSettings() const;
+	rb::Value getSettings() const;
+	rb::Value getSettingsInto(rb::Value settings) const;
 
 	void setPosition(sf::Vector2i position);
 	sf::Vector2i getPosition() const;
@@ -77,8 +81,35 @@ public:
 
 	rb::Value eachEvent();
 
+	static rb::Value setEventMask(rb::Value self, const rb::Value& mask);
+	unsigned int getEventMask() const;
+	void setCoalescing(bool coalescing);
+	bool isCoalescing() const;
+	unsigned int getCoalescedCount() const;
+
+	static rb::Value setEventRecorder(rb::Value self, const rb::Value& log);
+	rb::Value getEventRecorder() const;
+	static rb::Value replayEvents(rb::Value self, const std::vector<rb::Value>& args);
+	bool isReplaying() const;
+
 private:
+	bool nextEvent(sf::Event& event, bool wait);
+	bool fetchEvent(sf::Event& event, bool wait);
+	void stopReplay();
+
 	static rbWindowClass ourDefinition;
+
+	unsigned int myEventMask;
+	bool myCoalescing;
+	unsigned int myCoalescedCount;
+	sf::Event myPendingEvent;
+	bool myHasPendingEvent;
+
+	rbEventLog* myRecorder;
+	const rbEventLog* myReplay;
+	std::size_t myReplayPosition;
+	sf::Clock myReplayClock;
+	bool myReplayRealtime;
 };
 
 namespace rb
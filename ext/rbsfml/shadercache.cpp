@@ -0,0 +1,216 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "gl.hpp"
+#include "shadercache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+	const char ourMagic[4] = {'R', 'B', 'S', 'B'};
+
+	// sf::Shader always creates its own program, so a cache hit links this
+	// trivial shader and then replaces the program contents with the binary.
+	const char ourPlaceholder[] = "void main() { gl_FragColor = vec4(0.0); }";
+
+	struct Header
+	{
+		char magic[4];
+		GLenum format;
+		GLint length;
+	};
+
+	void hash(sf::Uint64& state, const char* data, std::size_t size)
+	{
+		for(std::size_t index = 0; index < size; index++)
+		{
+			state ^= static_cast<unsigned char>(data[index]);
+			state *= 1099511628211ull;
+		}
+		// Separates the fields so "ab" + "c" and "a" + "bc" differ.
+		state ^= 0xff;
+		state *= 1099511628211ull;
+	}
+
+	void hash(sf::Uint64& state, const std::string& data)
+	{
+		hash(state, data.data(), data.size());
+	}
+
+	void hash(sf::Uint64& state, GLenum name)
+	{
+		const GLubyte* string = glGetString(name);
+		if(string)
+			hash(state, std::string(reinterpret_cast<const char*>(string)));
+	}
+
+	bool isLinked(GLuint program)
+	{
+		GLint status = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &status);
+		return status == GL_TRUE;
+	}
+
+	bool compile(sf::Shader& shader, const std::string& vertex, const std::string& fragment)
+	{
+		if(vertex.empty())
+			return shader.loadFromMemory(fragment, sf::Shader::Fragment);
+		else if(fragment.empty())
+			return shader.loadFromMemory(vertex, sf::Shader::Vertex);
+		else
+			return shader.loadFromMemory(vertex, fragment);
+	}
+}
+
+ShaderCache& ShaderCache::getShared()
+{
+	static ShaderCache cache;
+	return cache;
+}
+
+ShaderCache::ShaderCache()
+: myDirectory()
+, myHits(0)
+, myMisses(0)
+{
+}
+
+const std::string& ShaderCache::getDirectory() const
+{
+	return myDirectory;
+}
+
+void ShaderCache::setDirectory(const std::string& directory)
+{
+	myDirectory = directory;
+}
+
+bool ShaderCache::isEnabled() const
+{
+	return !myDirectory.empty();
+}
+
+unsigned int ShaderCache::getHitCount() const
+{
+	return myHits;
+}
+
+unsigned int ShaderCache::getMissCount() const
+{
+	return myMisses;
+}
+
+bool ShaderCache::load(sf::Shader& shader, const std::string& vertex, const std::string& fragment)
+{
+	gl::ensureContext();
+	if(!gl::hasProgramBinaries())
+	{
+		myMisses++;
+		return compile(shader, vertex, fragment);
+	}
+
+	const std::string path = getPath(vertex, fragment);
+	if(restore(shader, path))
+	{
+		myHits++;
+		return true;
+	}
+
+	myMisses++;
+	if(!compile(shader, vertex, fragment))
+		return false;
+	store(shader, path);
+	return true;
+}
+
+std::string ShaderCache::getPath(const std::string& vertex, const std::string& fragment) const
+{
+	sf::Uint64 state = 14695981039346656037ull;
+	hash(state, vertex);
+	hash(state, fragment);
+	hash(state, GL_VENDOR);
+	hash(state, GL_RENDERER);
+	hash(state, GL_VERSION);
+
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(state));
+	const char last = myDirectory[myDirectory.size() - 1];
+	return myDirectory + (last == '/' || last == '\\' ? "" : "/") + name;
+}
+
+bool ShaderCache::restore(sf::Shader& shader, const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	Header header;
+	if(!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+	if(!std::equal(ourMagic, ourMagic + 4, header.magic) || header.length <= 0)
+		return false;
+
+	std::vector<char> binary(header.length);
+	if(!file.read(binary.data(), binary.size()))
+		return false;
+
+	if(!shader.loadFromMemory(ourPlaceholder, sf::Shader::Fragment))
+		return false;
+
+	// A driver update can reject an old binary; the caller then compiles.
+	const GLuint program = shader.getNativeHandle();
+	glProgramBinary(program, header.format, binary.data(), binary.size());
+	return isLinked(program);
+}
+
+void ShaderCache::store(sf::Shader& shader, const std::string& path)
+{
+	// Binaries are only guaranteed to be retrievable when the program was
+	// linked with this hint, which sf::Shader doesn't set; its shaders are
+	// still attached, so relinking is enough.
+	const GLuint program = shader.getNativeHandle();
+	glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(program);
+	if(!isLinked(program))
+		return;
+
+	Header header = {{ourMagic[0], ourMagic[1], ourMagic[2], ourMagic[3]}, 0, 0};
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &header.length);
+	if(header.length <= 0)
+		return;
+
+	std::vector<char> binary(header.length);
+	GLsizei length = 0;
+	glGetProgramBinary(program, header.length, &length, &header.format, binary.data());
+	if(length <= 0)
+		return;
+	header.length = length;
+
+	// Written next to the final name first so a crash never leaves a torn file.
+	const std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if(!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) || !file.write(binary.data(), length))
+			return;
+	}
+	std::remove(path.c_str());
+	std::rename(temporary.c_str(), path.c_str());
+}
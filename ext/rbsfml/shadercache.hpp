@@ -0,0 +1,63 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_SHADERCACHE_HEADER_
+#define RBSFML_SHADERCACHE_HEADER_
+
+#include <SFML/Graphics/Shader.hpp>
+#include <string>
+
+// Keeps linked program binaries on disk, keyed by the shader sources and the
+// driver that produced them, so later launches can skip the GLSL compiler.
+// Disabled until a directory is set.
+class ShaderCache
+{
+public:
+	static ShaderCache& getShared();
+
+	ShaderCache();
+
+	const std::string& getDirectory() const;
+	void setDirectory(const std::string& directory);
+	bool isEnabled() const;
+
+	unsigned int getHitCount() const;
+	unsigned int getMissCount() const;
+
+	// Loads the shader from the cached binary when there is a matching one,
+	// otherwise compiles the sources and stores the result. An empty source
+	// means that stage isn't used.
+	bool load(sf::Shader& shader, const std::string& vertex, const std::string& fragment);
+
+private:
+	ShaderCache(const ShaderCache&) = delete;
+	ShaderCache& operator=(const ShaderCache&) = delete;
+
+	std::string getPath(const std::string& vertex, const std::string& fragment) const;
+	bool restore(sf::Shader& shader, const std::string& path);
+	void store(sf::Shader& shader, const std::string& path);
+
+	std::string myDirectory;
+	unsigned int myHits;
+	unsigned int myMisses;
+};
+
+#endif // RBSFML_SHADERCACHE_HEADER_
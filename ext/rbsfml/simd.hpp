@@ -0,0 +1,221 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_SIMD_HEADER_
+#define RBSFML_SIMD_HEADER_
+
+#include <SFML/Config.hpp>
+#include <cstring>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RBSFML_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define RBSFML_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+namespace simd
+{
+	// Pixels are handled as 32-bit lanes, so the byte order of an RGBA
+	// pixel decides where each channel ends up inside the lane.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	constexpr int RedShift = 24;
+	constexpr int GreenShift = 16;
+	constexpr int BlueShift = 8;
+	constexpr int AlphaShift = 0;
+#else
+	constexpr int RedShift = 0;
+	constexpr int GreenShift = 8;
+	constexpr int BlueShift = 16;
+	constexpr int AlphaShift = 24;
+#endif
+
+	struct Scalar
+	{
+		typedef sf::Uint32 Vector;
+		typedef float FloatVector;
+		static const unsigned int Width = 1;
+
+		static Vector load(const sf::Uint32* source) { Vector value; std::memcpy(&value, source, sizeof(value)); return value; }
+		static void store(sf::Uint32* destination, Vector value) { std::memcpy(destination, &value, sizeof(value)); }
+		static void storeBytes(sf::Uint8* destination, Vector value) { *destination = static_cast<sf::Uint8>(value); }
+		static Vector set(sf::Uint32 value) { return value; }
+		static Vector add(Vector a, Vector b) { return a + b; }
+		static Vector subtract(Vector a, Vector b) { return a - b; }
+		static Vector multiply16(Vector a, Vector b) { return a * b; }
+		static Vector bitAnd(Vector a, Vector b) { return a & b; }
+		static Vector bitOr(Vector a, Vector b) { return a | b; }
+		static Vector equal(Vector a, Vector b) { return a == b ? 0xFFFFFFFF : 0; }
+		static Vector select(Vector mask, Vector a, Vector b) { return (mask & a) | (~mask & b); }
+		template<int Count> static Vector shiftLeft(Vector a) { return a << Count; }
+		template<int Count> static Vector shiftRight(Vector a) { return a >> Count; }
+		static Vector shiftLeft(Vector a, int count) { return a << count; }
+		static Vector shiftRight(Vector a, int count) { return a >> count; }
+
+		static FloatVector toFloat(Vector a) { return static_cast<float>(a); }
+		static Vector toInteger(FloatVector a) { return static_cast<Vector>(std::nearbyint(a)); }
+		static FloatVector setFloat(float value) { return value; }
+		static FloatVector loadFloat(const float* source) { return *source; }
+		static void storeFloat(float* destination, FloatVector value) { *destination = value; }
+		static FloatVector addFloat(FloatVector a, FloatVector b) { return a + b; }
+		static FloatVector multiply(FloatVector a, FloatVector b) { return a * b; }
+		static FloatVector divide(FloatVector a, FloatVector b) { return a / b; }
+		static FloatVector minimum(FloatVector a, FloatVector b) { return a < b ? a : b; }
+		static FloatVector selectFloat(Vector mask, FloatVector a, FloatVector b) { return mask ? a : b; }
+	};
+
+#if defined(RBSFML_SIMD_SSE2)
+	struct SSE2
+	{
+		typedef __m128i Vector;
+		typedef __m128 FloatVector;
+		static const unsigned int Width = 4;
+
+		static Vector load(const sf::Uint32* source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+		static void store(sf::Uint32* destination, Vector value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), value); }
+		static void storeBytes(sf::Uint8* destination, Vector value)
+		{
+			__m128i words = _mm_packs_epi32(value, value);
+			int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+			std::memcpy(destination, &bytes, sizeof(bytes));
+		}
+		static Vector set(sf::Uint32 value) { return _mm_set1_epi32(static_cast<int>(value)); }
+		static Vector add(Vector a, Vector b) { return _mm_add_epi32(a, b); }
+		static Vector subtract(Vector a, Vector b) { return _mm_sub_epi32(a, b); }
+		static Vector multiply16(Vector a, Vector b) { return _mm_mullo_epi16(a, b); }
+		static Vector bitAnd(Vector a, Vector b) { return _mm_and_si128(a, b); }
+		static Vector bitOr(Vector a, Vector b) { return _mm_or_si128(a, b); }
+		static Vector equal(Vector a, Vector b) { return _mm_cmpeq_epi32(a, b); }
+		static Vector select(Vector mask, Vector a, Vector b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+		template<int Count> static Vector shiftLeft(Vector a) { return _mm_slli_epi32(a, Count); }
+		template<int Count> static Vector shiftRight(Vector a) { return _mm_srli_epi32(a, Count); }
+		static Vector shiftLeft(Vector a, int count) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(count)); }
+		static Vector shiftRight(Vector a, int count) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(count)); }
+
+		static FloatVector toFloat(Vector a) { return _mm_cvtepi32_ps(a); }
+		static Vector toInteger(FloatVector a) { return _mm_cvtps_epi32(a); }
+		static FloatVector setFloat(float value) { return _mm_set1_ps(value); }
+		static FloatVector loadFloat(const float* source) { return _mm_loadu_ps(source); }
+		static void storeFloat(float* destination, FloatVector value) { _mm_storeu_ps(destination, value); }
+		static FloatVector addFloat(FloatVector a, FloatVector b) { return _mm_add_ps(a, b); }
+		static FloatVector multiply(FloatVector a, FloatVector b) { return _mm_mul_ps(a, b); }
+		static FloatVector divide(FloatVector a, FloatVector b) { return _mm_div_ps(a, b); }
+		static FloatVector minimum(FloatVector a, FloatVector b) { return _mm_min_ps(a, b); }
+		static FloatVector selectFloat(Vector mask, FloatVector a, FloatVector b) { return _mm_castsi128_ps(select(mask, _mm_castps_si128(a), _mm_castps_si128(b))); }
+	};
+#endif
+
+#if defined(RBSFML_SIMD_AVX2)
+	struct AVX2
+	{
+		typedef __m256i Vector;
+		typedef __m256 FloatVector;
+		static const unsigned int Width = 8;
+
+		static Vector load(const sf::Uint32* source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)); }
+		static void store(sf::Uint32* destination, Vector value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), value); }
+		static void storeBytes(sf::Uint8* destination, Vector value)
+		{
+			__m256i words = _mm256_packs_epi32(value, value);
+			__m256i bytes = _mm256_packus_epi16(words, words);
+			int low = _mm_cvtsi128_si32(_mm256_castsi256_si128(bytes));
+			int high = _mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1));
+			std::memcpy(destination, &low, sizeof(low));
+			std::memcpy(destination + 4, &high, sizeof(high));
+		}
+		static Vector set(sf::Uint32 value) { return _mm256_set1_epi32(static_cast<int>(value)); }
+		static Vector add(Vector a, Vector b) { return _mm256_add_epi32(a, b); }
+		static Vector subtract(Vector a, Vector b) { return _mm256_sub_epi32(a, b); }
+		static Vector multiply16(Vector a, Vector b) { return _mm256_mullo_epi16(a, b); }
+		static Vector bitAnd(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+		static Vector bitOr(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+		static Vector equal(Vector a, Vector b) { return _mm256_cmpeq_epi32(a, b); }
+		static Vector select(Vector mask, Vector a, Vector b) { return _mm256_blendv_epi8(b, a, mask); }
+		template<int Count> static Vector shiftLeft(Vector a) { return _mm256_slli_epi32(a, Count); }
+		template<int Count> static Vector shiftRight(Vector a) { return _mm256_srli_epi32(a, Count); }
+		static Vector shiftLeft(Vector a, int count) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(count)); }
+		static Vector shiftRight(Vector a, int count) { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(count)); }
+
+		static FloatVector toFloat(Vector a) { return _mm256_cvtepi32_ps(a); }
+		static Vector toInteger(FloatVector a) { return _mm256_cvtps_epi32(a); }
+		static FloatVector setFloat(float value) { return _mm256_set1_ps(value); }
+		static FloatVector loadFloat(const float* source) { return _mm256_loadu_ps(source); }
+		static void storeFloat(float* destination, FloatVector value) { _mm256_storeu_ps(destination, value); }
+		static FloatVector addFloat(FloatVector a, FloatVector b) { return _mm256_add_ps(a, b); }
+		static FloatVector multiply(FloatVector a, FloatVector b) { return _mm256_mul_ps(a, b); }
+		static FloatVector divide(FloatVector a, FloatVector b) { return _mm256_div_ps(a, b); }
+		static FloatVector minimum(FloatVector a, FloatVector b) { return _mm256_min_ps(a, b); }
+		static FloatVector selectFloat(Vector mask, FloatVector a, FloatVector b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask)); }
+	};
+#endif
+
+#if defined(RBSFML_SIMD_AVX2)
+	typedef AVX2 Native;
+#elif defined(RBSFML_SIMD_SSE2)
+	typedef SSE2 Native;
+#else
+	typedef Scalar Native;
+#endif
+
+	// Operations on the four float channels of a single pixel.
+#if defined(RBSFML_SIMD_SSE2)
+	typedef SSE2 Quad;
+#else
+	typedef Scalar Quad;
+#endif
+
+	inline const char* getInstructionSet()
+	{
+#if defined(RBSFML_SIMD_AVX2)
+		return "avx2";
+#elif defined(RBSFML_SIMD_SSE2)
+		return "sse2";
+#else
+		return "scalar";
+#endif
+	}
+
+	template<typename Ops>
+	inline typename Ops::Vector channel(typename Ops::Vector pixels, int shift)
+	{
+		return Ops::bitAnd(Ops::shiftRight(pixels, shift), Ops::set(0xFF));
+	}
+
+	template<typename Ops>
+	inline typename Ops::Vector divide255(typename Ops::Vector value)
+	{
+		typename Ops::Vector rounded = Ops::add(value, Ops::set(128));
+		return Ops::template shiftRight<8>(Ops::add(rounded, Ops::template shiftRight<8>(rounded)));
+	}
+
+	template<typename Ops>
+	inline typename Ops::Vector pack(typename Ops::Vector r, typename Ops::Vector g, typename Ops::Vector b, typename Ops::Vector a)
+	{
+		return Ops::bitOr(Ops::bitOr(Ops::shiftLeft(r, RedShift), Ops::shiftLeft(g, GreenShift)),
+		                  Ops::bitOr(Ops::shiftLeft(b, BlueShift), Ops::shiftLeft(a, AlphaShift)));
+	}
+}
+
+#endif // RBSFML_SIMD_HEADER_
@@ -0,0 +1,147 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "threadpool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace
+{
+	struct ParallelForState
+	{
+		std::atomic<std::size_t> next;
+		std::size_t count;
+		std::size_t chunkSize;
+		std::size_t chunks;
+		std::size_t finished;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::function<void(std::size_t, std::size_t)> body;
+
+		void run()
+		{
+			std::size_t done = 0;
+			for(std::size_t chunk = next++; chunk < chunks; chunk = next++)
+			{
+				std::size_t begin = chunk * chunkSize;
+				body(begin, std::min(begin + chunkSize, count));
+				done++;
+			}
+			if(done > 0)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				finished += done;
+				if(finished == chunks)
+					condition.notify_all();
+			}
+		}
+	};
+}
+
+ThreadPool& ThreadPool::getShared()
+{
+	static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+	return pool;
+}
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+: myThreads()
+, myJobs()
+, myMutex()
+, myCondition()
+, myStopping(false)
+{
+	for(unsigned int index = 0; index < threadCount; index++)
+		myThreads.push_back(std::thread(&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		myStopping = true;
+	}
+	myCondition.notify_all();
+	for(std::thread& thread : myThreads)
+		thread.join();
+}
+
+unsigned int ThreadPool::getThreadCount() const
+{
+	return myThreads.size();
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body)
+{
+	if(count == 0)
+		return;
+
+	std::size_t workers = myThreads.size() + 1;
+	if(workers == 1 || count == 1)
+	{
+		body(0, count);
+		return;
+	}
+
+	std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+	state->next = 0;
+	state->count = count;
+	state->chunkSize = std::max<std::size_t>(count / (workers * 4), 1);
+	state->chunks = (count + state->chunkSize - 1) / state->chunkSize;
+	state->finished = 0;
+	state->body = body;
+
+	std::size_t helpers = std::min(myThreads.size(), state->chunks - 1);
+	for(std::size_t index = 0; index < helpers; index++)
+		enqueue([state]() { state->run(); });
+
+	state->run();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->condition.wait(lock, [&state]() { return state->finished == state->chunks; });
+}
+
+void ThreadPool::enqueue(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(myMutex);
+		myJobs.push_back(std::move(job));
+	}
+	myCondition.notify_one();
+}
+
+void ThreadPool::work()
+{
+	for(;;)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(myMutex);
+			myCondition.wait(lock, [this]() { return myStopping || !myJobs.empty(); });
+			if(myStopping && myJobs.empty())
+				return;
+			job = std::move(myJobs.front());
+			myJobs.pop_front();
+		}
+		job();
+	}
+}
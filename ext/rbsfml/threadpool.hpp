@@ -0,0 +1,59 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_THREADPOOL_HEADER_
+#define RBSFML_THREADPOOL_HEADER_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	static ThreadPool& getShared();
+
+	explicit ThreadPool(unsigned int threadCount);
+	~ThreadPool();
+
+	unsigned int getThreadCount() const;
+
+	void parallelFor(std::size_t count, const std::function<void(std::size_t, std::size_t)>& body);
+
+private:
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void enqueue(std::function<void()> job);
+	void work();
+
+	std::vector<std::thread> myThreads;
+	std::deque<std::function<void()>> myJobs;
+	std::mutex myMutex;
+	std::condition_variable myCondition;
+	bool myStopping;
+};
+
+#endif // RBSFML_THREADPOOL_HEADER_
@@ -0,0 +1,295 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "gl.hpp"
+#include "uniformcache.hpp"
+#include "rbshader.hpp"
+#include "rbvector2.hpp"
+#include "rbvector3.hpp"
+#include "rbcolor.hpp"
+#include "rbtexture.hpp"
+#include "rbtransform.hpp"
+#include "error.hpp"
+#include <cstring>
+
+namespace
+{
+	UniformValue makeFloats(const float* values, unsigned int count)
+	{
+		UniformValue result;
+		result.count = count;
+		std::memcpy(result.floats, values, count * sizeof(float));
+		return result;
+	}
+
+	// Turns a converted value into exactly what the declared GLSL type needs,
+	// returning false when the two don't fit together.
+	bool pack(GLenum type, const UniformValue& value, UniformValue& packed)
+	{
+		packed = value;
+		switch(type)
+		{
+			case GL_FLOAT:
+				if(value.kind == UniformValue::Kind::Integer)
+				{
+					const float converted = static_cast<float>(value.integer);
+					packed = makeFloats(&converted, 1);
+					return true;
+				}
+				return value.kind == UniformValue::Kind::Floats && value.count == 1;
+			case GL_FLOAT_VEC2:
+				return value.kind == UniformValue::Kind::Floats && value.count == 2;
+			case GL_FLOAT_VEC3:
+				return value.kind == UniformValue::Kind::Floats && value.count == 3;
+			case GL_FLOAT_VEC4:
+				return value.kind == UniformValue::Kind::Floats && value.count == 4;
+			case GL_FLOAT_MAT3:
+				if(value.kind == UniformValue::Kind::Floats && value.count == 16)
+				{
+					const unsigned int indices[9] = {0, 1, 3, 4, 5, 7, 12, 13, 15};
+					for(unsigned int index = 0; index < 9; index++)
+						packed.floats[index] = value.floats[indices[index]];
+					packed.count = 9;
+					return true;
+				}
+				return value.kind == UniformValue::Kind::Floats && value.count == 9;
+			case GL_FLOAT_MAT4:
+				return value.kind == UniformValue::Kind::Floats && value.count == 16;
+			case GL_INT:
+			case GL_BOOL:
+				return value.kind == UniformValue::Kind::Integer;
+			case GL_SAMPLER_2D:
+				return value.kind == UniformValue::Kind::Texture || value.kind == UniformValue::Kind::CurrentTexture;
+			default:
+				return false;
+		}
+	}
+
+	void upload(GLenum type, GLint location, const UniformValue& value)
+	{
+		switch(type)
+		{
+			case GL_FLOAT:      glUniform1fv(location, 1, value.floats); break;
+			case GL_FLOAT_VEC2: glUniform2fv(location, 1, value.floats); break;
+			case GL_FLOAT_VEC3: glUniform3fv(location, 1, value.floats); break;
+			case GL_FLOAT_VEC4: glUniform4fv(location, 1, value.floats); break;
+			case GL_FLOAT_MAT3: glUniformMatrix3fv(location, 1, GL_FALSE, value.floats); break;
+			case GL_FLOAT_MAT4: glUniformMatrix4fv(location, 1, GL_FALSE, value.floats); break;
+			case GL_INT:
+			case GL_BOOL:       glUniform1i(location, value.integer); break;
+		}
+	}
+}
+
+UniformValue UniformValue::convert(const rb::Value& value)
+{
+	UniformValue result;
+	switch(value.getType())
+	{
+		case rb::ValueType::Float:
+		{
+			const float converted = value.to<float>();
+			return makeFloats(&converted, 1);
+		}
+		case rb::ValueType::Fixnum:
+			result.kind = Kind::Integer;
+			result.integer = value.to<int>();
+			return result;
+		case rb::ValueType::Bool:
+			result.kind = Kind::Integer;
+			result.integer = value.to<bool>() ? 1 : 0;
+			return result;
+		case rb::ValueType::Array:
+		{
+			const std::vector<rb::Value>& elements = value.to<const std::vector<rb::Value>&>();
+			if(elements.empty() || elements.size() > 16)
+				rb::raise(rb::ArgumentError, "expected 1 to 16 uniform elements, got %u", static_cast<unsigned int>(elements.size()));
+			result.count = elements.size();
+			for(unsigned int index = 0; index < result.count; index++)
+				result.floats[index] = elements[index].to<float>();
+			return result;
+		}
+		default:
+			break;
+	}
+
+	if(value.isKindOf(rb::Value(rbVector2::getDefinition())))
+	{
+		sf::Vector2f vector = value.to<sf::Vector2f>();
+		const float values[2] = {vector.x, vector.y};
+		return makeFloats(values, 2);
+	}
+	else if(value.isKindOf(rb::Value(rbVector3::getDefinition())))
+	{
+		sf::Vector3f vector = value.to<sf::Vector3f>();
+		const float values[3] = {vector.x, vector.y, vector.z};
+		return makeFloats(values, 3);
+	}
+	else if(value.isKindOf(rb::Value(rbColor::getDefinition())))
+	{
+		sf::Color color = value.to<sf::Color>();
+		const float values[4] = {color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f};
+		return makeFloats(values, 4);
+	}
+	else if(rb::DataType<rbTransform>::isInstance(value))
+	{
+		return makeFloats(value.to<const sf::Transform&>().getMatrix(), 16);
+	}
+	else if(rb::DataType<rbTexture>::isInstance(value))
+	{
+		result.kind = Kind::Texture;
+		result.texture = &value.to<const sf::Texture&>();
+		return result;
+	}
+	else if(rbShader::isCurrentTexture(value))
+	{
+		result.kind = Kind::CurrentTexture;
+		return result;
+	}
+
+	rb::expectedTypes("Float", "Integer", "Array", "SFML::Vector2", "SFML::Vector3", "SFML::Color", "SFML::Transform", "SFML::Texture");
+	return result;
+}
+
+UniformValue::UniformValue()
+: kind(Kind::Floats)
+, count(0)
+, floats()
+, integer(0)
+, texture(nullptr)
+{
+}
+
+bool UniformValue::operator==(const UniformValue& other) const
+{
+	if(kind != other.kind)
+		return false;
+	switch(kind)
+	{
+		case Kind::Floats:
+			return count == other.count && std::memcmp(floats, other.floats, count * sizeof(float)) == 0;
+		case Kind::Integer:
+			return integer == other.integer;
+		case Kind::Texture:
+			return texture == other.texture;
+		default:
+			return true;
+	}
+}
+
+bool UniformValue::operator!=(const UniformValue& other) const
+{
+	return !(*this == other);
+}
+
+UniformCache::UniformCache()
+: myEntries()
+, myPending()
+, myProgram(0)
+, myGeneration(1)
+{
+}
+
+unsigned int UniformCache::apply(sf::Shader& shader, const UniformList& values)
+{
+	gl::ensureContext();
+	if(!gl::initialize() || !GLEW_VERSION_2_0)
+		rb::raise(rb::RuntimeError, "shader uniforms need OpenGL 2.0");
+
+	if(shader.getNativeHandle() != myProgram)
+		load(shader.getNativeHandle());
+	if(myProgram == 0)
+		return 0;
+
+	// Everything that can raise happens before the program gets bound.
+	myPending.clear();
+	for(const auto& value : values)
+	{
+		auto found = myEntries.find(value.first);
+		if(found == myEntries.end())
+			continue;
+
+		Entry& entry = found->second;
+		Pending pending = {&entry, &value.first, UniformValue()};
+		if(!pack(entry.type, value.second, pending.value))
+			rb::raise(rb::TypeError, "value for uniform '%s' doesn't match its declared type", value.first.c_str());
+		if(entry.generation == myGeneration && entry.last == pending.value)
+			continue;
+		myPending.push_back(pending);
+	}
+
+	if(!myPending.empty())
+	{
+		gl::ProgramBinding binding(myProgram);
+		for(Pending& pending : myPending)
+		{
+			// Texture units belong to sf::Shader, so samplers go through it.
+			if(pending.value.kind == UniformValue::Kind::Texture)
+				shader.setParameter(*pending.name, *pending.value.texture);
+			else if(pending.value.kind == UniformValue::Kind::CurrentTexture)
+				shader.setParameter(*pending.name, sf::Shader::CurrentTexture);
+			else
+				upload(pending.entry->type, pending.entry->location, pending.value);
+			pending.entry->last = pending.value;
+			pending.entry->generation = myGeneration;
+		}
+	}
+	return myPending.size();
+}
+
+void UniformCache::invalidate()
+{
+	myGeneration++;
+}
+
+void UniformCache::reset()
+{
+	myEntries.clear();
+	myProgram = 0;
+}
+
+void UniformCache::load(unsigned int program)
+{
+	myEntries.clear();
+	myProgram = program;
+	if(myProgram == 0)
+		return;
+
+	GLint count = 0;
+	glGetProgramiv(myProgram, GL_ACTIVE_UNIFORMS, &count);
+	for(GLint index = 0; index < count; index++)
+	{
+		GLchar buffer[256];
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(myProgram, index, sizeof(buffer), &length, &size, &type, buffer);
+
+		// Arrays are reported as "name[0]"; store them under the plain name.
+		std::string name(buffer, length);
+		if(name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+			name.erase(name.size() - 3);
+
+		Entry entry = {glGetUniformLocation(myProgram, name.c_str()), type, 0, UniformValue()};
+		if(entry.location != -1)
+			myEntries[name] = entry;
+	}
+}
@@ -0,0 +1,101 @@
+/* rbSFML
+ * Copyright (c) 2015 Henrik Valter Vogelius Hansson - groogy@groogy.se
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef RBSFML_UNIFORMCACHE_HEADER_
+#define RBSFML_UNIFORMCACHE_HEADER_
+
+#include <SFML/Graphics/Shader.hpp>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "value.hpp"
+
+// A uniform value converted from Ruby once, so it can be compared against
+// the last upload and sent without touching the Ruby object again.
+struct UniformValue
+{
+	enum class Kind
+	{
+		Floats,
+		Integer,
+		Texture,
+		CurrentTexture
+	};
+
+	static UniformValue convert(const rb::Value& value);
+
+	UniformValue();
+
+	bool operator==(const UniformValue& other) const;
+	bool operator!=(const UniformValue& other) const;
+
+	Kind kind;
+	unsigned int count;
+	float floats[16];
+	int integer;
+	const sf::Texture* texture;
+};
+
+typedef std::vector<std::pair<std::string, UniformValue>> UniformList;
+
+// Remembers the active uniforms of a shader program together with the value
+// last uploaded to each of them, so unchanged values are skipped entirely.
+class UniformCache
+{
+public:
+	UniformCache();
+
+	// Uploads the values with the program bound once and returns how many
+	// uniforms were actually written. Unknown names are ignored.
+	unsigned int apply(sf::Shader& shader, const UniformList& values);
+
+	// Forgets the uploaded values, for when uniforms were set another way.
+	void invalidate();
+
+	// Drops everything known about the program, for when it was relinked.
+	void reset();
+
+private:
+	struct Entry
+	{
+		int location;
+		unsigned int type;
+		unsigned int generation;
+		UniformValue last;
+	};
+
+	struct Pending
+	{
+		Entry* entry;
+		const std::string* name;
+		UniformValue value;
+	};
+
+	void load(unsigned int program);
+
+	std::unordered_map<std::string, Entry> myEntries;
+	std::vector<Pending> myPending;
+	unsigned int myProgram;
+	unsigned int myGeneration;
+};
+
+#endif // RBSFML_UNIFORMCACHE_HEADER_
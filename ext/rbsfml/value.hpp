@@ -28,7 +28,7 @@
 
 namespace rb
 {
-	template<typename Base, int MaxFunctions>
+	template<typename Base>
 	class Module;
 	class Object;
 
@@ -62,8 +62,8 @@ namespace rb
 		explicit Value(const rb::Object* object);
 		explicit Value(const std::vector<Value>& collection);
 
-		template<typename Base, int MaxFunctions>
-		explicit Value(const Module<Base, MaxFunctions>& module);
+		template<typename Base>
+		explicit Value(const Module<Base>& module);
 
 		~Value();
 
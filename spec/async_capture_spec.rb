@@ -0,0 +1,55 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::AsyncCapture do
+  before(:each) do
+    @target = SFML::RenderTexture.new(64, 32)
+    @capture = SFML::AsyncCapture.new(@target, 2)
+  end
+
+  describe "in creation" do
+    it "should use the given amount of buffers" do
+      expect(@capture.buffer_count).to be(2)
+      expect(@capture.pending).to be(0)
+    end
+
+    it "should reject a single buffer" do
+      expect { SFML::AsyncCapture.new(@target, 1) }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe "in usage" do
+    it "should return nothing when no capture is pending" do
+      expect(@capture.poll).to be_nil
+      expect(@capture.wait).to be_nil
+    end
+
+    it "should hand back the captured frame" do
+      @target.clear(SFML::Color.new(255, 0, 0))
+      @target.display
+      @capture.capture
+      expect(@capture.pending).to be(1)
+      image = @capture.wait
+      expect(image.size.x).to be(64)
+      expect(image.get_pixel(10, 10) == SFML::Color.new(255, 0, 0)).to be_truthy
+      expect(@capture.pending).to be(0)
+    end
+
+    it "should return packed pixels as a string" do
+      @capture.capture
+      @capture.capture
+      data = nil
+      100.times do
+        data = @capture.poll_string
+        break if data
+        sleep 0.01
+      end
+      expect(data.bytesize).to be(64 * 32 * 4)
+    end
+
+    it "should drop the oldest capture when the ring is full" do
+      3.times { @capture.capture }
+      expect(@capture.pending).to be(2)
+      expect(@capture.dropped).to be(1)
+    end
+  end
+end
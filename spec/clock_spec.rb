@@ -30,4 +30,21 @@ describe SFML::Clock do
       end
     end
   end
-end
\ No newline at end of file
+
+  describe "will give elapsed time as a number" do
+    context "after twenty milliseconds has passed" do
+      clock = SFML::Clock.new
+      SFML.sleep(SFML.milliseconds(20))
+
+      it "returns integer microseconds" do
+        expect(clock.elapsed_microseconds).to be_kind_of(Integer)
+        expect(clock.elapsed_microseconds).to be > 18000
+      end
+
+      it "restarts returning integer microseconds" do
+        expect(clock.restart_microseconds).to be > 18000
+        expect(clock.elapsed_microseconds).to be < 18000
+      end
+    end
+  end
+end
@@ -0,0 +1,96 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::EventLog do
+  def mouse_move(x, y)
+    event = SFML::MouseMoveEvent.new
+    event.type = SFML::Event::MouseMoved
+    event.x = x
+    event.y = y
+    event
+  end
+
+  def key_press(code)
+    event = SFML::KeyEvent.new
+    event.type = SFML::Event::KeyPressed
+    event.code = code
+    event.shift = true
+    event
+  end
+
+  before(:each) do
+    @log = SFML::EventLog.new
+    @log.add(mouse_move(1, 2), 0)
+    @log.add(mouse_move(3, 4), 1000)
+    @log.add(key_press(SFML::Keyboard::A), 1500)
+    @log.add(mouse_move(5, 6), 2000)
+  end
+
+  describe "in creation" do
+    it "should keep events in order" do
+      expect(@log.size).to eq(4)
+      expect(@log.duration).to eq(2000)
+      expect { @log.add(mouse_move(0, 0), 10) }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe "in serialization" do
+    it "should survive a round trip through its binary form" do
+      copy = SFML::EventLog.parse(@log.dump)
+      expect(copy.size).to eq(@log.size)
+      expect(copy.duration).to eq(@log.duration)
+      expect(copy.dump).to eq(@log.dump)
+    end
+
+    it "should be marshalable" do
+      expect(Marshal.load(Marshal.dump(@log)).dump).to eq(@log.dump)
+    end
+
+    it "should reject data that isn't an event log" do
+      expect { SFML::EventLog.parse("garbage") }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe "in replay" do
+    before(:each) do
+      @window = SFML::Window.new
+      @window.replay_events(@log, false)
+    end
+
+    it "should deliver the recorded events" do
+      events = []
+      @window.each_event { |event| events << event }
+      expect(events.map(&:type)).to eq([SFML::Event::MouseMoved, SFML::Event::MouseMoved, SFML::Event::KeyPressed, SFML::Event::MouseMoved])
+      expect([events[1].x, events[1].y]).to eq([3, 4])
+      expect(events[2].code).to eq(SFML::Keyboard::A)
+      expect(events[2].shift).to be_truthy
+    end
+
+    it "should stop once every event was delivered" do
+      @window.each_event { }
+      expect(@window.replaying?).to be_falsy
+    end
+
+    it "should apply the event mask" do
+      @window.event_mask = [SFML::Event::KeyPressed]
+      events = []
+      @window.each_event { |event| events << event }
+      expect(events.size).to eq(1)
+    end
+
+    it "should coalesce consecutive motion" do
+      @window.coalesce_motion = true
+      events = []
+      @window.each_event { |event| events << event }
+      expect(events.size).to eq(3)
+      expect([events[0].x, events[0].y]).to eq([3, 4])
+      expect(@window.coalesced_count).to eq(1)
+    end
+
+    it "should record what it replays" do
+      recorded = SFML::EventLog.new
+      @window.event_recorder = recorded
+      @window.each_event { }
+      expect(recorded.size).to eq(@log.size)
+    end
+  end
+end
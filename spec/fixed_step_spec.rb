@@ -0,0 +1,34 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::FixedStep do
+  describe "advance" do
+    context "given a 10 millisecond step" do
+      step = SFML::FixedStep.new(SFML.milliseconds(10))
+
+      it "returns the number of whole steps" do
+        expect(step.advance(25000)).to eq(2)
+      end
+
+      it "keeps the remainder as alpha" do
+        expect(step.alpha).to be_within(0.001).of(0.5)
+      end
+
+      it "carries the remainder into the next frame" do
+        expect(step.advance(SFML.milliseconds(5))).to eq(1)
+        expect(step.accumulated_microseconds).to eq(0)
+      end
+    end
+
+    context "given a long stall" do
+      step = SFML::FixedStep.new(0.01, 4)
+
+      it "clamps the number of steps" do
+        expect(step.advance(1.0)).to eq(4)
+      end
+
+      it "reports the dropped time" do
+        expect(step.dropped_microseconds).to eq(960000)
+      end
+    end
+  end
+end
@@ -0,0 +1,74 @@
+require './lib/sfml/rbsfml.so'
+require 'tmpdir'
+
+describe SFML::FrameRecorder do
+  before(:each) do
+    @dir = Dir.mktmpdir
+    @image = SFML::Image.new(6, 4, SFML::Color.new(255, 255, 255))
+  end
+
+  after(:each) do
+    FileUtils.remove_entry(@dir)
+  end
+
+  describe "in creation" do
+    it "should reject unknown formats" do
+      expect { SFML::FrameRecorder.new(nil, File.join(@dir, "out"), format: :avi) }.to raise_error(ArgumentError)
+    end
+
+    it "should need a frame number in ppm paths" do
+      expect { SFML::FrameRecorder.new(nil, File.join(@dir, "frame.ppm"), format: :ppm) }.to raise_error(ArgumentError)
+    end
+
+    it "should not record without a render target" do
+      recorder = SFML::FrameRecorder.new(nil, File.join(@dir, "out.y4m"))
+      expect { recorder.record }.to raise_error(RuntimeError)
+      recorder.close
+    end
+  end
+
+  describe "in usage" do
+    it "should write a y4m stream" do
+      path = File.join(@dir, "out.y4m")
+      recorder = SFML::FrameRecorder.new(nil, path, fps: 30, policy: :block)
+      recorder << @image << @image
+      expect(recorder.close).to be(2)
+      expect(recorder.closed?).to be(true)
+
+      data = File.binread(path)
+      header = "YUV4MPEG2 W6 H4 F30:1 Ip A1:1 C420jpeg\n"
+      expect(data[0, header.size]).to eq(header)
+      expect(data.bytesize).to eq(header.size + 2 * ("FRAME\n".size + 6 * 4 + 3 * 2 * 2))
+      expect(data.getbyte(header.size + "FRAME\n".size)).to be(255)
+    end
+
+    it "should write raw rgba frames" do
+      path = File.join(@dir, "out.rgba")
+      recorder = SFML::FrameRecorder.new(nil, path, policy: :block)
+      recorder.add_image(@image)
+      recorder.close
+      expect(File.size(path)).to be(6 * 4 * 4)
+    end
+
+    it "should write a ppm sequence" do
+      recorder = SFML::FrameRecorder.new(nil, File.join(@dir, "frame_%03d.ppm"), policy: :block)
+      recorder << @image << @image
+      recorder.close
+      expect(File.exist?(File.join(@dir, "frame_000.ppm"))).to be(true)
+      expect(File.binread(File.join(@dir, "frame_001.ppm"))[0, 2]).to eq("P6")
+    end
+
+    it "should skip frames that change size" do
+      recorder = SFML::FrameRecorder.new(nil, File.join(@dir, "out.y4m"), policy: :block)
+      recorder << @image << SFML::Image.new(8, 8, SFML::Color.new(0, 0, 0))
+      expect(recorder.close).to be(1)
+      expect(recorder.frames_dropped).to be(1)
+    end
+
+    it "should refuse frames once closed" do
+      recorder = SFML::FrameRecorder.new(nil, File.join(@dir, "out.y4m"))
+      recorder.close
+      expect { recorder << @image }.to raise_error(RuntimeError)
+    end
+  end
+end
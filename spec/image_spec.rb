@@ -0,0 +1,210 @@
+require './lib/sfml/rbsfml.so'
+require 'stringio'
+require 'tmpdir'
+
+describe SFML::Image do
+  describe "kernels" do
+    context "premultiply_alpha" do
+      it "should scale the color channels by alpha" do
+        obj = SFML::Image.new(9, 3, SFML::Color.new(200, 100, 50, 128))
+        obj.premultiply_alpha
+        expect(obj.get_pixel(8, 2) == SFML::Color.new(100, 50, 25, 128)).to be_truthy
+      end
+
+      it "should round trip through unpremultiply_alpha" do
+        obj = SFML::Image.new(9, 3, SFML::Color.new(200, 100, 50, 128))
+        obj.premultiply_alpha
+        obj.unpremultiply_alpha
+        pixel = obj.get_pixel(4, 1)
+        expect((pixel.r - 200).abs).to be <= 2
+        expect((pixel.g - 100).abs).to be <= 2
+        expect(pixel.a).to be(128)
+      end
+
+      it "should clear fully transparent pixels on unpremultiply_alpha" do
+        obj = SFML::Image.new(5, 5, SFML::Color.new(10, 20, 30, 0))
+        obj.unpremultiply_alpha
+        expect(obj.get_pixel(4, 4) == SFML::Color.new(0, 0, 0, 0)).to be_truthy
+      end
+    end
+
+    context "create_mask_from_color" do
+      it "should only change matching pixels" do
+        obj = SFML::Image.new(7, 7, SFML::Color.new(255, 0, 255))
+        obj.set_pixel(3, 3, SFML::Color.new(1, 2, 3))
+        obj.create_mask_from_color(SFML::Color.new(255, 0, 255), 0)
+        expect(obj.get_pixel(0, 0).a).to be(0)
+        expect(obj.get_pixel(3, 3).a).to be(255)
+      end
+    end
+
+    context "tint and grayscale" do
+      it "should multiply every channel with the tint" do
+        obj = SFML::Image.new(6, 6, SFML::Color.new(255, 255, 255))
+        obj.tint(SFML::Color.new(255, 0, 128))
+        expect(obj.get_pixel(5, 5) == SFML::Color.new(255, 0, 128)).to be_truthy
+      end
+
+      it "should produce equal color channels" do
+        obj = SFML::Image.new(6, 6, SFML::Color.new(255, 0, 0))
+        obj.grayscale
+        pixel = obj.get_pixel(2, 2)
+        expect(pixel.r).to be(77)
+        expect(pixel.g).to be(77)
+        expect(pixel.b).to be(77)
+      end
+    end
+
+    context "swizzle" do
+      it "should accept a channel string" do
+        obj = SFML::Image.new(6, 6, SFML::Color.new(1, 2, 3, 4))
+        obj.swizzle("bgra")
+        expect(obj.get_pixel(1, 1) == SFML::Color.new(3, 2, 1, 4)).to be_truthy
+      end
+
+      it "should accept an array of channel indices" do
+        obj = SFML::Image.new(6, 6, SFML::Color.new(1, 2, 3, 4))
+        obj.swizzle([3, 3, 3, 0])
+        expect(obj.get_pixel(1, 1) == SFML::Color.new(4, 4, 4, 1)).to be_truthy
+      end
+
+      it "should reject unknown channels" do
+        obj = SFML::Image.new(2, 2, SFML::Color.new(1, 2, 3, 4))
+        expect { obj.swizzle("rgbx") }.to raise_error(ArgumentError)
+      end
+    end
+
+    context "blit and fill_rect" do
+      it "should blend the source over the destination" do
+        obj = SFML::Image.new(10, 10, SFML::Color.new(0, 0, 0))
+        source = SFML::Image.new(4, 4, SFML::Color.new(255, 255, 255, 255))
+        obj.blit(source, 8, 8)
+        expect(obj.get_pixel(9, 9) == SFML::Color.new(255, 255, 255)).to be_truthy
+        expect(obj.get_pixel(7, 7) == SFML::Color.new(0, 0, 0)).to be_truthy
+      end
+
+      it "should keep the destination under transparent source pixels" do
+        obj = SFML::Image.new(10, 10, SFML::Color.new(10, 20, 30))
+        source = SFML::Image.new(10, 10, SFML::Color.new(255, 255, 255, 0))
+        obj.blit(source, 0, 0)
+        expect(obj.get_pixel(5, 5) == SFML::Color.new(10, 20, 30)).to be_truthy
+      end
+
+      it "should clip the filled rectangle to the image" do
+        obj = SFML::Image.new(10, 10, SFML::Color.new(0, 0, 0))
+        obj.fill_rect(SFML::Rect.new(-5, -5, 10, 10), SFML::Color.new(1, 2, 3))
+        expect(obj.get_pixel(4, 4) == SFML::Color.new(1, 2, 3)).to be_truthy
+        expect(obj.get_pixel(5, 5) == SFML::Color.new(0, 0, 0)).to be_truthy
+      end
+    end
+  end
+
+  describe "resize" do
+    [:box, :bilinear, :lanczos].each do |filter|
+      context "with the #{filter} filter" do
+        obj = SFML::Image.new(37, 23, SFML::Color.new(200, 100, 50, 128))
+        result = obj.resize(11, 50, filter: filter)
+
+        it "should return an image of the requested size" do
+          expect(result.size.x).to be(11)
+          expect(result.size.y).to be(50)
+        end
+
+        it "should keep a solid color" do
+          pixel = result.get_pixel(5, 25)
+          expect((pixel.r - 200).abs).to be <= 1
+          expect((pixel.g - 100).abs).to be <= 1
+          expect(pixel.a).to be(128)
+        end
+
+        it "should leave the source untouched" do
+          expect(obj.size.x).to be(37)
+        end
+      end
+    end
+
+    it "should average pixels when downscaling with the box filter" do
+      obj = SFML::Image.new(2, 2, SFML::Color.new(0, 0, 0))
+      obj.set_pixel(0, 0, SFML::Color.new(255, 255, 255))
+      obj.set_pixel(1, 1, SFML::Color.new(255, 255, 255))
+      expect(obj.resize(1, 1, filter: :box).get_pixel(0, 0).r).to be(128)
+    end
+
+    it "should not bleed the color of transparent pixels" do
+      obj = SFML::Image.new(2, 1, SFML::Color.new(0, 255, 0, 0))
+      obj.set_pixel(0, 0, SFML::Color.new(255, 0, 0, 255))
+      pixel = obj.resize(1, 1, filter: :box).get_pixel(0, 0)
+      expect(pixel.r).to be(255)
+      expect(pixel.g).to be(0)
+    end
+
+    it "should reject unknown filters" do
+      obj = SFML::Image.new(4, 4, SFML::Color.new(0, 0, 0))
+      expect { obj.resize(2, 2, filter: :cubic) }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe "encoding" do
+    obj = SFML::Image.new(16, 8, SFML::Color.new(10, 20, 30, 40))
+
+    context "save_to_memory" do
+      it "should return a binary PNG" do
+        data = obj.save_to_memory("png")
+        expect(data.encoding).to eq(Encoding::ASCII_8BIT)
+        expect(data[0, 8]).to eq("\x89PNG\r\n\x1A\n".b)
+      end
+
+      it "should support BMP and TGA" do
+        expect(obj.save_to_memory("bmp")[0, 2]).to eq("BM")
+        expect(obj.save_to_memory("tga").bytesize).to eq(18 + 16 * 8 * 4)
+      end
+
+      it "should reject unsupported formats" do
+        expect { obj.save_to_memory("gif") }.to raise_error(ArgumentError)
+      end
+    end
+
+    context "save_async" do
+      it "should write the file on the encoder thread" do
+        Dir.mktmpdir do |dir|
+          path = File.join(dir, "shot.png")
+          request = obj.save_async(path)
+          expect(request.wait).to be(true)
+          expect(request.done?).to be(true)
+          expect(File.binread(path)).to eq(obj.save_to_memory("png"))
+        end
+      end
+
+      it "should write to an IO when waited on" do
+        io = StringIO.new("".b)
+        request = obj.save_async(io, format: :tga)
+        expect(request.wait).to be(true)
+        expect(io.string).to eq(obj.save_to_memory("tga"))
+      end
+
+      it "should write to an IO without being waited on" do
+        io = StringIO.new("".b)
+        obj.save_async(io, format: :tga)
+        obj.save_async(StringIO.new("".b), format: :tga).wait
+        expect(io.string).to eq(obj.save_to_memory("tga"))
+      end
+
+      it "should fail to encode a TGA larger than 65535 pixels" do
+        wide = SFML::Image.new(65536, 1, SFML::Color.new(0, 0, 0))
+        expect { wide.save_to_memory("tga") }.to raise_error(RuntimeError)
+        expect(wide.save_async(StringIO.new("".b), format: :tga).wait).to be(false)
+      end
+
+      it "should require a format it can guess" do
+        expect { obj.save_async("shot.unknown") }.to raise_error(ArgumentError)
+      end
+
+      it "should have a configurable queue capacity" do
+        previous = SFML::Image.save_queue_capacity
+        SFML::Image.save_queue_capacity = 2
+        expect(SFML::Image.save_queue_capacity).to be(2)
+        SFML::Image.save_queue_capacity = previous
+      end
+    end
+  end
+end
@@ -0,0 +1,46 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::Input do
+  before(:each) do
+    @input = SFML::Input.snapshot
+  end
+
+  describe "in capturing" do
+    it "should count captured frames" do
+      expect(@input.frame).to eq(1)
+      @input.capture
+      expect(@input.frame).to eq(2)
+    end
+
+    it "should return itself" do
+      expect(@input.capture).to equal(@input)
+    end
+
+    it "should refuse to capture into a frozen snapshot" do
+      @input.freeze
+      expect { @input.capture }.to raise_error(RuntimeError)
+    end
+  end
+
+  describe "in querying" do
+    it "should expose the mouse position as plain integers" do
+      expect(@input.mouse_position).to eq(SFML::Vector2.new(@input.mouse_x, @input.mouse_y))
+    end
+
+    it "should treat out of range keys and buttons as released" do
+      expect(@input.key_pressed?(SFML::Keyboard::KeyCount)).to be_falsy
+      expect(@input.button_pressed?(SFML::Mouse::ButtonCount)).to be_falsy
+    end
+
+    it "should report disconnected joysticks as idle" do
+      index = (0...SFML::Joystick::Count).find { |i| !@input.joystick_connected?(i) }
+      next if index.nil?
+      expect(@input.joystick_button_pressed?(index, 0)).to be_falsy
+      expect(@input.joystick_axis_position(index, SFML::Joystick::X)).to eq(0.0)
+    end
+
+    it "should treat out of range joysticks as disconnected" do
+      expect(@input.joystick_connected?(SFML::Joystick::Count)).to be_falsy
+    end
+  end
+end
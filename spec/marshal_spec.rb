@@ -0,0 +1,125 @@
+require './lib/sfml/rbsfml.so'
+
+describe "Marshal" do
+  def round_trip(object)
+    Marshal.load(Marshal.dump(object))
+  end
+
+  describe SFML::Vector2 do
+    it "should keep the component classes" do
+      copy = round_trip(SFML::Vector2.new(-3, 2.5))
+      expect(copy.x).to be(-3)
+      expect(copy.y).to eq(2.5)
+      expect(copy.y).to be_a(Float)
+    end
+  end
+
+  describe SFML::Vector3 do
+    it "should survive a round trip" do
+      copy = round_trip(SFML::Vector3.new(1, 2.25, -1000000))
+      expect(copy == SFML::Vector3.new(1, 2.25, -1000000)).to be_truthy
+    end
+  end
+
+  describe SFML::Color do
+    it "should store channels as bytes" do
+      color = SFML::Color.new(10, 20, 30, 40)
+      expect(color._dump(-1).bytesize).to eq(5)
+      expect(round_trip(color) == color).to be_truthy
+    end
+
+    it "should keep channels outside of the byte range" do
+      color = SFML::Color.new
+      color.r = 0.5
+      expect(round_trip(color).r).to eq(0.5)
+    end
+  end
+
+  describe SFML::Rect do
+    it "should keep integer and float rects apart" do
+      expect(round_trip(SFML::Rect.new(1, -2, 30, 40)).left).to be(1)
+      copy = round_trip(SFML::Rect.new(0.5, 1, 2, 3))
+      expect(copy.left).to eq(0.5)
+      expect(copy == SFML::Rect.new(0.5, 1, 2, 3)).to be_truthy
+    end
+  end
+
+  describe SFML::Transform do
+    it "should survive a round trip" do
+      transform = SFML::Transform.new.translate([10.0, 20.0]).rotate(30.0).scale([2.0, 3.0])
+      expect(round_trip(transform).to_a).to eq(transform.to_a)
+    end
+  end
+
+  describe SFML::Image do
+    before(:each) do
+      @image = SFML::Image.new(64, 32, SFML::Color.new(1, 2, 3, 4))
+      @image.set_pixel(63, 31, SFML::Color.new(200, 100, 50, 25))
+    end
+
+    it "should keep every channel of every pixel" do
+      copy = round_trip(@image)
+      expect(copy.size).to eq(@image.size)
+      expect(copy.get_pixel(0, 0) == SFML::Color.new(1, 2, 3, 4)).to be_truthy
+      expect(copy.get_pixel(63, 31) == SFML::Color.new(200, 100, 50, 25)).to be_truthy
+    end
+
+    it "should compress unless disabled" do
+      compressed = Marshal.dump(@image).bytesize
+      begin
+        SFML.marshal_compression = false
+        expect(Marshal.dump(@image).bytesize).to be > 64 * 32 * 4
+        expect(round_trip(@image).get_pixel(63, 31).r).to be(200)
+      ensure
+        SFML.marshal_compression = true
+      end
+      expect(compressed).to be < 64 * 32 * 4
+    end
+
+    it "should reject malformed data" do
+      data = @image._dump(-1)
+      expect { SFML::Image._load(data[0, 20]) }.to raise_error(ArgumentError)
+      expect { SFML::Image._load("\x7f") }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe SFML::VertexArray do
+    it "should survive a round trip" do
+      array = SFML::VertexArray.new(SFML::Triangles)
+      array.append(SFML::Vertex.new(SFML::Vector2.new(1.5, 2.0), SFML::Color.new(9, 8, 7), SFML::Vector2.new(3.0, 4.0)))
+      array.append(SFML::Vertex.new(SFML::Vector2.new(-1.0, 0.0)))
+      copy = round_trip(array)
+      expect(copy.primitive_type).to eq(SFML::Triangles)
+      expect(copy.vertex_count).to eq(2)
+      expect(copy[0].position == SFML::Vector2.new(1.5, 2.0)).to be_truthy
+      expect(copy[0].color == SFML::Color.new(9, 8, 7)).to be_truthy
+      expect(copy[0].tex_coords == SFML::Vector2.new(3.0, 4.0)).to be_truthy
+      expect(copy[1].position.x).to eq(-1.0)
+    end
+
+    it "should reject counts that overflow the size check" do
+      count = (2**64 + 19) / 20
+      varint = ""
+      while count >= 0x80
+        varint << ((count & 0x7f) | 0x80).chr
+        count >>= 7
+      end
+      varint << count.chr
+      header = SFML::VertexArray.new._dump(-1)[0]
+      data = header + "\x00" + varint + "\x00" * 4
+      expect { SFML::VertexArray._load(data.b) }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe "a subclass" do
+    class Point2 < SFML::Vector2; end
+    class Box < SFML::Rect; end
+
+    it "should load as the subclass" do
+      expect(round_trip(Point2.new(1, 2))).to be_an_instance_of(Point2)
+      copy = round_trip(Box.new(1, 2, 3, 4))
+      expect(copy).to be_an_instance_of(Box)
+      expect(copy.width).to eq(3)
+    end
+  end
+end
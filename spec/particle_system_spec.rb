@@ -0,0 +1,74 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::ParticleSystem do
+  describe "emit" do
+    context "given a burst of particles" do
+      particles = SFML::ParticleSystem.new(100)
+      emitted = particles.emit(10, position: SFML::Vector2.new(5.0, 5.0), size: 4.0)
+
+      it "returns the number of particles emitted" do
+        expect(emitted).to eq(10)
+      end
+
+      it "writes a quad per particle" do
+        expect(particles.vertex_count).to eq(40)
+      end
+    end
+
+    context "given more particles than the capacity" do
+      particles = SFML::ParticleSystem.new(8)
+
+      it "emits only up to the capacity" do
+        expect(particles.emit(20)).to eq(8)
+        expect(particles.particle_count).to eq(8)
+      end
+    end
+  end
+
+  describe "update" do
+    it "removes particles that outlived their lifetime" do
+      particles = SFML::ParticleSystem.new
+      particles.emit(5, lifetime: 0.5)
+      particles.emit(5, lifetime: 2.0)
+      particles.update(1.0)
+      expect(particles.particle_count).to eq(5)
+    end
+
+    it "spawns particles from emitters at their rate" do
+      particles = SFML::ParticleSystem.new
+      particles.add_emitter(rate: 100.0, lifetime: 10.0)
+      particles.update(0.25)
+      particles.update(0.25)
+      expect(particles.particle_count).to eq(50)
+    end
+
+    it "gives the same result on the worker pool" do
+      particles = SFML::ParticleSystem.new(20_000)
+      particles.parallel_threshold = 1
+      particles.gravity = SFML::Vector2.new(0.0, 10.0)
+      particles.emit(10_000, lifetime: 1.0)
+      particles.update(SFML.milliseconds(500))
+      expect(particles.particle_count).to eq(10_000)
+      expect(particles.vertex_count).to eq(40_000)
+    end
+  end
+
+  describe "primitive_type=" do
+    it "draws a single point per particle" do
+      particles = SFML::ParticleSystem.new
+      particles.primitive_type = SFML::Points
+      particles.emit(3)
+      expect(particles.vertex_count).to eq(3)
+    end
+
+    it "raises an error for other primitives" do
+      expect { SFML::ParticleSystem.new.primitive_type = SFML::Lines }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe "remove_emitter" do
+    it "raises an error for an unknown emitter" do
+      expect { SFML::ParticleSystem.new.remove_emitter(3) }.to raise_error(ArgumentError)
+    end
+  end
+end
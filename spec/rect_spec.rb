@@ -0,0 +1,85 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::Rect do
+  describe "components" do
+    context "given integer components" do
+      rect = SFML::Rect.new(1, 2, 3, 4)
+
+      it "keeps them as integers" do
+        expect(rect.left).to eq(1)
+        expect(rect.height).to be_kind_of(Integer)
+      end
+
+      it "is eql to an identical rect" do
+        expect(rect.eql?(SFML::Rect.new(1, 2, 3, 4))).to be_truthy
+      end
+
+      it "is not eql to a float rect" do
+        expect(rect.eql?(SFML::Rect.new(1.0, 2.0, 3.0, 4.0))).to be_falsy
+      end
+    end
+
+    context "given a float assigned to an integer rect" do
+      rect = SFML::Rect.new(1, 2, 3, 4)
+      rect.width = 2.5
+
+      it "converts the rect to floats" do
+        expect(rect.left).to eq(1.0)
+        expect(rect.left).to be_kind_of(Float)
+        expect(rect.width).to eq(2.5)
+      end
+    end
+  end
+
+  describe "intersection" do
+    context "given overlapping rects" do
+      rect = SFML::Rect.new(0, 0, 10, 10)
+
+      it "returns the overlap" do
+        expect(rect.intersects?([5, 5, 10, 10])).to eq(SFML::Rect.new(5, 5, 5, 5))
+      end
+
+      it "shrinks in place with intersection!" do
+        copy = rect.dup
+        expect(copy.intersection!([5, 5, 10, 10])).to equal(copy)
+        expect(copy).to eq([5, 5, 5, 5])
+      end
+    end
+
+    context "given disjoint rects" do
+      rect = SFML::Rect.new(0, 0, 10, 10)
+
+      it "returns nil and leaves the rect untouched" do
+        expect(rect.intersection!([20, 20, 5, 5])).to be_nil
+        expect(rect).to eq([0, 0, 10, 10])
+      end
+    end
+  end
+
+  describe "in place operations" do
+    context "given an integer rect" do
+      it "grows to cover another rect with union!" do
+        rect = SFML::Rect.new(0, 0, 10, 10)
+        rect.union!([20, 5, 5, 20])
+        expect(rect).to eq([0, 0, 25, 25])
+      end
+
+      it "grows on every side with expand!" do
+        rect = SFML::Rect.new(10, 10, 10, 10)
+        rect.expand!(2, 3)
+        expect(rect).to eq([8, 7, 14, 16])
+      end
+
+      it "moves with translate!" do
+        rect = SFML::Rect.new(10, 10, 10, 10)
+        rect.translate!(SFML::Vector2.new(5, -5))
+        expect(rect).to eq([15, 5, 10, 10])
+      end
+
+      it "raises when frozen" do
+        rect = SFML::Rect.new(0, 0, 1, 1).freeze
+        expect { rect.translate!(1, 1) }.to raise_error(RuntimeError)
+      end
+    end
+  end
+end
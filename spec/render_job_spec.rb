@@ -0,0 +1,71 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::RenderTexture::RenderJob do
+  before(:each) do
+    @target = SFML::RenderTexture.new(32, 32)
+    @shape = SFML::RectangleShape.new(SFML::Vector2.new(16.0, 16.0))
+    @shape.fill_color = SFML::Color::Red
+  end
+
+  describe "in rendering" do
+    it "should hand back the target's texture" do
+      job = @target.render_async([@shape])
+      expect(job.wait).to equal(@target.texture)
+      expect(job.done?).to be_truthy
+    end
+
+    it "should draw into the target" do
+      @target.render_async([@shape], SFML::Color::Blue).wait
+      image = @target.texture.copy_to_image
+      expect(image.get_pixel(4, 4)).to eq(SFML::Color::Red)
+      expect(image.get_pixel(24, 24)).to eq(SFML::Color::Blue)
+    end
+
+    it "should accept drawables with render states" do
+      states = SFML::RenderStates.new(SFML::Transform.new.translate(SFML::Vector2.new(16.0, 16.0)))
+      @target.render_async([[@shape, states]]).wait
+      image = @target.texture.copy_to_image
+      expect(image.get_pixel(24, 24)).to eq(SFML::Color::Red)
+    end
+
+    it "should copy drawables when submitting" do
+      job = @target.render_async([@shape])
+      @shape.fill_color = SFML::Color::Green
+      job.wait
+      expect(@target.texture.copy_to_image.get_pixel(4, 4)).to eq(SFML::Color::Red)
+    end
+  end
+
+  describe "in validation" do
+    it "should refuse Ruby defined drawables" do
+      drawable = Class.new { include SFML::Drawable; def draw(target, states); end }.new
+      expect { @target.render_async([drawable]) }.to raise_error(TypeError)
+    end
+
+    it "should refuse render states with a shader" do
+      shader = SFML::Shader.new
+      states = SFML::RenderStates.new(shader)
+      expect { @target.render_async([[@shape, states]]) }.to raise_error(ArgumentError)
+    end
+
+    it "should keep the target busy until the job is done" do
+      job = @target.render_async([@shape])
+      job.wait
+      expect(@target.busy?).to be_falsy
+    end
+
+    it "should release the target and its textures once done" do
+      texture = SFML::Texture.new(8, 8)
+      sprite = SFML::Sprite.new(texture)
+      @target.render_async([@shape, sprite]).wait
+      expect { @target.clear }.not_to raise_error
+      expect { @target.smooth = true }.not_to raise_error
+      expect { texture.update(SFML::Image.new(8, 8, SFML::Color::Blue)) }.not_to raise_error
+    end
+
+    it "should refuse to change the thread count once running" do
+      @target.render_async([@shape]).wait
+      expect { SFML::RenderTexture.render_threads = 4 }.to raise_error(RuntimeError)
+    end
+  end
+end
@@ -0,0 +1,142 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::RenderTarget do
+  before(:each) do
+    @target = SFML::RenderTexture.new(100, 100)
+    @shape = SFML::RectangleShape.new(SFML::Vector2.new(10.0, 10.0))
+  end
+
+  describe "culling" do
+    it "should be disabled by default" do
+      expect(@target.culling?).to be_falsy
+    end
+
+    context "when enabled" do
+      before(:each) do
+        @target.culling = true
+      end
+
+      it "should skip drawables outside of the view" do
+        @shape.position = SFML::Vector2.new(500.0, 500.0)
+        @target.draw(@shape)
+        expect(@target.culled_count).to eq(1)
+      end
+
+      it "should draw drawables inside of the view" do
+        @shape.position = SFML::Vector2.new(50.0, 50.0)
+        @target.draw(@shape)
+        expect(@target.culled_count).to eq(0)
+      end
+
+      it "should draw drawables with zero height bounds" do
+        line = SFML::RectangleShape.new(SFML::Vector2.new(10.0, 0.0))
+        line.position = SFML::Vector2.new(50.0, 50.0)
+        @target.draw(line)
+        expect(@target.culled_count).to eq(0)
+      end
+
+      it "should apply the render states transform" do
+        @shape.position = SFML::Vector2.new(500.0, 500.0)
+        states = SFML::RenderStates.new(SFML::Transform.new.translate(SFML::Vector2.new(-480.0, -480.0)))
+        @target.draw(@shape, states)
+        expect(@target.culled_count).to eq(0)
+      end
+
+      it "should reset the count when cleared" do
+        @shape.position = SFML::Vector2.new(-500.0, 0.0)
+        @target.draw(@shape)
+        @target.clear
+        expect(@target.culled_count).to eq(0)
+      end
+    end
+  end
+
+  describe "drawing a ruby drawable" do
+    class RecordingDrawable
+      include SFML::Drawable
+
+      attr_reader :targets, :states
+
+      def initialize
+        @targets = []
+        @states = []
+      end
+
+      def draw(target, states)
+        @targets << target
+        @states << states.transform
+        states.transform = SFML::Transform.new.translate(SFML::Vector2.new(1.0, 1.0))
+      end
+    end
+
+    it "should reuse the target reference" do
+      drawable = RecordingDrawable.new
+      2.times { @target.draw(drawable) }
+      expect(drawable.targets[0]).to equal(drawable.targets[1])
+    end
+
+    it "should not leak changes to the states between draws" do
+      drawable = RecordingDrawable.new
+      2.times { @target.draw(drawable) }
+      expect(drawable.states[1].to_ary).to eq(SFML::Transform.new.to_ary)
+    end
+  end
+
+  describe "drawing a ruby drawable that changes its states in place" do
+    class TranslatingDrawable
+      include SFML::Drawable
+
+      attr_reader :transforms
+
+      def initialize
+        @transforms = []
+      end
+
+      def draw(target, states)
+        @transforms << states.transform.to_ary
+        states.transform.translate!(SFML::Vector2.new(1.0, 1.0))
+      end
+    end
+
+    it "should not affect later draws" do
+      drawable = TranslatingDrawable.new
+      2.times { @target.draw(drawable) }
+      states = SFML::RenderStates.new
+      @target.draw(drawable, states)
+      expect(drawable.transforms.uniq).to eq([SFML::Transform.new.to_ary])
+      expect(states.transform.to_ary).to eq(SFML::Transform.new.to_ary)
+    end
+  end
+
+  describe "getters" do
+    it "should hand out the same frozen view until it changes" do
+      view = @target.view
+      expect(view.frozen?).to be_truthy
+      expect(@target.view).to equal(view)
+      @target.view = SFML::View.new(SFML::Rect.new(0.0, 0.0, 50.0, 50.0))
+      expect(@target.view).not_to equal(view)
+      expect(@target.view.size).to eq(SFML::Vector2.new(50.0, 50.0))
+    end
+
+    it "should fill caller owned views" do
+      view = SFML::View.new
+      expect(@target.default_view_into(view)).to equal(view)
+      expect(view.size).to eq(SFML::Vector2.new(100.0, 100.0))
+      expect { @target.view_into(@target.view) }.to raise_error(RuntimeError)
+    end
+
+    it "should reuse the transform of a transformable until it moves" do
+      transform = @shape.transform
+      expect(@shape.transform).to equal(transform)
+      @shape.move(SFML::Vector2.new(1.0, 0.0))
+      expect(@shape.transform).not_to equal(transform)
+      out = SFML::Transform.new
+      @shape.transform_into(out)
+      expect(out.to_ary).to eq(@shape.transform.to_ary)
+    end
+
+    it "should keep a single wrapper for the render texture's texture" do
+      expect(@target.texture).to equal(@target.texture)
+    end
+  end
+end
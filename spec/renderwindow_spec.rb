@@ -68,5 +68,45 @@ describe SFML::RenderWindow do
         expect(@window.size).to eql(size)
       end
     end
+
+    context "when running a frame loop" do
+      it "yields the same frame object with increasing indices" do
+        frames = []
+        indices = []
+        @window.run(target_fps: 120) do |frame|
+          frames << frame
+          indices << frame.index
+          frame.stop if frame.index == 2
+        end
+        expect(indices).to eq([0, 1, 2])
+        expect(frames.uniq.size).to eq(1)
+      end
+
+      it "paces the loop to the target frame rate" do
+        clock = SFML::Clock.new
+        @window.run(target_fps: 50) do |frame|
+          frame.stop if frame.index == 5
+        end
+        expect(clock.elapsed_microseconds).to be >= 90000
+      end
+
+      it "reports fixed steps when given a fixed delta" do
+        steps = 0
+        @window.run(target_fps: 100, fixed_dt: 0.005) do |frame|
+          steps += frame.fixed_steps
+          frame.stop if frame.index == 10
+        end
+        expect(steps).to be >= 15
+      end
+
+      it "stops when the window is closed" do
+        count = 0
+        @window.run do |frame|
+          count += 1
+          @window.close
+        end
+        expect(count).to eq(1)
+      end
+    end
   end
-end
\ No newline at end of file
+end
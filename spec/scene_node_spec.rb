@@ -0,0 +1,108 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::SceneNode do
+  before(:each) do
+    @root = SFML::SceneNode.new
+    @child = SFML::SceneNode.new
+    @grandchild = SFML::SceneNode.new
+    @root.attach(@child)
+    @child.attach(@grandchild)
+  end
+
+  describe "in hierarchy" do
+    it "should track parents and children" do
+      expect(@child.parent).to eq(@root)
+      expect(@root.children).to eq([@child])
+      expect(@root.child_count).to eq(1)
+    end
+
+    it "should detach children" do
+      @root.detach(@child)
+      expect(@child.parent).to be_nil
+      expect(@root.child_count).to eq(0)
+    end
+
+    it "should refuse to detach a node that isn't a child" do
+      expect { @root.detach(@grandchild) }.to raise_error(ArgumentError)
+    end
+
+    it "should refuse to be copied" do
+      expect { @child.dup }.to raise_error(RuntimeError)
+      expect { @child.clone }.to raise_error(RuntimeError)
+    end
+
+    it "should refuse cycles" do
+      expect { @grandchild.attach(@root) }.to raise_error(ArgumentError)
+      expect { @root.attach(@root) }.to raise_error(ArgumentError)
+    end
+
+    it "should move a node when attached to a new parent" do
+      @root.attach(@grandchild)
+      expect(@child.child_count).to eq(0)
+      expect(@grandchild.parent).to eq(@root)
+    end
+
+    it "should order children by z order" do
+      front = SFML::SceneNode.new
+      front.z_order = 10
+      back = SFML::SceneNode.new
+      back.z_order = -10
+      @root.attach(front)
+      @root.attach(back)
+      expect(@root.children).to eq([back, @child, front])
+    end
+  end
+
+  describe "in transformation" do
+    it "should compose the world transform of its ancestors" do
+      @root.position = SFML::Vector2.new(10.0, 20.0)
+      @child.position = SFML::Vector2.new(1.0, 2.0)
+      @grandchild.scale = SFML::Vector2.new(2.0, 2.0)
+      point = @grandchild.world_transform.transform_point(SFML::Vector2.new(1.0, 1.0))
+      expect(point).to eq(SFML::Vector2.new(13.0, 24.0))
+    end
+
+    it "should notice changes to an ancestor" do
+      @grandchild.world_transform
+      @root.move(SFML::Vector2.new(5.0, 0.0))
+      point = @grandchild.world_transform.transform_point(SFML::Vector2.new(0.0, 0.0))
+      expect(point).to eq(SFML::Vector2.new(5.0, 0.0))
+    end
+
+    it "should drop the parent transform once detached" do
+      @root.position = SFML::Vector2.new(10.0, 10.0)
+      @child.world_transform
+      @root.detach(@child)
+      expect(@child.world_transform.to_ary).to eq(SFML::Transform.new.to_ary)
+    end
+  end
+
+  describe "in drawing" do
+    it "should only hold native drawables" do
+      drawable = Class.new { include SFML::Drawable; def draw(target, states); end }.new
+      expect { @root.drawable = drawable }.to raise_error(TypeError)
+      expect { @root.drawable = @child }.to raise_error(ArgumentError)
+    end
+
+    it "should use moved ancestors when drawn below the root" do
+      target = SFML::RenderTexture.new(32, 32)
+      shape = SFML::RectangleShape.new(SFML::Vector2.new(8.0, 8.0))
+      shape.fill_color = SFML::Color::Red
+      @grandchild.drawable = shape
+      target.draw(@root)
+      @root.move(SFML::Vector2.new(16.0, 16.0))
+      target.clear
+      target.draw(@child)
+      target.display
+      image = target.texture.copy_to_image
+      expect(image.get_pixel(20, 20)).to eq(SFML::Color::Red)
+      expect(image.get_pixel(4, 4)).to eq(SFML::Color::Black)
+    end
+
+    it "should hold sprites" do
+      sprite = SFML::Sprite.new
+      @child.drawable = sprite
+      expect(@child.drawable).to eq(sprite)
+    end
+  end
+end
@@ -0,0 +1,48 @@
+require './lib/sfml/rbsfml.so'
+require 'tmpdir'
+
+CACHED_SHADER_SOURCE = <<-GLSL
+uniform vec4 tint;
+void main()
+{
+    gl_FragColor = tint;
+}
+GLSL
+
+describe SFML::Shader do
+  describe "with a binary cache" do
+    around(:each) do |example|
+      Dir.mktmpdir do |directory|
+        SFML::Shader.cache_directory = directory
+        example.run
+        SFML::Shader.cache_directory = nil
+      end
+    end
+
+    it "should be enabled by setting a directory" do
+      expect(SFML::Shader.cache_directory).not_to be_nil
+    end
+
+    it "should miss first and hit afterwards" do
+      hits = SFML::Shader.cache_hits
+      misses = SFML::Shader.cache_misses
+      expect(SFML::Shader.new.load_from_memory(CACHED_SHADER_SOURCE, SFML::Shader::Fragment)).to be(true)
+      expect(SFML::Shader.cache_misses).to be(misses + 1)
+
+      shader = SFML::Shader.new
+      expect(shader.load_from_memory(CACHED_SHADER_SOURCE, SFML::Shader::Fragment)).to be(true)
+      expect(SFML::Shader.cache_hits + SFML::Shader.cache_misses).to be(hits + misses + 2)
+      expect(shader.uniform("tint").active?).to be(true)
+    end
+
+    it "should still report compile failures" do
+      expect(SFML::Shader.new.load_from_memory("not glsl", SFML::Shader::Fragment)).to be(false)
+    end
+  end
+
+  describe "without a binary cache" do
+    it "should be disabled by default" do
+      expect(SFML::Shader.cache_directory).to be_nil
+    end
+  end
+end
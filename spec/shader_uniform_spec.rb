@@ -0,0 +1,57 @@
+require './lib/sfml/rbsfml.so'
+
+FRAGMENT_SOURCE = <<-GLSL
+uniform float strength;
+uniform vec2 offset;
+uniform vec4 tint;
+uniform mat3 warp;
+uniform sampler2D texture;
+void main()
+{
+    vec3 position = warp * vec3(offset, 1.0);
+    gl_FragColor = texture2D(texture, position.xy) * tint * strength;
+}
+GLSL
+
+describe SFML::Shader::Uniform do
+  before(:each) do
+    @shader = SFML::Shader.new
+    @shader.load_from_memory(FRAGMENT_SOURCE, SFML::Shader::Fragment)
+  end
+
+  describe "in creation" do
+    it "should resolve active uniforms" do
+      uniform = @shader.uniform("strength")
+      expect(uniform.name).to eq("strength")
+      expect(uniform.active?).to be(true)
+      expect(uniform.location).to be >= 0
+    end
+
+    it "should report unused uniforms as inactive" do
+      uniform = @shader.uniform("missing")
+      expect(uniform.active?).to be(false)
+      expect(uniform.location).to be(-1)
+      expect { uniform.set_float(1.0) }.not_to raise_error
+    end
+  end
+
+  describe "in usage" do
+    it "should accept values of the declared type" do
+      @shader.uniform("strength").set_float(0.5)
+      @shader.uniform("offset").set_vec2(SFML::Vector2.new(1.0, 2.0))
+      @shader.uniform("offset").set_vec2(1.0, 2.0)
+      @shader.uniform("tint").set_color(SFML::Color.new(255, 128, 0))
+      @shader.uniform("warp").set_mat3(SFML::Transform.new)
+      @shader.uniform("texture").set_texture(SFML::Shader::CurrentTexture)
+    end
+
+    it "should reject values of another type" do
+      expect { @shader.uniform("strength").set_vec2(1.0, 2.0) }.to raise_error(TypeError)
+      expect { @shader.uniform("tint").set_float(1.0) }.to raise_error(TypeError)
+    end
+
+    it "should need nine elements for a matrix array" do
+      expect { @shader.uniform("warp").set_mat3([1.0] * 4) }.to raise_error(ArgumentError)
+    end
+  end
+end
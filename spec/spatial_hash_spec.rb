@@ -0,0 +1,96 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::SpatialHash do
+  describe "query" do
+    context "given rects spread over several cells" do
+      hash = SFML::SpatialHash.new(32.0)
+      first = hash.insert(SFML::Rect.new(0.0, 0.0, 10.0, 10.0))
+      second = hash.insert(SFML::Rect.new(100.0, 100.0, 50.0, 50.0))
+      third = hash.insert([20.0, 20.0, 100.0, 10.0])
+
+      it "returns the indices overlapping the area" do
+        expect(hash.query([0.0, 0.0, 30.0, 30.0])).to eq([first, third])
+      end
+
+      it "returns an index spanning several cells only once" do
+        expect(hash.query([0.0, 0.0, 200.0, 200.0])).to eq([first, second, third])
+      end
+
+      it "returns the indices containing a point" do
+        expect(hash.query_point([120.0, 120.0])).to eq([second])
+      end
+
+      it "returns nothing for an empty area" do
+        expect(hash.query([500.0, 500.0, 10.0, 10.0])).to be_empty
+      end
+    end
+  end
+
+  describe "move" do
+    context "given a rect moved to another cell" do
+      hash = SFML::SpatialHash.new(16.0)
+      index = hash.insert([0.0, 0.0, 8.0, 8.0])
+      hash.move(index, [64.0, 64.0, 8.0, 8.0])
+
+      it "is no longer found at its old position" do
+        expect(hash.query_point([4.0, 4.0])).to be_empty
+      end
+
+      it "is found at its new position" do
+        expect(hash.query_point([68.0, 68.0])).to eq([index])
+      end
+    end
+  end
+
+  describe "remove" do
+    context "given a removed entry" do
+      hash = SFML::SpatialHash.new
+      index = hash.insert([0.0, 0.0, 8.0, 8.0])
+      hash.remove(index)
+
+      it "is no longer included" do
+        expect(hash.include?(index)).to be_falsy
+        expect(hash.size).to eq(0)
+      end
+
+      it "recycles the index on the next insert" do
+        expect(hash.insert([1.0, 1.0, 1.0, 1.0])).to eq(index)
+      end
+    end
+  end
+
+  describe "dup" do
+    context "given a hash that was queried before" do
+      hash = SFML::SpatialHash.new(16.0)
+      index = hash.insert([0.0, 0.0, 8.0, 8.0])
+      hash.query_point([4.0, 4.0])
+      copy = hash.dup
+
+      it "finds the same entries" do
+        expect(copy.query_point([4.0, 4.0])).to eq([index])
+      end
+    end
+  end
+
+  describe "insert" do
+    context "given a rect spanning a huge area" do
+      hash = SFML::SpatialHash.new(1.0)
+      small = hash.insert([0.0, 0.0, 0.5, 0.5])
+      huge = hash.insert([-1.0e30, -1.0e30, 2.0e30, 2.0e30])
+
+      it "is found anywhere in its area" do
+        expect(hash.query_point([0.25, 0.25])).to eq([small, huge])
+        expect(hash.query_point([5.0e29, -5.0e29])).to eq([huge])
+      end
+
+      it "is no longer found once removed" do
+        hash.remove(huge)
+        expect(hash.query_point([5.0e29, -5.0e29])).to be_empty
+      end
+    end
+
+    it "rejects NaN" do
+      expect { SFML::SpatialHash.new.insert([Float::NAN, 0.0, 1.0, 1.0]) }.to raise_error(ArgumentError)
+    end
+  end
+end
@@ -0,0 +1,67 @@
+require './lib/sfml/rbsfml.so'
+
+describe SFML::TileMap do
+  before(:each) do
+    @texture = SFML::Texture.new(64, 64)
+    @map = SFML::TileMap.new(@texture, SFML::Vector2.new(16, 16), 100, 50, 10)
+  end
+
+  describe "in creation" do
+    it "should start out empty" do
+      expect(@map.tile(0, 0)).to eq(SFML::TileMap::Empty)
+    end
+
+    it "should split the grid into chunks" do
+      expect(@map.chunk_count).to eq(50)
+      expect(@map.local_bounds).to eq(SFML::Rect.new(0.0, 0.0, 1600.0, 800.0))
+    end
+
+    it "should not build any chunk before drawing" do
+      expect(@map.built_chunk_count).to eq(0)
+    end
+  end
+
+  describe "in usage" do
+    it "should store tile ids" do
+      @map.set_tile(12, 7, 5)
+      expect(@map.tile(12, 7)).to eq(5)
+    end
+
+    it "should reject tiles outside of the grid" do
+      expect { @map.set_tile(100, 0, 1) }.to raise_error(ArgumentError)
+    end
+
+    it "should load a full grid" do
+      @map.load(Array.new(100 * 50) { |index| index % 16 })
+      expect(@map.tile(17, 0)).to eq(1)
+      expect { @map.load([1, 2, 3]) }.to raise_error(ArgumentError)
+    end
+  end
+
+  describe "in drawing" do
+    before(:each) do
+      @target = SFML::RenderTexture.new(320, 160)
+      @map.fill(3)
+    end
+
+    it "should only draw the chunks inside the view" do
+      @target.view = SFML::View.new(SFML::Rect.new(0.0, 0.0, 320.0, 160.0))
+      @target.draw(@map)
+      expect(@map.drawn_chunk_count).to eq(2)
+      expect(@map.built_chunk_count).to eq(2)
+    end
+
+    it "should draw nothing when the view is outside of the map" do
+      @target.view = SFML::View.new(SFML::Rect.new(5000.0, 5000.0, 320.0, 160.0))
+      @target.draw(@map)
+      expect(@map.drawn_chunk_count).to eq(0)
+    end
+
+    it "should only rebuild the chunk holding a changed tile" do
+      @target.view = SFML::View.new(SFML::Rect.new(0.0, 0.0, 320.0, 160.0))
+      @target.draw(@map)
+      @map.set_tile(15, 5, 1)
+      expect(@map.built_chunk_count).to eq(1)
+    end
+  end
+end
@@ -66,4 +66,40 @@ describe SFML::Time do
       end
     end
   end
-end
\ No newline at end of file
+
+  describe "in place arithmetic" do
+    context "given a mutable time" do
+      time = SFML.milliseconds(10)
+      result = time.add!(SFML.milliseconds(5))
+
+      it "adds to itself" do
+        expect(time.as_milliseconds).to eq(15)
+      end
+
+      it "returns itself" do
+        expect(result.equal?(time)).to be_truthy
+      end
+
+      it "subtracts from itself" do
+        expect(time.dup.subtract!(SFML.milliseconds(15))).to eq(SFML::Time::Zero)
+      end
+    end
+
+    context "given a frozen time" do
+      it "raises an error" do
+        expect { SFML::Time::Zero.add!(SFML.milliseconds(1)) }.to raise_error(RuntimeError)
+      end
+    end
+  end
+
+  describe "type checks" do
+    it "accepts instances of subclasses" do
+      subclass = Class.new(SFML::Time)
+      expect(SFML.seconds(1.0) + subclass.new).to eq(SFML.seconds(1.0))
+    end
+
+    it "raises an error when given another wrapped type" do
+      expect { SFML.seconds(1.0) + SFML::Clock.new }.to raise_error(TypeError)
+    end
+  end
+end
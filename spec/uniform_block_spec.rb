@@ -0,0 +1,64 @@
+require './lib/sfml/rbsfml.so'
+
+BLOCK_SHADER_SOURCE = <<-GLSL
+uniform float strength;
+uniform vec2 offset;
+uniform vec4 tint;
+void main()
+{
+    gl_FragColor = tint * strength + vec4(offset, 0.0, 0.0);
+}
+GLSL
+
+describe SFML::Shader::UniformBlock do
+  before(:each) do
+    @shader = SFML::Shader.new
+    @shader.load_from_memory(BLOCK_SHADER_SOURCE, SFML::Shader::Fragment)
+  end
+
+  describe "in creation" do
+    it "should be filled from a hash" do
+      block = SFML::Shader::UniformBlock.new(strength: 0.5, offset: [1.0, 2.0])
+      expect(block.size).to be(2)
+      expect(block.include?(:strength)).to be(true)
+      expect(block.include?("tint")).to be(false)
+    end
+
+    it "should replace values set under the same name" do
+      block = SFML::Shader::UniformBlock.new
+      block[:strength] = 0.5
+      block["strength"] = 1.0
+      expect(block.size).to be(1)
+    end
+
+    it "should reject values that can't be uniforms" do
+      block = SFML::Shader::UniformBlock.new
+      expect { block[:strength] = "strong" }.to raise_error(TypeError)
+    end
+  end
+
+  describe "in usage" do
+    it "should only upload values that changed" do
+      block = SFML::Shader::UniformBlock.new(strength: 0.5, offset: SFML::Vector2.new(1.0, 2.0), tint: SFML::Color.new(255, 0, 0))
+      expect(@shader.set_parameters(block)).to be(3)
+      expect(@shader.set_parameters(block)).to be(0)
+      block[:strength] = 0.75
+      expect(@shader.set_parameters(block)).to be(1)
+    end
+
+    it "should accept a plain hash" do
+      expect(@shader.set_parameters(strength: 0.5, missing: 1.0)).to be(1)
+      expect(@shader.set_parameters(strength: 0.5)).to be(0)
+    end
+
+    it "should upload again after set_parameter was used" do
+      @shader.set_parameters(strength: 0.5)
+      @shader.set_parameter("strength", 0.25)
+      expect(@shader.set_parameters(strength: 0.5)).to be(1)
+    end
+
+    it "should reject values of another type" do
+      expect { @shader.set_parameters(offset: 1.0) }.to raise_error(TypeError)
+    end
+  end
+end
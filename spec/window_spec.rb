@@ -45,6 +45,16 @@ describe SFML::Window do
         settings = @window.settings
         expect(settings.frozen?).to be_truthy
       end
+
+      it "should return the same object while the settings are unchanged" do
+        expect(@window.settings).to equal(@window.settings)
+      end
+
+      it "should fill a caller owned object" do
+        settings = SFML::ContextSettings.new
+        @window.settings_into(settings)
+        expect(settings.depth_bits).to eq(@window.settings.depth_bits)
+      end
     end
 
     context "when setting the position" do
@@ -68,5 +78,37 @@ describe SFML::Window do
         expect(@window.size).to eql(size)
       end
     end
+
+    context "when filtering events" do
+      it "should let every event through by default" do
+        expect(@window.event_mask).to eq((1 << SFML::Event::Count) - 1)
+      end
+
+      it "should accept a list of event types" do
+        @window.event_mask = [SFML::Event::Closed, SFML::Event::KeyPressed]
+        expect(@window.event_mask).to eq((1 << SFML::Event::Closed) | (1 << SFML::Event::KeyPressed))
+      end
+
+      it "should reject unknown event types" do
+        expect { @window.event_mask = [SFML::Event::Count] }.to raise_error(ArgumentError)
+      end
+
+      it "should only deliver unmasked events" do
+        @window.event_mask = [SFML::Event::Closed]
+        @window.each_event { |event| expect(event.type).to eq(SFML::Event::Closed) }
+      end
+    end
+
+    context "when coalescing motion" do
+      it "should be disabled by default" do
+        expect(@window.coalesce_motion?).to be_falsy
+        expect(@window.coalesced_count).to eq(0)
+      end
+
+      it "should be possible to enable" do
+        @window.coalesce_motion = true
+        expect(@window.coalesce_motion?).to be_truthy
+      end
+    end
   end
 end
\ No newline at end of file